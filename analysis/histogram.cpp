@@ -0,0 +1,200 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using Histogram_Kernel = void (*)(uint8_t const* data, size_t size, uint32_t (*counts)[256]);
+
+// Sub-histograms hold 32-bit counts; data is fed to a kernel in pieces small enough not to overflow them.
+static size_t const Kernel_Piece_Size = size_t(1) << 30;
+
+// Chunk size for counting on a pool, and the least data worth splitting.
+static size_t const Parallel_Chunk_Size = size_t(16) << 20;
+
+static size_t const Sub_Histogram_Count = 8;
+
+static void Count_Tail(uint8_t const* data, size_t size, uint32_t (*counts)[256])
+{
+    for (size_t i = 0; i < size; ++i)
+        ++counts[i % 4][data[i]];
+}
+
+static void Count_Portable(uint8_t const* data, size_t size, uint32_t (*counts)[256])
+{
+    size_t i = 0;
+
+    for (; size - i >= 8; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+
+        ++counts[0][uint8_t(word)];
+        ++counts[1][uint8_t(word >> 8)];
+        ++counts[2][uint8_t(word >> 16)];
+        ++counts[3][uint8_t(word >> 24)];
+        ++counts[0][uint8_t(word >> 32)];
+        ++counts[1][uint8_t(word >> 40)];
+        ++counts[2][uint8_t(word >> 48)];
+        ++counts[3][uint8_t(word >> 56)];
+    }
+
+    Count_Tail(data + i, size - i, counts);
+}
+
+#if defined(__x86_64__)
+
+//
+//  Runs of one value are what stall the scalar kernels, and they are common
+//  in images: zero fill, padding, alignment.  Each 32-byte block is compared
+//  with its first byte broadcast to all lanes; a block of one value is
+//  counted with a single add, and any other block byte by byte into eight
+//  sub-histograms.  Counting a mixed block needs a scatter with conflict
+//  detection, which AVX2 does not have.
+//
+__attribute__((target("avx2")))
+static void Count_AVX2(uint8_t const* data, size_t size, uint32_t (*counts)[256])
+{
+    size_t i = 0;
+
+    for (; size - i >= 32; i += 32)
+    {
+        auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+        auto const first = _mm256_set1_epi8(char(data[i]));
+
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, first)) == -1)
+        {
+            counts[0][data[i]] += 32;
+            continue;
+        }
+
+        uint64_t words[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), block);
+
+        // Byte n of the block goes to sub-histogram n % 8.
+        for (auto const word: words)
+        {
+            ++counts[0][uint8_t(word)];
+            ++counts[1][uint8_t(word >> 8)];
+            ++counts[2][uint8_t(word >> 16)];
+            ++counts[3][uint8_t(word >> 24)];
+            ++counts[4][uint8_t(word >> 32)];
+            ++counts[5][uint8_t(word >> 40)];
+            ++counts[6][uint8_t(word >> 48)];
+            ++counts[7][uint8_t(word >> 56)];
+        }
+    }
+
+    Count_Tail(data + i, size - i, counts);
+}
+
+#endif
+
+struct Histogram_Implementation
+{
+    Histogram_Kernel Count;
+    string_view Name;
+};
+
+static Histogram_Implementation const& Get_Histogram_Implementation()
+{
+    static Histogram_Implementation const implementation = []() -> Histogram_Implementation
+    {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return { Count_AVX2, "avx2" };
+#endif
+
+        return { Count_Portable, "portable" };
+    }();
+
+    return implementation;
+}
+
+string_view Get_Histogram_Implementation_Name()
+{
+    return Get_Histogram_Implementation().Name;
+}
+
+Byte_Histogram Compute_Byte_Histogram(string_view data)
+{
+    auto const count = Get_Histogram_Implementation().Count;
+    auto const* bytes = reinterpret_cast<uint8_t const*>(data.data());
+
+    Byte_Histogram histogram {};
+    alignas(64) uint32_t counts[Sub_Histogram_Count][256];
+
+    for (size_t offset = 0; offset < data.size(); offset += Kernel_Piece_Size)
+    {
+        std::memset(counts, 0, sizeof(counts));
+        count(bytes + offset, std::min(Kernel_Piece_Size, data.size() - offset), counts);
+
+        for (size_t value = 0; value < 256; ++value)
+            for (size_t table = 0; table < Sub_Histogram_Count; ++table)
+                histogram[value] += counts[table][value];
+    }
+
+    return histogram;
+}
+
+Byte_Histogram Compute_Byte_Histogram(string_view data, Work_Stealing_Pool& pool)
+{
+    auto const chunk_count = (data.size() + Parallel_Chunk_Size - 1) / Parallel_Chunk_Size;
+
+    if (chunk_count < 2)
+        return Compute_Byte_Histogram(data);
+
+    std::vector<Byte_Histogram> chunk_histograms(chunk_count);
+    std::atomic<size_t> remaining = chunk_count;
+
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        pool.Submit([&, i]
+        {
+            chunk_histograms[i] = Compute_Byte_Histogram(data.substr(i * Parallel_Chunk_Size, Parallel_Chunk_Size));
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    pool.Wait_Until([&] { return remaining.load(std::memory_order_acquire) == 0; });
+
+    Byte_Histogram histogram {};
+
+    for (auto const& chunk_histogram: chunk_histograms)
+        for (size_t value = 0; value < 256; ++value)
+            histogram[value] += chunk_histogram[value];
+
+    return histogram;
+}
+
+double Get_Entropy(Byte_Histogram const& histogram)
+{
+    uint64_t total = 0;
+
+    for (auto const count: histogram)
+        total += count;
+
+    if (total == 0)
+        return 0;
+
+    double entropy = 0;
+
+    for (auto const count: histogram)
+    {
+        if (count == 0)
+            continue;
+
+        auto const p = double(count) / double(total);
+        entropy -= p * std::log2(p);
+    }
+
+    return entropy;
+}
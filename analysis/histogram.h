@@ -0,0 +1,33 @@
+#ifndef HISTOGRAM_H__INCLUDED
+#define HISTOGRAM_H__INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "include/work-stealing-pool.h"
+
+using std::string_view;
+
+using Byte_Histogram = std::array<uint64_t, 256>;
+
+//
+//  Counts every byte value in the data.  A counter incremented twice in a
+//  row stalls on its own store, which is exactly what runs of one value
+//  (padding, zero fill) do, so the counts are spread over several
+//  sub-histograms and summed at the end.  The AVX2 kernel, used when the
+//  CPU has it, also counts a 32-byte block of one value with a single
+//  compare and add.
+//
+Byte_Histogram Compute_Byte_Histogram(string_view data);
+
+// The same, with large data split into chunks counted on the pool.
+Byte_Histogram Compute_Byte_Histogram(string_view data, Work_Stealing_Pool& pool);
+
+// Shannon entropy in bits per byte, from 0 (one value) to 8 (uniform).
+double Get_Entropy(Byte_Histogram const& histogram);
+
+// The name of the histogram kernel in use, for diagnostics.
+string_view Get_Histogram_Implementation_Name();
+
+#endif  // HISTOGRAM_H__INCLUDED
@@ -0,0 +1,353 @@
+#include "signatures.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <queue>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using std::string;
+
+using Find_Function = size_t (*)(Byte_Set_Finder const& finder, uint8_t const* low_buckets, uint8_t const* high_buckets, string_view data, size_t from);
+
+static size_t Find_Portable(Byte_Set_Finder const& finder, uint8_t const*, uint8_t const*, string_view data, size_t from)
+{
+    for (; from < data.size(); ++from)
+        if (finder.Contains(uint8_t(data[from])))
+            return from;
+
+    return data.size();
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+static size_t Find_AVX2(Byte_Set_Finder const& finder, uint8_t const* low_buckets, uint8_t const* high_buckets, string_view data, size_t from)
+{
+    auto const low_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(low_buckets)));
+    auto const high_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(high_buckets)));
+    auto const nibble = _mm256_set1_epi8(0x0f);
+    auto const zero = _mm256_setzero_si256();
+
+    for (; from + 32 <= data.size(); from += 32)
+    {
+        auto const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data.data() + from));
+
+        // pshufb looks up within each 128-bit lane, which is why both tables are broadcast.
+        auto const low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(bytes, nibble));
+        auto const high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+        auto const misses = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), zero);
+        auto const candidates = ~uint32_t(_mm256_movemask_epi8(misses));
+
+        if (candidates != 0)
+            return from + std::countr_zero(candidates);
+    }
+
+    return Find_Portable(finder, low_buckets, high_buckets, data, from);
+}
+
+#endif
+
+static Find_Function Get_Find_Function()
+{
+    static Find_Function const find = []() -> Find_Function
+    {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return Find_AVX2;
+#endif
+
+        return Find_Portable;
+    }();
+
+    return find;
+}
+
+Byte_Set_Finder::Byte_Set_Finder():
+    _members{},
+    _low_buckets{},
+    _high_buckets{}
+{}
+
+//
+//  High nibble h owns bucket h % 8, so the first eight distinct high
+//  nibbles of a typical set (0-7) never share one.
+//
+void Byte_Set_Finder::Add(uint8_t byte)
+{
+    auto const bucket = uint8_t(1 << ((byte >> 4) % 8));
+
+    _members[byte] = true;
+    _low_buckets[byte & 0x0f] |= bucket;
+    _high_buckets[byte >> 4] |= bucket;
+}
+
+size_t Byte_Set_Finder::Find(string_view data, size_t from) const
+{
+    return Get_Find_Function()(*this, _low_buckets, _high_buckets, data, from);
+}
+
+static int Get_Hex_Digit(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+        return c - '0';
+    if ((c >= 'a') && (c <= 'f'))
+        return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F'))
+        return c - 'A' + 10;
+
+    return -1;
+}
+
+static string_view Trim(string_view text)
+{
+    auto const first = text.find_first_not_of(" \t\r");
+
+    if (first == string_view::npos)
+        return {};
+
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+// Parses "name: hex bytes"; returns an empty string or what is wrong with the line.
+static string Parse_Rule(string_view line, Signature_Set::Signature& signature)
+{
+    auto const colon = line.find(':');
+
+    if (colon == string_view::npos)
+        return "expected \"name: bytes\"";
+
+    signature.Name = Trim(line.substr(0, colon));
+
+    if (signature.Name.empty())
+        return "missing signature name";
+
+    auto const pattern = line.substr(colon + 1);
+
+    for (size_t i = 0; i < pattern.size(); )
+    {
+        if ((pattern[i] == ' ') || (pattern[i] == '\t') || (pattern[i] == '\r'))
+        {
+            ++i;
+            continue;
+        }
+
+        if (i + 1 >= pattern.size())
+            return "odd number of hex digits";
+
+        if ((pattern[i] == '?') && (pattern[i + 1] == '?'))
+        {
+            signature.Bytes.push_back(0);
+            signature.Mask.push_back(0);
+        } else {
+            auto const high = Get_Hex_Digit(pattern[i]);
+            auto const low = Get_Hex_Digit(pattern[i + 1]);
+
+            if ((high < 0) || (low < 0))
+                return "bad byte \"" + string(pattern.substr(i, 2)) + '"';
+
+            signature.Bytes.push_back(char((high << 4) | low));
+            signature.Mask.push_back(char(0xff));
+        }
+
+        i += 2;
+    }
+
+    if (signature.Bytes.empty())
+        return "empty signature";
+
+    // The atom: the first Maximum_Atom_Length bytes of the longest literal run.
+    size_t best_offset = 0, best_length = 0;
+
+    for (size_t i = 0; i < signature.Mask.size(); )
+    {
+        if (signature.Mask[i] == 0)
+        {
+            ++i;
+            continue;
+        }
+
+        auto const start = i;
+
+        while ((i < signature.Mask.size()) && (signature.Mask[i] != 0))
+            ++i;
+
+        if (i - start > best_length)
+        {
+            best_offset = start;
+            best_length = i - start;
+        }
+    }
+
+    if (best_length == 0)
+        return "signature has no literal bytes";
+
+    signature.Atom_Offset = best_offset;
+    signature.Atom_Length = std::min(best_length, Signature_Set::Maximum_Atom_Length);
+
+    return {};
+}
+
+Signature_Set* Signature_Set::Compile(string_view rules, string& error)
+{
+    auto set = std::unique_ptr<Signature_Set>(new Signature_Set);
+
+    size_t line_number = 0;
+
+    while (!rules.empty())
+    {
+        auto const end = rules.find('\n');
+        auto const line = Trim(rules.substr(0, end));
+
+        rules.remove_prefix((end == string_view::npos) ? rules.size() : end + 1);
+        ++line_number;
+
+        if (line.empty() || (line[0] == '#'))
+            continue;
+
+        Signature signature {};
+        auto const problem = Parse_Rule(line, signature);
+
+        if (!problem.empty())
+        {
+            error = "line " + std::to_string(line_number) + ": " + problem;
+            return nullptr;
+        }
+
+        set->_signatures.push_back(std::move(signature));
+    }
+
+    set->build_automaton();
+
+    return set.release();
+}
+
+//
+//  A trie of the atoms, then a breadth-first pass that fills in every
+//  missing transition from the state's failure link, so that scanning
+//  never follows a failure link itself, and gives each state the outputs
+//  of its failure state as well as its own.
+//
+void Signature_Set::build_automaton()
+{
+    _transitions.assign(256, 0);
+
+    std::vector<std::vector<uint32_t>> outputs(1);
+
+    for (uint32_t i = 0; i < _signatures.size(); ++i)
+    {
+        auto const& signature = _signatures[i];
+        uint32_t state = 0;
+
+        _first_bytes.Add(uint8_t(signature.Bytes[signature.Atom_Offset]));
+
+        for (size_t j = 0; j < signature.Atom_Length; ++j)
+        {
+            auto const byte = uint8_t(signature.Bytes[signature.Atom_Offset + j]);
+            auto& next = _transitions[(state * 256) + byte];
+
+            if (next == 0)
+            {
+                next = uint32_t(outputs.size());
+                outputs.emplace_back();
+                _transitions.resize(_transitions.size() + 256, 0);
+            }
+
+            state = _transitions[(state * 256) + byte];
+        }
+
+        outputs[state].push_back(i);
+    }
+
+    std::vector<uint32_t> failure(outputs.size(), 0);
+    std::queue<uint32_t> pending;
+
+    for (unsigned byte = 0; byte < 256; ++byte)
+        if (_transitions[byte] != 0)
+            pending.push(_transitions[byte]);
+
+    while (!pending.empty())
+    {
+        auto const state = pending.front();
+        pending.pop();
+
+        auto const& inherited = outputs[failure[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+
+        for (unsigned byte = 0; byte < 256; ++byte)
+        {
+            auto& next = _transitions[(state * 256) + byte];
+            auto const fallback = _transitions[(failure[state] * 256) + byte];
+
+            if (next == 0)
+            {
+                next = fallback;
+            } else {
+                failure[next] = fallback;
+                pending.push(next);
+            }
+        }
+    }
+
+    _output_begin.clear();
+    _outputs.clear();
+
+    for (auto const& state_outputs: outputs)
+    {
+        _output_begin.push_back(uint32_t(_outputs.size()));
+        _outputs.insert(_outputs.end(), state_outputs.begin(), state_outputs.end());
+    }
+
+    _output_begin.push_back(uint32_t(_outputs.size()));
+}
+
+bool Signature_Set::matches(Signature const& signature, string_view data, size_t start) const
+{
+    if (start + signature.Bytes.size() > data.size())
+        return false;
+
+    for (size_t i = 0; i < signature.Bytes.size(); ++i)
+        if ((data[start + i] ^ signature.Bytes[i]) & signature.Mask[i])
+            return false;
+
+    return true;
+}
+
+void Signature_Set::Scan(string_view data, std::function<void(size_t, uint64_t)> const& found) const
+{
+    if (_signatures.empty())
+        return;
+
+    auto const* bytes = reinterpret_cast<uint8_t const*>(data.data());
+    uint32_t state = 0;
+
+    for (size_t i = 0; i < data.size(); )
+    {
+        // Back at the root only a byte that starts an atom can lead anywhere.
+        if (state == 0)
+        {
+            i = _first_bytes.Find(data, i);
+
+            if (i == data.size())
+                break;
+        }
+
+        state = _transitions[(size_t(state) * 256) + bytes[i]];
+        ++i;
+
+        for (auto j = _output_begin[state]; j < _output_begin[state + 1]; ++j)
+        {
+            auto const& signature = _signatures[_outputs[j]];
+            auto const atom_end = signature.Atom_Offset + signature.Atom_Length;
+
+            if ((i >= atom_end) && matches(signature, data, i - atom_end))
+                found(_outputs[j], i - atom_end);
+        }
+    }
+}
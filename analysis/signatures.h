@@ -0,0 +1,101 @@
+#ifndef SIGNATURES_H__INCLUDED
+#define SIGNATURES_H__INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using std::string_view;
+
+//
+//  The bytes that can start a match, tested 32 at a time: each byte is
+//  looked up by its low and its high nibble in two 16-entry tables with
+//  pshufb, and is a candidate when the two bucket masks share a bit.  With
+//  up to eight distinct high nibbles in the set this is exact; beyond that
+//  high nibbles share buckets and some bytes come back as false candidates.
+//
+class Byte_Set_Finder
+{
+    private:
+        std::array<bool, 256> _members;
+        alignas(16) uint8_t _low_buckets[16];
+        alignas(16) uint8_t _high_buckets[16];
+
+    public:
+        Byte_Set_Finder();
+
+        void Add(uint8_t byte);
+
+        // The first position at or after from that may hold a member, or data.size().
+        size_t Find(string_view data, size_t from) const;
+
+        bool Contains(uint8_t byte) const { return _members[byte]; }
+};
+
+//
+//  A set of byte signatures compiled once and then shared, read-only, by
+//  any number of scanning threads.  Rules are text, one per line:
+//
+//      # comment
+//      UPX_Stub: 60 BE ?? ?? ?? ?? 8D BE ?? ?? ?? ?? 57
+//
+//  where ?? matches any byte.  The longest run of literal bytes in each
+//  signature (at most Maximum_Atom_Length of them) goes into one
+//  Aho-Corasick automaton with a full 256-way transition table; the rest
+//  of the signature is checked only where its atom is found.  Scanning
+//  skips ahead with a Byte_Set_Finder whenever the automaton is back at
+//  its root, so data that cannot start any atom is passed over 32 bytes
+//  at a time.
+//
+class Signature_Set
+{
+    public:
+        static constexpr size_t Maximum_Atom_Length = 8;
+
+        struct Signature
+        {
+            std::string Name;
+            std::string Bytes;
+
+            // 0xff where the byte must match, 0 for a wildcard.
+            std::string Mask;
+
+            size_t Atom_Offset;
+            size_t Atom_Length;
+        };
+
+    private:
+        std::vector<Signature> _signatures;
+
+        std::vector<uint32_t> _transitions;
+
+        // Signatures whose atom ends in a state: _outputs[_output_begin[s]] .. _outputs[_output_begin[s + 1]].
+        std::vector<uint32_t> _output_begin;
+        std::vector<uint32_t> _outputs;
+
+        Byte_Set_Finder _first_bytes;
+
+        Signature_Set() {}
+
+        void build_automaton();
+
+        bool matches(Signature const& signature, string_view data, size_t start) const;
+
+    public:
+        // Returns nullptr and describes the first bad line in error.
+        static Signature_Set* Compile(string_view rules, std::string& error);
+
+        size_t size() const { return _signatures.size(); }
+        Signature const& operator[](size_t i) const { return _signatures[i]; }
+
+        size_t Get_State_Count() const { return _output_begin.size() - 1; }
+
+        // Calls found(signature index, start offset) for every match, in the order the atoms end.
+        void Scan(string_view data, std::function<void(size_t, uint64_t)> const& found) const;
+};
+
+#endif  // SIGNATURES_H__INCLUDED
@@ -0,0 +1,213 @@
+#include "strings.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// One bit per byte of a block: printable bytes, and zero bytes.
+struct Block_Masks
+{
+    uint64_t Printable;
+    uint64_t Zero;
+};
+
+using Classify_Function = Block_Masks (*)(char const* block);
+
+static size_t const Block_Size = 64;
+
+static bool Is_Printable(uint8_t byte)
+{
+    return ((byte >= 0x20) && (byte <= 0x7e)) || (byte == '\t');
+}
+
+static Block_Masks Classify_Tail(char const* data, size_t size)
+{
+    Block_Masks masks { 0, 0 };
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        masks.Printable |= uint64_t(Is_Printable(uint8_t(data[i]))) << i;
+        masks.Zero |= uint64_t(data[i] == 0) << i;
+    }
+
+    return masks;
+}
+
+static Block_Masks Classify_Portable(char const* block)
+{
+    return Classify_Tail(block, Block_Size);
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+static Block_Masks Classify_AVX2(char const* block)
+{
+    auto const space_minus_one = _mm256_set1_epi8(0x1f);
+    auto const delete_character = _mm256_set1_epi8(0x7f);
+    auto const tab = _mm256_set1_epi8('\t');
+    auto const zero = _mm256_setzero_si256();
+
+    Block_Masks masks { 0, 0 };
+
+    for (int half = 0; half < 2; ++half)
+    {
+        auto const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block + (half * 32)));
+
+        // Signed compares: bytes from 0x80 up are negative and fail the first test.
+        auto const printable =
+            _mm256_or_si256(
+                _mm256_and_si256(_mm256_cmpgt_epi8(bytes, space_minus_one), _mm256_cmpgt_epi8(delete_character, bytes)),
+                _mm256_cmpeq_epi8(bytes, tab));
+
+        masks.Printable |= uint64_t(uint32_t(_mm256_movemask_epi8(printable))) << (half * 32);
+        masks.Zero |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, zero)))) << (half * 32);
+    }
+
+    return masks;
+}
+
+#endif
+
+static Classify_Function Get_Classify_Function()
+{
+    static Classify_Function const classify = []() -> Classify_Function
+    {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return Classify_AVX2;
+#endif
+
+        return Classify_Portable;
+    }();
+
+    return classify;
+}
+
+//
+//  Follows runs of set bits across consecutive block masks and reports
+//  each run, as a byte range, when it ends.
+//
+class Run_Tracker
+{
+    private:
+        bool _in_run;
+        uint64_t _run_start;
+
+    public:
+        Run_Tracker(): _in_run{false}, _run_start{0} {}
+
+        template<typename Close_Run>
+        void Feed(uint64_t mask, uint64_t block_offset, Close_Run&& close_run)
+        {
+            unsigned position = 0;
+
+            while (position < 64)
+            {
+                if (!_in_run)
+                {
+                    auto const rest = mask >> position;
+
+                    if (rest == 0)
+                        return;
+
+                    position += std::countr_zero(rest);
+                    _run_start = block_offset + position;
+                    _in_run = true;
+                } else {
+                    auto const rest = ~mask >> position;
+
+                    // The bits shifted in at the top read as "still running".
+                    if (rest == 0)
+                        return;
+
+                    position += std::countr_zero(rest);
+                    close_run(_run_start, block_offset + position);
+                    _in_run = false;
+                }
+            }
+        }
+
+        template<typename Close_Run>
+        void Finish(uint64_t end, Close_Run&& close_run)
+        {
+            if (_in_run)
+                close_run(_run_start, end);
+
+            _in_run = false;
+        }
+};
+
+void Find_Strings(string_view data, size_t minimum_length, std::function<void(Found_String const&)> const& found)
+{
+    auto const classify = Get_Classify_Function();
+
+    Run_Tracker ascii;
+    Run_Tracker utf16[2];
+
+    auto close_ascii = [&](uint64_t begin, uint64_t end)
+    {
+        if (end - begin >= minimum_length)
+            found(Found_String { begin, String_Encoding::ASCII, data.substr(begin, end - begin), size_t(end - begin) });
+    };
+
+    auto close_utf16 = [&](uint64_t begin, uint64_t end)
+    {
+        auto const length = (end - begin) / 2;
+
+        if (length >= minimum_length)
+            found(Found_String { begin, String_Encoding::UTF16_LE, data.substr(begin, length * 2), size_t(length) });
+    };
+
+    static uint64_t const Parity_Masks[2] = { 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL };
+
+    // Code units that started in the last bit of the previous block, per parity.
+    uint64_t utf16_carry[2] = { 0, 0 };
+
+    for (uint64_t offset = 0; offset < data.size(); offset += Block_Size)
+    {
+        auto const size = std::min<uint64_t>(Block_Size, data.size() - offset);
+        auto const masks = (size == Block_Size) ? classify(data.data() + offset) : Classify_Tail(data.data() + offset, size);
+
+        ascii.Feed(masks.Printable, offset, close_ascii);
+
+        //
+        //  A UTF-16LE unit starts at i when byte i is printable and byte
+        //  i + 1 is zero.  Per parity, widening each start bit over both of
+        //  its bytes turns a string into a plain run of set bits.
+        //
+        uint64_t const next_zero = (offset + size < data.size()) ? (data[offset + size] == 0) : 0;
+        uint64_t const starts = masks.Printable & ((masks.Zero >> 1) | (next_zero << 63));
+
+        for (int parity = 0; parity < 2; ++parity)
+        {
+            auto const parity_starts = starts & Parity_Masks[parity];
+
+            utf16[parity].Feed(parity_starts | (parity_starts << 1) | utf16_carry[parity], offset, close_utf16);
+            utf16_carry[parity] = parity_starts >> 63;
+        }
+    }
+
+    ascii.Finish(data.size(), close_ascii);
+
+    for (auto& tracker: utf16)
+        tracker.Finish(data.size(), close_utf16);
+}
+
+void Append_String_Text(Found_String const& string, std::string& text)
+{
+    if (string.Encoding == String_Encoding::ASCII)
+    {
+        text.append(string.Bytes);
+        return;
+    }
+
+    for (size_t i = 0; i < string.Bytes.size(); i += 2)
+        text.push_back(string.Bytes[i]);
+}
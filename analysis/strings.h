@@ -0,0 +1,44 @@
+#ifndef STRINGS_H__INCLUDED
+#define STRINGS_H__INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+using std::string_view;
+
+enum class String_Encoding
+{
+    ASCII,
+    UTF16_LE
+};
+
+struct Found_String
+{
+    // From the start of the scanned data.
+    uint64_t Offset;
+
+    String_Encoding Encoding;
+
+    // The raw bytes; for UTF-16LE every other byte is a zero.
+    string_view Bytes;
+
+    size_t Length;
+};
+
+//
+//  Finds runs of at least minimum_length printable characters (space to
+//  '~' and tab), both as ASCII bytes and as UTF-16LE code units.  The data
+//  is classified 64 bytes at a time into bit masks (with AVX2 when the CPU
+//  has it), and runs are read off the masks with bit scans, so long
+//  stretches of code or zeros cost a few instructions per block.  Each
+//  string is handed to found as soon as its run ends; nothing is kept.
+//
+void Find_Strings(string_view data, size_t minimum_length, std::function<void(Found_String const&)> const& found);
+
+// The text of a found string: the bytes themselves, or the low byte of each UTF-16 unit.
+void Append_String_Text(Found_String const& string, std::string& text);
+
+#endif  // STRINGS_H__INCLUDED
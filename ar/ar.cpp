@@ -0,0 +1,203 @@
+#include "ar.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#include <include/endian.h>
+
+using std::string_view;
+
+static string_view Trim_Right(string_view text, char padding = ' ')
+{
+    auto const end = text.find_last_not_of(padding);
+    return (end == string_view::npos) ? string_view{} : text.substr(0, end + 1);
+}
+
+template<size_t N>
+static bool Parse_Decimal_Field(char const (&field)[N], uint64_t& value)
+{
+    auto const text = Trim_Right(string_view(field, N));
+
+    if (text.empty())
+        return false;
+
+    auto const result = std::from_chars(text.data(), text.data() + text.size(), value);
+
+    return (result.ec == std::errc{}) && (result.ptr == text.data() + text.size());
+}
+
+// Reads one big-endian symbol index word of 4 ("/") or 8 ("/SYM64/") bytes.
+static uint64_t Read_Index_Word(char const* data, size_t word_size)
+{
+    if (word_size == 8)
+    {
+        Endian_Value<uint64_t, std::endian::big> value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    Endian_Value<uint32_t, std::endian::big> value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+AR* AR::Parse(string_view buffer)
+{
+    if (!buffer.starts_with(Magic))
+        return nullptr;
+
+    auto ar = new AR{buffer};
+    ar->index_members();
+
+    return ar;
+}
+
+void AR::index_members()
+{
+    auto const archive = buffer();
+    string_view long_names;
+
+    //
+    //  A truncated or damaged header ends the walk; the members indexed so
+    //  far are kept.
+    //
+    for (size_t offset = Magic.size(); archive.size() - offset >= sizeof(Member_Header); )
+    {
+        auto const& header = get_field<Member_Header>(offset);
+        uint64_t size = 0;
+
+        if ((string_view(header.End, sizeof(header.End)) != "`\n") || !Parse_Decimal_Field(header.Size, size))
+            break;
+
+        auto const data_offset = offset + sizeof(Member_Header);
+
+        if (size > archive.size() - data_offset)
+            break;
+
+        auto contents = archive.substr(data_offset, size);
+        auto const raw_name = Trim_Right(string_view(header.Name, sizeof(header.Name)));
+
+        Member member { raw_name, &header, contents, offset };
+
+        // Members start on even offsets; odd-sized ones are padded with '\n'.
+        offset = data_offset + size + (size & 1);
+
+        if ((raw_name == "/") || (raw_name == "/SYM64/"))
+        {
+            size_t const word_size = (raw_name == "/") ? 4 : 8;
+
+            if (contents.size() < word_size)
+                continue;
+
+            auto const count = Read_Index_Word(contents.data(), word_size);
+
+            if (count > (contents.size() / word_size) - 1)
+                continue;
+
+            _symbol_offset_size = word_size;
+            _symbol_offsets = contents.substr(word_size, count * word_size);
+            _symbol_names = contents.substr(word_size + (count * word_size));
+            continue;
+        }
+
+        if (raw_name == "//")
+        {
+            long_names = contents;
+            continue;
+        }
+
+        // BSD symbol tables are not indexed.
+        if (raw_name.starts_with("__.SYMDEF"))
+            continue;
+
+        if (raw_name.starts_with("#1/"))
+        {
+            // BSD: the name is stored at the front of the member data.
+            uint64_t name_length = 0;
+            auto const length_text = raw_name.substr(3);
+
+            std::from_chars(length_text.data(), length_text.data() + length_text.size(), name_length);
+
+            if (name_length > contents.size())
+                continue;
+
+            member.Name = Trim_Right(contents.substr(0, name_length), '\0');
+            member.Contents = contents.substr(name_length);
+        }
+        else if ((raw_name.size() > 1) && (raw_name[0] == '/'))
+        {
+            // GNU: "/<offset>" into the long-name table, each name ending in "/\n".
+            uint64_t name_offset = 0;
+            auto const offset_text = raw_name.substr(1);
+            auto const result = std::from_chars(offset_text.data(), offset_text.data() + offset_text.size(), name_offset);
+
+            if ((result.ec != std::errc{}) || (name_offset >= long_names.size()))
+                continue;
+
+            auto const name = long_names.substr(name_offset);
+            member.Name = name.substr(0, name.find('\n'));
+        }
+
+        if (member.Name.ends_with('/'))
+            member.Name.remove_suffix(1);
+
+        _members.push_back(member);
+    }
+}
+
+AR::Member const* AR::Find_Member_At(uint64_t offset) const
+{
+    auto const it =
+        std::lower_bound(
+            _members.begin(), _members.end(), offset,
+            [](Member const& member, uint64_t offset) { return member.Offset < offset; });
+
+    return ((it != _members.end()) && (it->Offset == offset)) ? &*it : nullptr;
+}
+
+void AR::build_symbols() const
+{
+    if (_symbol_offset_size == 0)
+        return;
+
+    auto const count = _symbol_offsets.size() / _symbol_offset_size;
+    auto names = _symbol_names;
+
+    _symbols.reserve(count);
+
+    for (size_t i = 0; (i < count) && !names.empty(); ++i)
+    {
+        auto const end = names.find('\0');
+        auto const name = names.substr(0, end);
+
+        names = (end == string_view::npos) ? string_view{} : names.substr(end + 1);
+
+        auto const member_offset = Read_Index_Word(&_symbol_offsets[i * _symbol_offset_size], _symbol_offset_size);
+
+        _symbols.push_back(Symbol{name, Find_Member_At(member_offset)});
+    }
+
+    auto get_name = [this](uint32_t i) { return _symbols[i].Name; };
+
+    _symbol_index.reserve(_symbols.size());
+
+    for (uint32_t i = 0; i < _symbols.size(); ++i)
+        _symbol_index.Insert(i, _symbols[i].Name, get_name);
+}
+
+std::vector<AR::Symbol> const& AR::Get_Symbols() const
+{
+    std::call_once(_symbols_built, [this] { build_symbols(); });
+    return _symbols;
+}
+
+AR::Member const* AR::Find_Member_By_Symbol(string_view name) const
+{
+    auto const& symbols = Get_Symbols();
+    auto const i = _symbol_index.Find(name, [&](uint32_t i) { return symbols[i].Name; });
+
+    return (i == Name_Index::npos) ? nullptr : symbols[i].Defining_Member;
+}
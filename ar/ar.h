@@ -0,0 +1,90 @@
+#ifndef AR_H__INCLUDED
+#define AR_H__INCLUDED
+
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "include/file-format.h"
+#include "include/name-index.h"
+
+using std::string_view;
+
+//
+//  A System V / GNU "!<arch>" archive.  Members are indexed once, when the
+//  archive is parsed, by walking the member headers; names and contents are
+//  views into the archive buffer and are never copied.  The GNU long-name
+//  table ("//") and the symbol index ("/" or "/SYM64/") are resolved in
+//  place as well, and BSD "#1/<length>" names are understood too.
+//
+class AR: public Parsed_File
+{
+    public:
+        struct __attribute__((packed)) Member_Header
+        {
+            char Name[16];
+            char Modification_Time[12];
+            char Owner_ID[6];
+            char Group_ID[6];
+            char Mode[8];
+            char Size[10];
+            char End[2];
+        };
+
+        struct Member
+        {
+            string_view Name;
+            Member_Header const* Header;
+            string_view Contents;
+
+            // Offset of the member header from the start of the archive.
+            uint64_t Offset;
+        };
+
+        struct Symbol
+        {
+            string_view Name;
+            Member const* Defining_Member;
+        };
+
+    private:
+        std::vector<Member> _members;
+
+        // Raw symbol index: big-endian member offsets followed by the names.
+        string_view _symbol_offsets;
+        size_t _symbol_offset_size;
+        string_view _symbol_names;
+
+        mutable std::once_flag _symbols_built;
+        mutable std::vector<Symbol> _symbols;
+        mutable Name_Index _symbol_index;
+
+        AR(string_view buffer): Parsed_File{buffer}, _symbol_offset_size{0} {}
+
+        void index_members();
+        void build_symbols() const;
+
+    public:
+        static constexpr string_view Magic = "!<arch>\n";
+
+        static AR* Parse(string_view buffer);
+
+        File_Format Get_File_Format() const override { return File_Format::AR_Arch; }
+
+        // Every regular member, in archive order; special members are skipped.
+        std::vector<Member> const& Get_Members() const { return _members; }
+
+        // The member whose header starts at the given archive offset, or nullptr.
+        Member const* Find_Member_At(uint64_t offset) const;
+
+        // The symbol index, in index order; empty if the archive has none.
+        std::vector<Symbol> const& Get_Symbols() const;
+
+        // The member defining the symbol, looked up through a hash index.
+        Member const* Find_Member_By_Symbol(string_view name) const;
+
+        ~AR() override {}
+};
+
+#endif  // AR_H__INCLUDED
@@ -0,0 +1,211 @@
+#include "columnar.h"
+
+#include <cstring>
+#include <string_view>
+
+using std::string_view;
+
+namespace Columnar
+{
+    static string_view Get_Name_Field(char const (&field)[24])
+    {
+        auto const name = string_view(field, sizeof(field));
+        return name.substr(0, name.find('\0'));
+    }
+
+    Columnar_File::Columnar_File(string_view buffer):
+        Parsed_File{buffer},
+        _footer{nullptr},
+        _tables{static_cast<Table_Descriptor const*>(nullptr), size_t(0)},
+        _columns{static_cast<Column_Descriptor const*>(nullptr), size_t(0)},
+        _row_counts{static_cast<Little<uint64_t> const*>(nullptr), size_t(0)},
+        _chunk_offsets{static_cast<Little<uint64_t> const*>(nullptr), size_t(0)},
+        _string_offsets{static_cast<Little<uint64_t> const*>(nullptr), size_t(0)}
+    {}
+
+    Columnar_File* Columnar_File::Parse(string_view buffer)
+    {
+        if ((buffer.size() < sizeof(File_Header) + sizeof(Trailer)) || !buffer.starts_with(Magic))
+            return nullptr;
+
+        auto columnar_file = new Columnar_File{buffer};
+
+        if (!columnar_file->validate())
+        {
+            delete columnar_file;
+            return nullptr;
+        }
+
+        return columnar_file;
+    }
+
+    bool Columnar_File::validate()
+    {
+        auto const file = buffer();
+        auto const& trailer = get_field<Trailer>(file.size() - sizeof(Trailer));
+
+        if ((string_view(trailer.Magic, sizeof(trailer.Magic)) != Magic) ||
+            (get_header<File_Header>().Version != Version))
+            return false;
+
+        // Everything between the footer header and the trailer.
+        uint64_t const footer_offset = trailer.Footer_Offset;
+        auto const footer_end = file.size() - sizeof(Trailer);
+
+        if ((footer_offset < sizeof(File_Header)) ||
+            (footer_offset > footer_end) ||
+            (footer_end - footer_offset < sizeof(Footer_Header)))
+            return false;
+
+        _footer = &get_field<Footer_Header>(footer_offset);
+
+        uint64_t const table_count = _footer->Table_Count;
+        uint64_t const column_count = _footer->Column_Count;
+        uint64_t const row_group_count = _footer->Row_Group_Count;
+
+        // The counts must account for the footer exactly, checked without overflowing.
+        auto remaining = footer_end - footer_offset - sizeof(Footer_Header);
+
+        if (table_count > remaining / sizeof(Table_Descriptor))
+            return false;
+
+        remaining -= table_count * sizeof(Table_Descriptor);
+
+        if (column_count > remaining / sizeof(Column_Descriptor))
+            return false;
+
+        remaining -= column_count * sizeof(Column_Descriptor);
+
+        auto const row_group_size = (table_count + column_count) * sizeof(uint64_t);
+
+        if ((row_group_size == 0) || (remaining % row_group_size != 0) || (remaining / row_group_size != row_group_count))
+            return false;
+
+        auto offset = footer_offset + sizeof(Footer_Header);
+
+        _tables = get_table<Table_Descriptor const>(offset, table_count);
+        offset += table_count * sizeof(Table_Descriptor);
+
+        _columns = get_table<Column_Descriptor const>(offset, column_count);
+        offset += column_count * sizeof(Column_Descriptor);
+
+        _row_counts = get_table<Little<uint64_t> const>(offset, row_group_count * table_count);
+        offset += row_group_count * table_count * sizeof(uint64_t);
+
+        _chunk_offsets = get_table<Little<uint64_t> const>(offset, row_group_count * column_count);
+
+        for (auto const& table: _tables)
+        {
+            if ((table.First_Column > column_count) || (table.Column_Count > column_count - table.First_Column))
+                return false;
+        }
+
+        for (size_t table = 0; table < table_count; ++table)
+        {
+            for (size_t column = 0; column < Get_Column_Count(table); ++column)
+            {
+                auto const width = Get_Column_Width(Get_Column_Type(table, column));
+
+                for (size_t row_group = 0; row_group < row_group_count; ++row_group)
+                {
+                    uint64_t const chunk_offset = _chunk_offsets[(row_group * column_count) + _tables[table].First_Column + column];
+                    uint64_t const row_count = Get_Row_Count(table, row_group);
+
+                    if ((chunk_offset > footer_offset) || (row_count > (footer_offset - chunk_offset) / width))
+                        return false;
+                }
+            }
+        }
+
+        uint64_t const dictionary_offset = _footer->Dictionary_Offset;
+        uint64_t const dictionary_size = _footer->Dictionary_Size;
+
+        if ((dictionary_offset > footer_offset) ||
+            (dictionary_size > footer_offset - dictionary_offset) ||
+            (dictionary_size < 2 * sizeof(uint64_t)))
+            return false;
+
+        uint64_t const string_count = get_field<Little<uint64_t>>(dictionary_offset);
+        auto const offsets_size = (string_count + 1) * sizeof(uint64_t);
+
+        if (string_count > (dictionary_size / sizeof(uint64_t)) - 2)
+            return false;
+
+        _string_offsets = get_table<Little<uint64_t> const>(dictionary_offset + sizeof(uint64_t), string_count + 1);
+        _strings = file.substr(
+            dictionary_offset + sizeof(uint64_t) + offsets_size,
+            dictionary_size - sizeof(uint64_t) - offsets_size);
+
+        return (_string_offsets[string_count] <= _strings.size());
+    }
+
+    string_view Columnar_File::Get_Table_Name(size_t table) const
+    {
+        return Get_Name_Field(_tables[table].Name);
+    }
+
+    string_view Columnar_File::Get_Column_Name(size_t table, size_t column) const
+    {
+        return Get_Name_Field(_columns[_tables[table].First_Column + column].Name);
+    }
+
+    Column_Type Columnar_File::Get_Column_Type(size_t table, size_t column) const
+    {
+        return _columns[_tables[table].First_Column + column].Type;
+    }
+
+    size_t Columnar_File::Find_Table(string_view name) const
+    {
+        for (size_t table = 0; table < Table_Count(); ++table)
+            if (Get_Table_Name(table) == name)
+                return table;
+
+        return npos;
+    }
+
+    size_t Columnar_File::Find_Column(size_t table, string_view name) const
+    {
+        for (size_t column = 0; column < Get_Column_Count(table); ++column)
+            if (Get_Column_Name(table, column) == name)
+                return column;
+
+        return npos;
+    }
+
+    uint64_t Columnar_File::Get_Row_Count(size_t table, size_t row_group) const
+    {
+        return _row_counts[(row_group * Table_Count()) + table];
+    }
+
+    uint64_t Columnar_File::Get_Row_Count(size_t table) const
+    {
+        uint64_t row_count = 0;
+
+        for (size_t row_group = 0; row_group < Row_Group_Count(); ++row_group)
+            row_count += Get_Row_Count(table, row_group);
+
+        return row_count;
+    }
+
+    string_view Columnar_File::Get_Chunk(size_t table, size_t column, size_t row_group) const
+    {
+        auto const width = Get_Column_Width(Get_Column_Type(table, column));
+        uint64_t const offset = _chunk_offsets[(row_group * _columns.size()) + _tables[table].First_Column + column];
+
+        return buffer().substr(offset, Get_Row_Count(table, row_group) * width);
+    }
+
+    string_view Columnar_File::Get_String(uint32_t id) const
+    {
+        if (id >= String_Count())
+            return {};
+
+        uint64_t const begin = _string_offsets[id];
+        uint64_t const end = _string_offsets[id + 1];
+
+        if ((begin > end) || (end > _strings.size()))
+            return {};
+
+        return _strings.substr(begin, end - begin);
+    }
+}
@@ -0,0 +1,186 @@
+#ifndef COLUMNAR_H__INCLUDED
+#define COLUMNAR_H__INCLUDED
+
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "include/array-view.h"
+#include "include/endian.h"
+#include "include/file-format.h"
+
+using std::string_view;
+
+//
+//  A self-describing columnar file.  Rows are grouped into row groups; inside
+//  a row group every column of every table is one contiguous, 8-byte aligned
+//  run of fixed-width little-endian values.  Strings are stored once in a
+//  file-wide dictionary and referenced from columns by 32-bit id.  The
+//  schema, dictionary location and chunk offsets live in a footer found
+//  through a fixed trailer at the end of the file:
+//
+//      File_Header
+//      column chunks, row group by row group
+//      dictionary: String_Count, String_Count + 1 offsets, characters
+//      Footer_Header, Table_Descriptors, Column_Descriptors,
+//          row counts [row group][table], chunk offsets [row group][column]
+//      Trailer
+//
+namespace Columnar
+{
+    template<typename T>
+    using Little = Endian_Value<T, std::endian::little>;
+
+    enum class Column_Type: uint8_t
+    {
+        U8      = 1,
+        U16     = 2,
+        U32     = 3,
+        U64     = 4,
+
+        // A 32-bit id into the string dictionary.
+        String  = 5,
+
+        // A 32-bit row number in the file's first table.
+        Row_Id  = 6
+    };
+
+    constexpr size_t Get_Column_Width(Column_Type type)
+    {
+        switch (type)
+        {
+            case Column_Type::U8:       return 1;
+            case Column_Type::U16:      return 2;
+            case Column_Type::U64:      return 8;
+
+            case Column_Type::U32:
+            case Column_Type::String:
+            case Column_Type::Row_Id:
+            default:
+                return 4;
+        }
+    }
+
+    struct Column_Schema
+    {
+        string_view Name;
+        Column_Type Type;
+    };
+
+    struct Table_Schema
+    {
+        string_view Name;
+        std::vector<Column_Schema> Columns;
+    };
+
+    using Schema = std::vector<Table_Schema>;
+
+    constexpr string_view Magic = "BTCOLMN1";
+    constexpr uint32_t Version = 1;
+
+    struct __attribute__((packed)) File_Header
+    {
+        char Magic[8];
+        Little<uint32_t> Version;
+        Little<uint32_t> Reserved;
+    };
+
+    struct __attribute__((packed)) Footer_Header
+    {
+        Little<uint32_t> Table_Count;
+        Little<uint32_t> Column_Count;
+        Little<uint32_t> Row_Group_Count;
+        Little<uint32_t> Reserved;
+        Little<uint64_t> Dictionary_Offset;
+        Little<uint64_t> Dictionary_Size;
+    };
+
+    struct __attribute__((packed)) Table_Descriptor
+    {
+        char Name[24];
+        Little<uint32_t> First_Column;
+        Little<uint32_t> Column_Count;
+    };
+
+    struct __attribute__((packed)) Column_Descriptor
+    {
+        char Name[24];
+        Column_Type Type;
+        uint8_t Reserved[7];
+    };
+
+    struct __attribute__((packed)) Trailer
+    {
+        Little<uint64_t> Footer_Offset;
+        char Magic[8];
+    };
+
+    //
+    //  Reads a columnar file in place.  Parse() checks the trailer, footer
+    //  and every chunk against the buffer once; after that columns come back
+    //  as views straight into the (normally memory-mapped) file.
+    //
+    class Columnar_File: public Parsed_File
+    {
+        private:
+            Footer_Header const* _footer;
+            array_view<Table_Descriptor const> _tables;
+            array_view<Column_Descriptor const> _columns;
+            array_view<Little<uint64_t> const> _row_counts;
+            array_view<Little<uint64_t> const> _chunk_offsets;
+            array_view<Little<uint64_t> const> _string_offsets;
+            string_view _strings;
+
+            Columnar_File(string_view buffer);
+
+            bool validate();
+
+        public:
+            static Columnar_File* Parse(string_view buffer);
+
+            File_Format Get_File_Format() const override { return File_Format::Columnar; }
+
+            size_t Table_Count() const { return _tables.size(); }
+            size_t Row_Group_Count() const { return _footer->Row_Group_Count; }
+
+            string_view Get_Table_Name(size_t table) const;
+            size_t Get_Column_Count(size_t table) const { return _tables[table].Column_Count; }
+            string_view Get_Column_Name(size_t table, size_t column) const;
+            Column_Type Get_Column_Type(size_t table, size_t column) const;
+
+            // npos when there is no such table or column.
+            static constexpr size_t npos = size_t(-1);
+            size_t Find_Table(string_view name) const;
+            size_t Find_Column(size_t table, string_view name) const;
+
+            uint64_t Get_Row_Count(size_t table, size_t row_group) const;
+            uint64_t Get_Row_Count(size_t table) const;
+
+            // The raw bytes of one column chunk.
+            string_view Get_Chunk(size_t table, size_t column, size_t row_group) const;
+
+            //
+            //  One column chunk as typed values; T must match the column
+            //  width (uint32_t for String and Row_Id columns).  Returns an
+            //  empty view on a mismatch.
+            //
+            template<typename T>
+            array_view<Little<T> const> Get_Column(size_t table, size_t column, size_t row_group) const
+            {
+                if (Get_Column_Width(Get_Column_Type(table, column)) != sizeof(T))
+                    return { static_cast<Little<T> const*>(nullptr), size_t(0) };
+
+                auto const chunk = Get_Chunk(table, column, row_group);
+
+                return { reinterpret_cast<Little<T> const*>(chunk.data()), chunk.size() / sizeof(T) };
+            }
+
+            size_t String_Count() const { return _string_offsets.empty() ? 0 : _string_offsets.size() - 1; }
+            string_view Get_String(uint32_t id) const;
+
+            ~Columnar_File() override {}
+    };
+}
+
+#endif  // COLUMNAR_H__INCLUDED
@@ -0,0 +1,268 @@
+#include "writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace Columnar
+{
+    template<typename T, typename Value>
+    static void Set(Little<T>& field, Value value)
+    {
+        field = Little<T>::From(T(value));
+    }
+
+    Row_Group_Builder::Row_Group_Builder(Schema const& schema):
+        _schema{schema}
+    {
+        for (auto const& table: schema)
+        {
+            _first_column.push_back(_column_types.size());
+
+            for (auto const& column: table.Columns)
+                _column_types.push_back(column.Type);
+        }
+
+        _columns.resize(_column_types.size());
+    }
+
+    void Row_Group_Builder::append(size_t column, uint64_t value)
+    {
+        auto const width = Get_Column_Width(_column_types[column]);
+        auto& data = _columns[column];
+
+        // Little-endian, truncated to the column width.
+        for (size_t i = 0; i < width; ++i)
+            data.push_back(char(value >> (8 * i)));
+    }
+
+    uint32_t Row_Group_Builder::add_string(string_view text)
+    {
+        _strings.append(text);
+        _string_ends.push_back(uint32_t(_strings.size()));
+
+        return uint32_t(_string_ends.size() - 1);
+    }
+
+    uint64_t Row_Group_Builder::Get_Row_Count(size_t table) const
+    {
+        auto const column = _first_column[table];
+        return _columns[column].size() / Get_Column_Width(_column_types[column]);
+    }
+
+    bool Row_Group_Builder::empty() const
+    {
+        return std::all_of(_columns.begin(), _columns.end(), [](auto const& data) { return data.empty(); });
+    }
+
+    void Row_Group_Builder::clear()
+    {
+        for (auto& data: _columns)
+            data.clear();
+
+        _strings.clear();
+        _string_ends.clear();
+    }
+
+    Columnar_Writer::Columnar_Writer(Schema schema):
+        _schema{std::move(schema)},
+        _offset{0},
+        _current{_schema},
+        _row_id_base{0},
+        _row_group_count{0}
+    {}
+
+    Columnar_Writer* Columnar_Writer::Create(std::string const& file_name, Schema schema)
+    {
+        auto writer = new Columnar_Writer{std::move(schema)};
+
+        writer->_file.open(file_name, std::ios::binary | std::ios::trunc);
+
+        if (!writer->_file)
+        {
+            auto const saved_errno = errno;
+            delete writer;
+            errno = saved_errno;
+            return nullptr;
+        }
+
+        File_Header header {};
+        std::memcpy(header.Magic, Magic.data(), sizeof(header.Magic));
+        Set(header.Version, Version);
+
+        writer->write(&header, sizeof(header));
+
+        return writer;
+    }
+
+    void Columnar_Writer::write(void const* data, size_t size)
+    {
+        _file.write(static_cast<char const*>(data), size);
+        _offset += size;
+    }
+
+    void Columnar_Writer::pad()
+    {
+        static char const zeros[8] = {};
+
+        if (auto const misalignment = _offset % sizeof(zeros); misalignment != 0)
+            write(zeros, sizeof(zeros) - misalignment);
+    }
+
+    uint32_t Columnar_Writer::intern(string_view text)
+    {
+        auto const [it, inserted] = _dictionary_index.try_emplace(std::string(text), uint32_t(_dictionary.size()));
+
+        if (inserted)
+            _dictionary.push_back(&it->first);
+
+        return it->second;
+    }
+
+    void Columnar_Writer::Append(Row_Group_Builder const& rows)
+    {
+        auto const row_id_base = _row_id_base + _current.Get_Row_Count(0);
+
+        for (size_t column = 0; column < rows._columns.size(); ++column)
+        {
+            auto const& data = rows._columns[column];
+
+            switch (rows._column_types[column])
+            {
+                case Column_Type::String:
+                    for (size_t i = 0; i < data.size(); i += sizeof(uint32_t))
+                    {
+                        Little<uint32_t> local;
+                        std::memcpy(&local, &data[i], sizeof(local));
+
+                        auto const begin = (local == 0) ? 0 : rows._string_ends[local - 1];
+                        auto const end = rows._string_ends[local];
+
+                        _current.append(column, intern(string_view(rows._strings).substr(begin, end - begin)));
+                    }
+                    break;
+
+                case Column_Type::Row_Id:
+                    for (size_t i = 0; i < data.size(); i += sizeof(uint32_t))
+                    {
+                        Little<uint32_t> local;
+                        std::memcpy(&local, &data[i], sizeof(local));
+
+                        _current.append(column, row_id_base + local);
+                    }
+                    break;
+
+                default:
+                    _current._columns[column].append(data);
+                    break;
+            }
+        }
+    }
+
+    void Columnar_Writer::Flush_Row_Group()
+    {
+        if (_current.empty())
+            return;
+
+        for (size_t table = 0; table < _schema.size(); ++table)
+            _row_counts.push_back(_current.Get_Row_Count(table));
+
+        for (auto const& data: _current._columns)
+        {
+            pad();
+            _chunk_offsets.push_back(_offset);
+            write(data.data(), data.size());
+        }
+
+        _row_id_base += _current.Get_Row_Count(0);
+        ++_row_group_count;
+
+        _current.clear();
+    }
+
+    bool Columnar_Writer::Close()
+    {
+        Flush_Row_Group();
+
+        pad();
+
+        auto const dictionary_offset = _offset;
+        Little<uint64_t> value;
+        Set(value, _dictionary.size());
+
+        write(&value, sizeof(value));
+
+        uint64_t string_offset = 0;
+        Set(value, 0);
+        write(&value, sizeof(value));
+
+        for (auto const* text: _dictionary)
+        {
+            string_offset += text->size();
+            Set(value, string_offset);
+            write(&value, sizeof(value));
+        }
+
+        for (auto const* text: _dictionary)
+            write(text->data(), text->size());
+
+        auto const dictionary_size = _offset - dictionary_offset;
+
+        pad();
+
+        auto const footer_offset = _offset;
+
+        Footer_Header footer {};
+        Set(footer.Table_Count, uint32_t(_schema.size()));
+        Set(footer.Column_Count, uint32_t(_current._column_types.size()));
+        Set(footer.Row_Group_Count, _row_group_count);
+        Set(footer.Dictionary_Offset, dictionary_offset);
+        Set(footer.Dictionary_Size, dictionary_size);
+
+        write(&footer, sizeof(footer));
+
+        for (size_t table = 0; table < _schema.size(); ++table)
+        {
+            Table_Descriptor descriptor {};
+            _schema[table].Name.copy(descriptor.Name, sizeof(descriptor.Name) - 1);
+            Set(descriptor.First_Column, uint32_t(_current._first_column[table]));
+            Set(descriptor.Column_Count, uint32_t(_schema[table].Columns.size()));
+
+            write(&descriptor, sizeof(descriptor));
+        }
+
+        for (auto const& table: _schema)
+        {
+            for (auto const& column: table.Columns)
+            {
+                Column_Descriptor descriptor {};
+                column.Name.copy(descriptor.Name, sizeof(descriptor.Name) - 1);
+                descriptor.Type = column.Type;
+
+                write(&descriptor, sizeof(descriptor));
+            }
+        }
+
+        for (auto const row_count: _row_counts)
+        {
+            Set(value, row_count);
+            write(&value, sizeof(value));
+        }
+
+        for (auto const chunk_offset: _chunk_offsets)
+        {
+            Set(value, chunk_offset);
+            write(&value, sizeof(value));
+        }
+
+        Trailer trailer {};
+        Set(trailer.Footer_Offset, footer_offset);
+        std::memcpy(trailer.Magic, Magic.data(), sizeof(trailer.Magic));
+
+        write(&trailer, sizeof(trailer));
+
+        _file.close();
+
+        return !_file.fail();
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef COLUMNAR_WRITER_H__INCLUDED
+#define COLUMNAR_WRITER_H__INCLUDED
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "columnar/columnar.h"
+#include "include/endian.h"
+
+namespace Columnar
+{
+    //
+    //  Rows for one or more tables, column by column, before they are merged
+    //  into a file.  Strings go into a local arena and are only given their
+    //  file-wide ids when the builder is appended to a Columnar_Writer, so
+    //  builders can be filled on any thread without sharing anything.
+    //
+    class Row_Group_Builder
+    {
+        public:
+            //
+            //  Adds one row to a table, one value per column in schema order:
+            //
+            //      rows.Row(table).Number(index).String(name).Number(size);
+            //
+            class Row_Appender
+            {
+                private:
+                    Row_Group_Builder& _builder;
+                    size_t _column;
+
+                public:
+                    Row_Appender(Row_Group_Builder& builder, size_t first_column):
+                        _builder{builder}, _column{first_column}
+                    {}
+
+                    template<typename T>
+                    Row_Appender& Number(T value)
+                    {
+                        _builder.append(_column++, uint64_t(Integer_Value(value)));
+                        return *this;
+                    }
+
+                    Row_Appender& String(string_view text)
+                    {
+                        _builder.append(_column++, _builder.add_string(text));
+                        return *this;
+                    }
+            };
+
+        private:
+            Schema const& _schema;
+
+            std::vector<size_t> _first_column;
+            std::vector<Column_Type> _column_types;
+            std::vector<std::string> _columns;
+
+            std::string _strings;
+            std::vector<uint32_t> _string_ends;
+
+            void append(size_t column, uint64_t value);
+            uint32_t add_string(string_view text);
+
+            friend class Columnar_Writer;
+
+        public:
+            explicit Row_Group_Builder(Schema const& schema);
+
+            Row_Appender Row(size_t table) { return Row_Appender(*this, _first_column[table]); }
+
+            uint64_t Get_Row_Count(size_t table) const;
+
+            bool empty() const;
+            void clear();
+    };
+
+    //
+    //  Writes a columnar file.  Appended builders are merged into the current
+    //  row group, and Flush_Row_Group() writes it out; the dictionary and
+    //  footer are written by Close().  Row_Id columns in an appended builder
+    //  count from that builder's first row and are rebased on the way in.
+    //
+    class Columnar_Writer
+    {
+        private:
+            Schema _schema;
+            std::ofstream _file;
+            uint64_t _offset;
+
+            Row_Group_Builder _current;
+            uint64_t _row_id_base;
+
+            std::unordered_map<std::string, uint32_t> _dictionary_index;
+            std::vector<std::string const*> _dictionary;
+
+            std::vector<uint64_t> _row_counts;
+            std::vector<uint64_t> _chunk_offsets;
+            uint32_t _row_group_count;
+
+            Columnar_Writer(Schema schema);
+
+            void write(void const* data, size_t size);
+            void pad();
+            uint32_t intern(string_view text);
+
+        public:
+            // Returns nullptr, with errno set, if the file cannot be created.
+            static Columnar_Writer* Create(std::string const& file_name, Schema schema);
+
+            void Append(Row_Group_Builder const& rows);
+
+            // Pending rows in the current row group of the file's first table.
+            uint64_t Get_Pending_Row_Count() const { return _current.Get_Row_Count(0); }
+
+            void Flush_Row_Group();
+
+            // Returns false if anything failed to reach the file.
+            bool Close();
+    };
+}
+
+#endif  // COLUMNAR_WRITER_H__INCLUDED
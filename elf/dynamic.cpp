@@ -0,0 +1,300 @@
+#include "elf.h"
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+
+using std::string_view;
+
+namespace ELF_Format
+{
+    template<typename Layout>
+    uint32_t Dynamic_Symbol_Index<Layout>::GNU_Hash(string_view name)
+    {
+        uint32_t hash = 5381;
+
+        for (auto const c: name)
+            hash = hash * 33 + uint8_t(c);
+
+        return hash;
+    }
+
+    template<typename Layout>
+    uint32_t Dynamic_Symbol_Index<Layout>::SysV_Hash(string_view name)
+    {
+        uint32_t hash = 0;
+
+        for (auto const c: name)
+        {
+            hash = (hash << 4) + uint8_t(c);
+
+            if (uint32_t const high = hash & 0xf0000000)
+                hash ^= high >> 24;
+
+            hash &= ~0xf0000000u;
+        }
+
+        return hash;
+    }
+
+    template<typename Layout>
+    string_view Dynamic_Symbol_Index<Layout>::Get_Name(Symbol const& symbol) const
+    {
+        if (symbol.Name >= _strings.size())
+            return {};
+
+        auto const name = _strings.substr(symbol.Name);
+        return name.substr(0, name.find('\0'));
+    }
+
+    //
+    //  Unlike Symbol_Table, absolute symbols count as defined here: the
+    //  dynamic linker binds to anything that is not an undefined reference.
+    //
+    template<typename Symbol_Entry>
+    static bool Is_Exported(Symbol_Entry const& symbol)
+    {
+        return uint16_t(symbol.Section_Index) != uint16_t(Special_Section_Index::Undefined);
+    }
+
+    template<typename Layout>
+    typename Dynamic_Symbol_Index<Layout>::Symbol const* Dynamic_Symbol_Index<Layout>::find_gnu(string_view name) const
+    {
+        constexpr uint32_t word_bits = sizeof(Class_Word) * 8;
+
+        uint32_t const hash = GNU_Hash(name);
+
+        uint64_t const word = _bloom[(hash / word_bits) % _bloom.size()].value();
+        uint64_t const mask = (uint64_t(1) << (hash % word_bits)) | (uint64_t(1) << ((hash >> _bloom_shift) % word_bits));
+
+        if ((word & mask) != mask)
+            return nullptr;
+
+        Symbol const* hidden = nullptr;
+
+        for (uint32_t i = _gnu_buckets[hash % _gnu_buckets.size()]; (i >= _symbol_offset) && (i < _symbols.size()); ++i)
+        {
+            if (i - _symbol_offset >= _gnu_chains.size())
+                break;
+
+            uint32_t const chain = _gnu_chains[i - _symbol_offset];
+            auto const& symbol = _symbols[i];
+
+            if (((chain | 1) == (hash | 1)) && Is_Exported(symbol) && (Get_Name(symbol) == name))
+            {
+                if (!is_hidden(i))
+                    return &symbol;
+
+                if (!hidden)
+                    hidden = &symbol;
+            }
+
+            if (chain & 1)
+                break;
+        }
+
+        return hidden;
+    }
+
+    template<typename Layout>
+    typename Dynamic_Symbol_Index<Layout>::Symbol const* Dynamic_Symbol_Index<Layout>::find_sysv(string_view name) const
+    {
+        Symbol const* hidden = nullptr;
+        uint32_t i = _buckets[SysV_Hash(name) % _buckets.size()];
+
+        // A damaged chain may loop; no chain is longer than the table.
+        for (size_t steps = 0; (i != 0) && (i < _chains.size()) && (steps < _chains.size()); ++steps)
+        {
+            if (i < _symbols.size())
+            {
+                auto const& symbol = _symbols[i];
+
+                if (Is_Exported(symbol) && (Get_Name(symbol) == name))
+                {
+                    if (!is_hidden(i))
+                        return &symbol;
+
+                    if (!hidden)
+                        hidden = &symbol;
+                }
+            }
+
+            i = _chains[i];
+        }
+
+        return hidden;
+    }
+
+    template<typename Layout>
+    typename Dynamic_Symbol_Index<Layout>::Symbol const* Dynamic_Symbol_Index<Layout>::Find(string_view name) const
+    {
+        if (Has_GNU_Hash())
+            return find_gnu(name);
+
+        if (Has_SysV_Hash())
+            return find_sysv(name);
+
+        return nullptr;
+    }
+
+    template<typename Layout>
+    template<typename Entry>
+    array_view<Entry const> ELF_File<Layout>::get_table_at_address(uint64_t address, uint64_t count) const
+    {
+        auto const offset = Get_File_Offset(address);
+
+        if (offset == npos)
+            return { static_cast<Entry const*>(nullptr), size_t(0) };
+
+        auto const range = Get_Range(offset, count * sizeof(Entry));
+        return { reinterpret_cast<Entry const*>(range.data()), range.size() / sizeof(Entry) };
+    }
+
+    template<typename Layout>
+    void ELF_File<Layout>::find_dynamic_symbol_index() const
+    {
+        using Word = typename Layout::Word;
+        using Class_Word = typename Layout::Class_Word;
+
+        uint64_t symbols_address = npos;
+        uint64_t hash_address = npos;
+        uint64_t gnu_hash_address = npos;
+        uint64_t versions_address = npos;
+
+        for (auto const& entry: Get_Dynamic_Table())
+        {
+            switch (Dynamic_Tag(entry.Tag.value()))
+            {
+                case Dynamic_Tag::Symbol_Table:
+                    symbols_address = entry.Value;
+                    break;
+
+                case Dynamic_Tag::Hash:
+                    hash_address = entry.Value;
+                    break;
+
+                case Dynamic_Tag::GNU_Hash:
+                    gnu_hash_address = entry.Value;
+                    break;
+
+                case Dynamic_Tag::Version_Symbol:
+                    versions_address = entry.Value;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        if ((symbols_address == npos) || ((hash_address == npos) && (gnu_hash_address == npos)))
+            return;
+
+        auto index = std::unique_ptr<Dynamic_Symbol_Index>(new Dynamic_Symbol_Index);
+        uint64_t symbol_count = 0;
+
+        //
+        //  DT_HASH: nbucket, nchain, then the buckets and the chains.  The
+        //  number of chains is the number of dynamic symbols.
+        //
+        if (hash_address != npos)
+        {
+            if (auto const header = get_table_at_address<Word>(hash_address, 2); header.size() == 2)
+            {
+                uint64_t const bucket_count = header[0].value();
+                uint64_t const chain_count = header[1].value();
+
+                auto const table = get_table_at_address<Word>(hash_address, 2 + bucket_count + chain_count);
+
+                if ((bucket_count != 0) && (table.size() == 2 + bucket_count + chain_count))
+                {
+                    index->_buckets = array_view<Word const>(&table[2], bucket_count);
+                    index->_chains = array_view<Word const>(&table[2 + bucket_count], chain_count);
+                    symbol_count = chain_count;
+                }
+            }
+        }
+
+        //
+        //  DT_GNU_HASH: nbuckets, symoffset, bloom_size and bloom_shift, then
+        //  the bloom filter in class-sized words, the buckets and the chains.
+        //  The chains are not counted; they run to the end of the last chain
+        //  reached from the highest bucket.
+        //
+        if (gnu_hash_address != npos)
+        {
+            if (auto const header = get_table_at_address<Word>(gnu_hash_address, 4); header.size() == 4)
+            {
+                uint64_t const bucket_count = header[0].value();
+                uint32_t const symbol_offset = header[1].value();
+                uint64_t const bloom_size = header[2].value();
+                uint32_t const bloom_shift = header[3].value();
+
+                auto const bloom = get_table_at_address<Class_Word>(gnu_hash_address + 4 * sizeof(Word), bloom_size);
+
+                uint64_t const buckets_address = gnu_hash_address + 4 * sizeof(Word) + bloom_size * sizeof(Class_Word);
+                auto const buckets = get_table_at_address<Word>(buckets_address, bucket_count);
+
+                // Everything up to the end of the file is a candidate chain; it is trimmed below.
+                auto const chains_address = buckets_address + bucket_count * sizeof(Word);
+                auto chains = get_table_at_address<Word>(chains_address, npos / sizeof(Word));
+
+                //
+                //  The shift applies to a 32-bit hash, so 32 or more would be
+                //  undefined; the table is then left unused, as a corrupt one.
+                //
+                if ((bucket_count != 0) && (bloom_size != 0) && (bloom_shift < 32) &&
+                    (bloom.size() == bloom_size) && (buckets.size() == bucket_count))
+                {
+                    uint32_t last = 0;
+
+                    for (auto const& bucket: buckets)
+                        last = std::max<uint32_t>(last, bucket.value());
+
+                    uint64_t chain_count = 0;
+
+                    if (last >= symbol_offset)
+                    {
+                        uint64_t i = last - symbol_offset;
+
+                        while ((i < chains.size()) && !(chains[i].value() & 1))
+                            ++i;
+
+                        chain_count = std::min<uint64_t>(i + 1, chains.size());
+                    }
+
+                    index->_symbol_offset = symbol_offset;
+                    index->_bloom_shift = bloom_shift;
+                    index->_bloom = bloom;
+                    index->_gnu_buckets = buckets;
+
+                    if (chain_count != 0)
+                        index->_gnu_chains = array_view<Word const>(&chains[0], chain_count);
+
+                    symbol_count = std::max<uint64_t>(symbol_count, symbol_offset + chain_count);
+                }
+            }
+        }
+
+        if (!index->Has_GNU_Hash() && !index->Has_SysV_Hash())
+            return;
+
+        index->_symbols = get_table_at_address<Symbol>(symbols_address, symbol_count);
+        index->_strings = _dynamic_strings;  // Found along with the dynamic table above.
+
+        if (versions_address != npos)
+            index->_versions = get_table_at_address<typename Layout::Half>(versions_address, index->_symbols.size());
+
+        _dynamic_symbol_index = std::move(index);
+    }
+
+    template class Dynamic_Symbol_Index<ELF32_LSB>;
+    template class Dynamic_Symbol_Index<ELF32_MSB>;
+    template class Dynamic_Symbol_Index<ELF64_LSB>;
+    template class Dynamic_Symbol_Index<ELF64_MSB>;
+
+    // The rest of ELF_File is instantiated in elf.cpp.
+    template void ELF_File<ELF32_LSB>::find_dynamic_symbol_index() const;
+    template void ELF_File<ELF32_MSB>::find_dynamic_symbol_index() const;
+    template void ELF_File<ELF64_LSB>::find_dynamic_symbol_index() const;
+    template void ELF_File<ELF64_MSB>::find_dynamic_symbol_index() const;
+}
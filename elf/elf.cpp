@@ -8,18 +8,255 @@
 
 using std::string_view;
 
-
 ELF* ELF::Parse(string_view buffer)
 {
-    if (buffer.length() < sizeof(ELF64::Header))
+    using namespace ELF_Format;
+
+    if (buffer.length() < sizeof(ELF_Identification))
         return nullptr;
 
-    auto const& header = Parse_As<ELF64::Header>(&buffer[0]);
-    auto const& elf_ident = Parse_As<ELF64::ELF_Identification>(header.Ident);
+    auto const& elf_ident = Parse_As<ELF_Identification>(&buffer[0]);
 
     if (Make_Magic(elf_ident.File_Identification) != "\x7f""ELF")
         return nullptr;
 
-    return new ELF64::ELF64 { buffer };
+    auto const is_big_endian = (Data_Encoding(elf_ident.Data_Encoding) == Data_Encoding::MSB);
+
+    if (!is_big_endian && (Data_Encoding(elf_ident.Data_Encoding) != Data_Encoding::LSB))
+        return nullptr;
+
+    switch (File_Class(elf_ident.File_Class))
+    {
+        case File_Class::ELF32:
+            if (buffer.length() < sizeof(Header<ELF32_LSB>))
+                return nullptr;
+
+            if (is_big_endian)
+                return new ELF_File<ELF32_MSB> { buffer };
+
+            return new ELF_File<ELF32_LSB> { buffer };
+
+        case File_Class::ELF64:
+            if (buffer.length() < sizeof(Header<ELF64_LSB>))
+                return nullptr;
+
+            if (is_big_endian)
+                return new ELF_File<ELF64_MSB> { buffer };
+
+            return new ELF_File<ELF64_LSB> { buffer };
+
+        case File_Class::None:
+        default:
+            return nullptr;
+    }
 }
 
+namespace ELF_Format
+{
+    enum : uint16_t { Section_Index_Undefined = 0, Section_Index_Extended = 0xffff };
+
+    template<typename Layout>
+    string_view ELF_File<Layout>::Get_Section_Name_Table() const
+    {
+        auto const sections = Get_Section_Header_Table();
+
+        if (sections.empty())
+            return {};
+
+        // With 0xffff sections or more the real index lives in section 0.
+        size_t index = Get_Header().Section_Header_String_Table_Index;
+
+        if (index == Section_Index_Extended)
+            index = sections[0].Link;
+
+        if ((index == Section_Index_Undefined) || (index >= sections.size()))
+            return {};
+
+        auto const& names = sections[index];
+        uint64_t const offset = names.Segment_Offset;
+        uint64_t const size = names.Size;
+        auto const buffer_size = buffer().size();
+
+        if ((offset > buffer_size) || (size > (buffer_size - offset)))
+            return {};
+
+        return buffer().substr(offset, size);
+    }
+
+    template<typename Layout>
+    string_view ELF_File<Layout>::Get_Section_Name(Section_Header_Entry const& section) const
+    {
+        auto const names = Get_Section_Name_Table();
+
+        if (section.Name >= names.size())
+            return {};
+
+        auto const name = names.substr(section.Name);
+        return name.substr(0, name.find('\0'));
+    }
+
+    template<typename Layout>
+    void ELF_File<Layout>::build_section_name_index() const
+    {
+        auto const sections = Get_Section_Header_Table();
+        auto get_name = [&](uint32_t i) { return Get_Section_Name(sections[i]); };
+
+        _section_name_index.reserve(sections.size());
+
+        for (uint32_t i = 0; i < sections.size(); ++i)
+            if (auto const name = get_name(i); !name.empty())
+                _section_name_index.Insert(i, name, get_name);
+    }
+
+    template<typename Layout>
+    typename ELF_File<Layout>::Section_Header_Entry const* ELF_File<Layout>::Find_Section(string_view name) const
+    {
+        std::call_once(_section_name_index_built, [this] { build_section_name_index(); });
+
+        auto const sections = Get_Section_Header_Table();
+        auto const i = _section_name_index.Find(name, [&](uint32_t i) { return Get_Section_Name(sections[i]); });
+
+        return (i == Name_Index::npos) ? nullptr : &sections[i];
+    }
+
+    template<typename Layout>
+    uint64_t ELF_File<Layout>::Get_File_Offset(uint64_t address) const
+    {
+        for (auto const& segment: Get_Program_Header_Table())
+        {
+            if (Segment_Type(segment.Type.value()) != Segment_Type::Load)
+                continue;
+
+            uint64_t const start = segment.Virtual_Address;
+
+            if ((address >= start) && (address - start < segment.Size_In_File))
+                return segment.Segment_Offset + (address - start);
+        }
+
+        return npos;
+    }
+
+    template<typename Layout>
+    void ELF_File<Layout>::find_dynamic_table() const
+    {
+        string_view table;
+
+        for (auto const& section: Get_Section_Header_Table())
+        {
+            if (Section_Type(section.Type.value()) != Section_Type::Dynamic_Tables)
+                continue;
+
+            auto const sections = Get_Section_Header_Table();
+
+            table = Get_Range(section.Segment_Offset, section.Size);
+
+            if (section.Link < sections.size())
+                _dynamic_strings = Get_Range(sections[section.Link].Segment_Offset, sections[section.Link].Size);
+
+            break;
+        }
+
+        if (table.empty())
+        {
+            for (auto const& segment: Get_Program_Header_Table())
+            {
+                if (Segment_Type(segment.Type.value()) == Segment_Type::Dynamic)
+                {
+                    table = Get_Range(segment.Segment_Offset, segment.Size_In_File);
+                    break;
+                }
+            }
+        }
+
+        _dynamic_table = array_view<Dynamic_Entry const>(
+            reinterpret_cast<Dynamic_Entry const*>(table.data()), table.size() / sizeof(Dynamic_Entry));
+
+        uint64_t strings_address = npos;
+        uint64_t strings_size = 0;
+
+        for (size_t i = 0; i < _dynamic_table.size(); ++i)
+        {
+            switch (Dynamic_Tag(_dynamic_table[i].Tag.value()))
+            {
+                case Dynamic_Tag::Null:
+                    _dynamic_table = array_view<Dynamic_Entry const>(&_dynamic_table[0], i);
+                    break;
+
+                case Dynamic_Tag::String_Table:
+                    strings_address = _dynamic_table[i].Value;
+                    break;
+
+                case Dynamic_Tag::String_Table_Size:
+                    strings_size = _dynamic_table[i].Value;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        // Without a section table the string table is found through its load address.
+        if (_dynamic_strings.empty() && (strings_address != npos))
+        {
+            if (auto const offset = Get_File_Offset(strings_address); offset != npos)
+                _dynamic_strings = Get_Range(offset, strings_size);
+        }
+    }
+
+    template<typename Layout>
+    string_view ELF_File<Layout>::Get_Dynamic_String(uint64_t offset) const
+    {
+        std::call_once(_dynamic_table_found, [this] { find_dynamic_table(); });
+
+        if (offset >= _dynamic_strings.size())
+            return {};
+
+        auto const text = _dynamic_strings.substr(offset);
+        return text.substr(0, text.find('\0'));
+    }
+
+    template<typename Layout>
+    std::vector<string_view> ELF_File<Layout>::Get_Needed_Libraries() const
+    {
+        std::vector<string_view> libraries;
+
+        for (auto const& entry: Get_Dynamic_Table())
+            if (Dynamic_Tag(entry.Tag.value()) == Dynamic_Tag::Needed)
+                libraries.push_back(Get_Dynamic_String(entry.Value));
+
+        return libraries;
+    }
+
+    template<typename Layout>
+    string_view ELF_File<Layout>::get_dynamic_string_entry(Dynamic_Tag tag) const
+    {
+        for (auto const& entry: Get_Dynamic_Table())
+            if (entry.Tag.value() == uint64_t(tag))
+                return Get_Dynamic_String(entry.Value);
+
+        return {};
+    }
+
+    template<typename Layout>
+    string_view ELF_File<Layout>::Get_SONAME() const
+    {
+        return get_dynamic_string_entry(Dynamic_Tag::SONAME);
+    }
+
+    template<typename Layout>
+    string_view ELF_File<Layout>::Get_RPATH() const
+    {
+        return get_dynamic_string_entry(Dynamic_Tag::RPATH);
+    }
+
+    template<typename Layout>
+    string_view ELF_File<Layout>::Get_RUNPATH() const
+    {
+        return get_dynamic_string_entry(Dynamic_Tag::RUNPATH);
+    }
+
+    template class ELF_File<ELF32_LSB>;
+    template class ELF_File<ELF32_MSB>;
+    template class ELF_File<ELF64_LSB>;
+    template class ELF_File<ELF64_MSB>;
+}
@@ -1,13 +1,23 @@
 #ifndef ELF_H__INCLUDED
 #define ELF_H__INCLUDED
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <string_view>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
+#include "include/endian.h"
 #include "include/file-format.h"
+#include "include/interval-index.h"
+#include "include/name-index.h"
 #include "include/range.h"
 
+#include <memory>
+#include <mutex>
+
 #include <iostream>
 
 using std::string;
@@ -24,36 +34,64 @@ class ELF: public Parsed_File
         virtual File_Format Get_File_Format() const = 0;
 
         virtual bool Is_ELF64() const { return false; }
+        virtual bool Is_Big_Endian() const { return false; }
 
         virtual ~ELF() {}
 };  // class ELF
 
-namespace ELF64
+namespace ELF_Format
 {
-    using Address   = uint64_t;
-    using Offset    = uint64_t;
-    using Byte      = uint8_t;
-    using Half      = uint16_t;
-    using Word      = uint32_t;
-    using Sword     = int32_t;
-    using Xword     = uint64_t;
-    using Sxword    = int64_t;
+    //
+    //  The field types of one ELF flavour.  The file class decides the width
+    //  of addresses, offsets and the class-sized words (section flags, sizes
+    //  and alignments); the data encoding decides the byte order of every
+    //  multi-byte field.  The structures below are laid straight over the
+    //  file and convert on load, so nothing is copied or swapped up front.
+    //
+    template<bool Is_64_Bit, std::endian Order>
+    struct Layout
+    {
+        static constexpr bool Is_64 = Is_64_Bit;
+        static constexpr bool Is_Big_Endian = (Order == std::endian::big);
+
+        using Natural   = std::conditional_t<Is_64_Bit, uint64_t, uint32_t>;
+
+        using Byte      = uint8_t;
+        using Half      = Endian_Value<uint16_t, Order>;
+        using Word      = Endian_Value<uint32_t, Order>;
+        using Sword     = Endian_Value<int32_t, Order>;
+        using Xword     = Endian_Value<uint64_t, Order>;
+        using Sxword    = Endian_Value<int64_t, Order>;
+        using Address   = Endian_Value<Natural, Order>;
+        using Offset    = Endian_Value<Natural, Order>;
+        using Class_Word = Endian_Value<Natural, Order>;
+    };
 
+    using ELF32_LSB = Layout<false, std::endian::little>;
+    using ELF32_MSB = Layout<false, std::endian::big>;
+    using ELF64_LSB = Layout<true, std::endian::little>;
+    using ELF64_MSB = Layout<true, std::endian::big>;
+
+    template<typename Layout>
     struct __attribute__((packed)) Header
     {
+        using Half = typename Layout::Half;
+        using Word = typename Layout::Word;
+
         uint8_t Ident[16];
         Half    Type;
         Half    Machine;
         Word    Version;
-        Address Entry_Point;
-        Offset  Program_Header_Offset;
-        Offset  Section_Header_Offset;
+        typename Layout::Address Entry_Point;
+        typename Layout::Offset  Program_Header_Offset;
+        typename Layout::Offset  Section_Header_Offset;
         Word    Flags;
         Half    ELF_Header_Size;
         Half    Program_Header_Entry_Size;
         Half    Program_Header_Entry_Count;
         Half    Section_Header_Entry_Size;
         Half    Section_Header_Entry_Count;
+        Half    Section_Header_String_Table_Index;
     };
 
     struct __attribute__((packed)) ELF_Identification
@@ -68,6 +106,20 @@ namespace ELF64
         uint8_t Padding[];
     };
 
+    enum class File_Class: uint8_t
+    {
+        None            = 0,
+        ELF32           = 1,
+        ELF64           = 2
+    };
+
+    enum class Data_Encoding: uint8_t
+    {
+        None            = 0,
+        LSB             = 1,
+        MSB             = 2
+    };
+
     enum class File_Type
     {
         None            =      0,
@@ -104,7 +156,7 @@ namespace ELF64
 
     inline string_view Get_File_Type_Name(uint32_t value)
     {
-        static std::map<File_Type, string> enum_map = {
+        static constexpr auto enum_map = Make_Enum_Name_Table<File_Type>({
             { File_Type::None,           "None"          },
             { File_Type::Relocatable,    "Relocatable"   },
             { File_Type::Executable,     "Executable"    },
@@ -114,21 +166,42 @@ namespace ELF64
             { File_Type::HI_OS,          "HI_OS"         },
             { File_Type::LO_Processor,   "LO_Processor"  },
             { File_Type::HI_Processor,   "HI_Processor"  }
-        };
+        });
 
         return enum_map[File_Type(value)];
     }
 
-    struct __attribute__((packed)) Program_Header_Entry
+    //
+    //  The 32-bit program header keeps Flags next to Alignment; the 64-bit
+    //  one moves it up beside Type so that the wide fields stay aligned.
+    //
+    template<typename Layout, bool Is_64 = Layout::Is_64>
+    struct Program_Header_Entry;
+
+    template<typename Layout>
+    struct __attribute__((packed)) Program_Header_Entry<Layout, false>
     {
-        Word Type;
-        Word Flags;
-        Offset Segment_Offset;
-        Address Virtual_Address;
-        Address Physical_Address;
-        Xword Size_In_File;
-        Xword Size_In_Memory;
-        Xword Alignment;
+        typename Layout::Word Type;
+        typename Layout::Offset Segment_Offset;
+        typename Layout::Address Virtual_Address;
+        typename Layout::Address Physical_Address;
+        typename Layout::Word Size_In_File;
+        typename Layout::Word Size_In_Memory;
+        typename Layout::Word Flags;
+        typename Layout::Word Alignment;
+    };
+
+    template<typename Layout>
+    struct __attribute__((packed)) Program_Header_Entry<Layout, true>
+    {
+        typename Layout::Word Type;
+        typename Layout::Word Flags;
+        typename Layout::Offset Segment_Offset;
+        typename Layout::Address Virtual_Address;
+        typename Layout::Address Physical_Address;
+        typename Layout::Xword Size_In_File;
+        typename Layout::Xword Size_In_Memory;
+        typename Layout::Xword Alignment;
     };
 
     enum class Segment_Type
@@ -148,7 +221,7 @@ namespace ELF64
 
     inline string_view Get_Segment_Type_Name(uint32_t value)
     {
-        static std::map<Segment_Type, string> enum_map = {
+        static constexpr auto enum_map = Make_Enum_Name_Table<Segment_Type>({
             { Segment_Type::Null,           "Null"           },
             { Segment_Type::Load,           "Load"           },
             { Segment_Type::Dynamic,        "Dynamic"        },
@@ -160,7 +233,7 @@ namespace ELF64
             { Segment_Type::HI_OS,          "HI_OS"          },
             { Segment_Type::LO_Processor,   "LO_Processor"   },
             { Segment_Type::HI_Processor,   "HI_Processor"   }
-        };
+        });
 
         return enum_map[Segment_Type(value)];
     }
@@ -186,18 +259,22 @@ namespace ELF64
         return result;
     }
 
+    template<typename Layout>
     struct __attribute__((packed)) Section_Header_Entry
     {
+        using Word = typename Layout::Word;
+        using Class_Word = typename Layout::Class_Word;
+
         Word Name;
         Word Type;
-        Xword Flags;
-        Address Virtual_Address;
-        Offset Segment_Offset;
-        Xword Size;
+        Class_Word Flags;
+        typename Layout::Address Virtual_Address;
+        typename Layout::Offset Segment_Offset;
+        Class_Word Size;
         Word Link;
         Word Info;
-        Xword Address_Alignment;
-        Xword Entry_Size;
+        Class_Word Address_Alignment;
+        Class_Word Entry_Size;
     };
 
     enum class Section_Type
@@ -213,6 +290,7 @@ namespace ELF64
         No_Bits             =          8,
         Rel_Relocatable     =          9,
         Reserved            =         10,
+        Dynamic_Symbol_Table =        11,
         LO_OS               = 0x60000000,
         HI_OS               = 0x6fffffff,
         LO_Processor        = 0x70000000,
@@ -221,7 +299,7 @@ namespace ELF64
 
     inline string_view Get_Section_Type_Name(uint32_t value)
     {
-        static std::map<Section_Type, string> enum_map = {
+        static constexpr auto enum_map = Make_Enum_Name_Table<Section_Type>({
             { Section_Type::Null, "Null" },
             { Section_Type::Program_Bits, "Program_Bits" },
             { Section_Type::Symbol_Table, "Symbol_Table" },
@@ -233,11 +311,12 @@ namespace ELF64
             { Section_Type::No_Bits, "No_Bits" },
             { Section_Type::Rel_Relocatable, "Rel_Relocatable" },
             { Section_Type::Reserved, "Reserved" },
+            { Section_Type::Dynamic_Symbol_Table, "Dynamic_Symbol_Table" },
             { Section_Type::LO_OS, "LO_OS" },
             { Section_Type::HI_OS, "HI_OS" },
             { Section_Type::LO_Processor, "LO_Processor" },
             { Section_Type::HI_Processor, "HI_Processor" }
-        };
+        });
 
         return enum_map[Section_Type(value)];
     }
@@ -246,7 +325,7 @@ namespace ELF64
     {
         W           =          1,
         A           =          2,
-        X           =          3,
+        X           =          4,
         Mask_OS     = 0x0f000000,
         Mask_Proc   = 0xf0000000
     };
@@ -262,10 +341,419 @@ namespace ELF64
         return result;
     }
 
-    class ELF64: public ELF
+    template<typename Layout, bool Is_64 = Layout::Is_64>
+    struct Symbol;
+
+    template<typename Layout>
+    struct __attribute__((packed)) Symbol<Layout, false>
+    {
+        typename Layout::Word Name;
+        typename Layout::Address Value;
+        typename Layout::Word Size;
+        typename Layout::Byte Info;
+        typename Layout::Byte Other;
+        typename Layout::Half Section_Index;
+    };
+
+    template<typename Layout>
+    struct __attribute__((packed)) Symbol<Layout, true>
+    {
+        typename Layout::Word Name;
+        typename Layout::Byte Info;
+        typename Layout::Byte Other;
+        typename Layout::Half Section_Index;
+        typename Layout::Address Value;
+        typename Layout::Xword Size;
+    };
+
+    enum class Symbol_Binding
+    {
+        Local           =  0,
+        Global          =  1,
+        Weak            =  2,
+        LO_OS           = 10,
+        GNU_Unique      = 10,   // STB_GNU_UNIQUE: global, and one definition per process.
+        HI_OS           = 12,
+        LO_Processor    = 13,
+        HI_Processor    = 15
+    };
+
+    template<typename Symbol_Entry>
+    Symbol_Binding Get_Symbol_Binding(Symbol_Entry const& symbol)
+    { return Symbol_Binding(symbol.Info >> 4); }
+
+    inline string_view Get_Symbol_Binding_Name(Symbol_Binding value)
+    {
+        static constexpr auto enum_map = Make_Enum_Name_Table<Symbol_Binding>({
+            { Symbol_Binding::Local,        "Local"         },
+            { Symbol_Binding::Global,       "Global"        },
+            { Symbol_Binding::Weak,         "Weak"          },
+            { Symbol_Binding::LO_OS,        "LO_OS"         },
+            { Symbol_Binding::HI_OS,        "HI_OS"         },
+            { Symbol_Binding::LO_Processor, "LO_Processor"  },
+            { Symbol_Binding::HI_Processor, "HI_Processor"  }
+        });
+
+        return enum_map[value];
+    }
+
+    enum class Symbol_Type
+    {
+        No_Type         =  0,
+        Object          =  1,
+        Function        =  2,
+        Section         =  3,
+        File            =  4,
+        Common          =  5,
+        TLS             =  6,
+        LO_OS           = 10,
+        HI_OS           = 12,
+        LO_Processor    = 13,
+        HI_Processor    = 15
+    };
+
+    template<typename Symbol_Entry>
+    Symbol_Type Get_Symbol_Type(Symbol_Entry const& symbol)
+    { return Symbol_Type(symbol.Info & 0xf); }
+
+    inline string_view Get_Symbol_Type_Name(Symbol_Type value)
+    {
+        static constexpr auto enum_map = Make_Enum_Name_Table<Symbol_Type>({
+            { Symbol_Type::No_Type,         "No_Type"       },
+            { Symbol_Type::Object,          "Object"        },
+            { Symbol_Type::Function,        "Function"      },
+            { Symbol_Type::Section,         "Section"       },
+            { Symbol_Type::File,            "File"          },
+            { Symbol_Type::Common,          "Common"        },
+            { Symbol_Type::TLS,             "TLS"           },
+            { Symbol_Type::LO_OS,           "LO_OS"         },
+            { Symbol_Type::HI_OS,           "HI_OS"         },
+            { Symbol_Type::LO_Processor,    "LO_Processor"  },
+            { Symbol_Type::HI_Processor,    "HI_Processor"  }
+        });
+
+        return enum_map[value];
+    }
+
+    enum class Special_Section_Index: uint16_t
+    {
+        Undefined       =      0,
+        LO_Reserve      = 0xff00,
+        Absolute        = 0xfff1,
+        Common          = 0xfff2,
+        Extended_Index  = 0xffff
+    };
+
+    template<typename Layout>
+    struct __attribute__((packed)) Dynamic_Entry
+    {
+        // Signed in the specification, but every tag and value read here is non-negative.
+        typename Layout::Class_Word Tag;
+        typename Layout::Class_Word Value;
+    };
+
+    enum class Dynamic_Tag
+    {
+        Null                        =  0,
+        Needed                      =  1,
+        PLT_Relocation_Size         =  2,
+        PLT_GOT                     =  3,
+        Hash                        =  4,
+        String_Table                =  5,
+        Symbol_Table                =  6,
+        Rela                        =  7,
+        Rela_Size                   =  8,
+        Rela_Entry_Size             =  9,
+        String_Table_Size           = 10,
+        Symbol_Entry_Size           = 11,
+        Init                        = 12,
+        Fini                        = 13,
+        SONAME                      = 14,
+        RPATH                       = 15,
+        Symbolic                    = 16,
+        Rel                         = 17,
+        Rel_Size                    = 18,
+        Rel_Entry_Size              = 19,
+        PLT_Relocation_Type         = 20,
+        Debug                       = 21,
+        Text_Relocations            = 22,
+        Jump_Relocations            = 23,
+        Bind_Now                    = 24,
+        Init_Array                  = 25,
+        Fini_Array                  = 26,
+        Init_Array_Size             = 27,
+        Fini_Array_Size             = 28,
+        RUNPATH                     = 29,
+        Flags                       = 30,
+        Preinit_Array               = 32,
+        Preinit_Array_Size          = 33,
+        Symbol_Table_Section_Index  = 34,
+        RELR_Size                   = 35,
+        RELR                        = 36,
+        RELR_Entry_Size             = 37,
+        GNU_Hash                    = 0x6ffffef5,
+        Version_Symbol              = 0x6ffffff0,
+        Rela_Count                  = 0x6ffffff9,
+        Rel_Count                   = 0x6ffffffa,
+        Flags_1                     = 0x6ffffffb,
+        Version_Definition          = 0x6ffffffc,
+        Version_Definition_Count    = 0x6ffffffd,
+        Version_Needed              = 0x6ffffffe,
+        Version_Needed_Count        = 0x6fffffff
+    };
+
+    inline string_view Get_Dynamic_Tag_Name(uint64_t value)
+    {
+        static constexpr auto enum_map = Make_Enum_Name_Table<Dynamic_Tag>({
+            { Dynamic_Tag::Null,                        "Null"                          },
+            { Dynamic_Tag::Needed,                      "Needed"                        },
+            { Dynamic_Tag::PLT_Relocation_Size,         "PLT_Relocation_Size"           },
+            { Dynamic_Tag::PLT_GOT,                     "PLT_GOT"                       },
+            { Dynamic_Tag::Hash,                        "Hash"                          },
+            { Dynamic_Tag::String_Table,                "String_Table"                  },
+            { Dynamic_Tag::Symbol_Table,                "Symbol_Table"                  },
+            { Dynamic_Tag::Rela,                        "Rela"                          },
+            { Dynamic_Tag::Rela_Size,                   "Rela_Size"                     },
+            { Dynamic_Tag::Rela_Entry_Size,             "Rela_Entry_Size"               },
+            { Dynamic_Tag::String_Table_Size,           "String_Table_Size"             },
+            { Dynamic_Tag::Symbol_Entry_Size,           "Symbol_Entry_Size"             },
+            { Dynamic_Tag::Init,                        "Init"                          },
+            { Dynamic_Tag::Fini,                        "Fini"                          },
+            { Dynamic_Tag::SONAME,                      "SONAME"                        },
+            { Dynamic_Tag::RPATH,                       "RPATH"                         },
+            { Dynamic_Tag::Symbolic,                    "Symbolic"                      },
+            { Dynamic_Tag::Rel,                         "Rel"                           },
+            { Dynamic_Tag::Rel_Size,                    "Rel_Size"                      },
+            { Dynamic_Tag::Rel_Entry_Size,              "Rel_Entry_Size"                },
+            { Dynamic_Tag::PLT_Relocation_Type,         "PLT_Relocation_Type"           },
+            { Dynamic_Tag::Debug,                       "Debug"                         },
+            { Dynamic_Tag::Text_Relocations,            "Text_Relocations"              },
+            { Dynamic_Tag::Jump_Relocations,            "Jump_Relocations"              },
+            { Dynamic_Tag::Bind_Now,                    "Bind_Now"                      },
+            { Dynamic_Tag::Init_Array,                  "Init_Array"                    },
+            { Dynamic_Tag::Fini_Array,                  "Fini_Array"                    },
+            { Dynamic_Tag::Init_Array_Size,             "Init_Array_Size"               },
+            { Dynamic_Tag::Fini_Array_Size,             "Fini_Array_Size"               },
+            { Dynamic_Tag::RUNPATH,                     "RUNPATH"                       },
+            { Dynamic_Tag::Flags,                       "Flags"                         },
+            { Dynamic_Tag::Preinit_Array,               "Preinit_Array"                 },
+            { Dynamic_Tag::Preinit_Array_Size,          "Preinit_Array_Size"            },
+            { Dynamic_Tag::Symbol_Table_Section_Index,  "Symbol_Table_Section_Index"    },
+            { Dynamic_Tag::RELR_Size,                   "RELR_Size"                     },
+            { Dynamic_Tag::RELR,                        "RELR"                          },
+            { Dynamic_Tag::RELR_Entry_Size,             "RELR_Entry_Size"               },
+            { Dynamic_Tag::GNU_Hash,                    "GNU_Hash"                      },
+            { Dynamic_Tag::Version_Symbol,              "Version_Symbol"                },
+            { Dynamic_Tag::Rela_Count,                  "Rela_Count"                    },
+            { Dynamic_Tag::Rel_Count,                   "Rel_Count"                     },
+            { Dynamic_Tag::Flags_1,                     "Flags_1"                       },
+            { Dynamic_Tag::Version_Definition,          "Version_Definition"            },
+            { Dynamic_Tag::Version_Definition_Count,    "Version_Definition_Count"      },
+            { Dynamic_Tag::Version_Needed,              "Version_Needed"                },
+            { Dynamic_Tag::Version_Needed_Count,        "Version_Needed_Count"          }
+        });
+
+        // Processor-specific tags (from 0x70000000) and anything wider than the enum are unnamed.
+        if (value > 0x6fffffff)
+            return {};
+
+        return enum_map[Dynamic_Tag(value)];
+    }
+
+    // Tags whose value is an offset into the dynamic string table.
+    inline bool Is_Dynamic_String_Tag(uint64_t value)
     {
+        switch (Dynamic_Tag(value))
+        {
+            case Dynamic_Tag::Needed:
+            case Dynamic_Tag::SONAME:
+            case Dynamic_Tag::RPATH:
+            case Dynamic_Tag::RUNPATH:
+                return value <= 0x6fffffff;
+
+            default:
+                return false;
+        }
+    }
+
+    template<typename Layout>
+    class ELF_File;
+
+    //
+    //  The dynamic symbols as the dynamic linker sees them: the symbol table
+    //  found through DT_SYMTAB, sized and searched through the file's own
+    //  DT_GNU_HASH or DT_HASH table, so it works on files stripped of their
+    //  section table as well as of .symtab.  A lookup hashes the name once
+    //  and compares only the names in one bucket; with DT_GNU_HASH, the
+    //  bloom filter turns most misses away before any bucket is read.
+    //
+    template<typename Layout>
+    class Dynamic_Symbol_Index
+    {
+        public:
+            using Symbol = ELF_Format::Symbol<Layout>;
+            using Word = typename Layout::Word;
+            using Class_Word = typename Layout::Class_Word;
+            using Half = typename Layout::Half;
+
         private:
-        protected:
+            array_view<Symbol const> _symbols { static_cast<Symbol const*>(nullptr), size_t(0) };
+            string_view _strings;
+
+            //
+            //  DT_VERSYM: one version index per symbol, empty when the file
+            //  has no symbol versions.  A set high bit marks a hidden (@)
+            //  version, which only a reference naming that version binds to.
+            //
+            static constexpr uint16_t Hidden_Version = 0x8000;
+            array_view<Half const> _versions { static_cast<Half const*>(nullptr), size_t(0) };
+
+            //
+            //  DT_GNU_HASH: only symbols from _symbol_offset on are hashed,
+            //  sorted by bucket; the low bit of a chain value ends the chain.
+            //
+            uint32_t _symbol_offset = 0;
+            uint32_t _bloom_shift = 0;
+            array_view<Class_Word const> _bloom { static_cast<Class_Word const*>(nullptr), size_t(0) };
+            array_view<Word const> _gnu_buckets { static_cast<Word const*>(nullptr), size_t(0) };
+            array_view<Word const> _gnu_chains { static_cast<Word const*>(nullptr), size_t(0) };
+
+            // DT_HASH: chains are indexed by symbol and end at index 0.
+            array_view<Word const> _buckets { static_cast<Word const*>(nullptr), size_t(0) };
+            array_view<Word const> _chains { static_cast<Word const*>(nullptr), size_t(0) };
+
+            Dynamic_Symbol_Index() {}
+
+            bool is_hidden(size_t i) const { return (i < _versions.size()) && (_versions[i].value() & Hidden_Version); }
+
+            Symbol const* find_gnu(string_view name) const;
+            Symbol const* find_sysv(string_view name) const;
+
+            friend class ELF_File<Layout>;
+
+        public:
+            static uint32_t GNU_Hash(string_view name);
+            static uint32_t SysV_Hash(string_view name);
+
+            size_t size() const { return _symbols.size(); }
+
+            auto begin() const { return _symbols.begin(); }
+            auto end() const { return _symbols.end(); }
+
+            Symbol const& operator[](size_t i) const { return _symbols[i]; }
+
+            string_view Get_Name(Symbol const& symbol) const;
+
+            bool Has_GNU_Hash() const { return !_gnu_buckets.empty(); }
+            bool Has_SysV_Hash() const { return !_buckets.empty(); }
+
+            size_t Get_GNU_Bucket_Count() const { return _gnu_buckets.size(); }
+            size_t Get_SysV_Bucket_Count() const { return _buckets.size(); }
+
+            //
+            //  The defined symbol with the name, through DT_GNU_HASH when the
+            //  file has it and DT_HASH otherwise; nullptr when it is not
+            //  exported.  As for an unversioned reference, the default (@@)
+            //  version wins over hidden ones, which are only returned when
+            //  the name has nothing else.
+            //
+            Symbol const* Find(string_view name) const;
+    };
+
+    //
+    //  A view over a .symtab or .dynsym section and the string table it links
+    //  to.  Symbols and names are never copied.  The name hash index and the
+    //  address index are each built on the first query that needs them and
+    //  reused afterwards; building is safe to race from several threads.
+    //
+    template<typename Layout>
+    class Symbol_Table
+    {
+        public:
+            using Symbol = ELF_Format::Symbol<Layout>;
+
+        private:
+            array_view<Symbol const> _symbols;
+            string_view _strings;
+
+            mutable std::once_flag _name_index_built;
+            mutable Name_Index _name_index;
+
+            mutable std::once_flag _address_index_built;
+            mutable Interval_Index<uint64_t, uint32_t> _address_index;
+
+            void build_name_index() const;
+            void build_address_index() const;
+
+        public:
+            Symbol_Table(array_view<Symbol const> symbols, string_view strings):
+                _symbols{symbols},
+                _strings{strings}
+            {}
+
+            size_t size() const { return _symbols.size(); }
+
+            auto begin() const { return _symbols.begin(); }
+            auto end() const { return _symbols.end(); }
+
+            Symbol const& operator[](size_t i) const { return _symbols[i]; }
+
+            string_view Get_Name(Symbol const& symbol) const;
+
+            // Prefers a defined global or weak symbol over local and undefined ones.
+            Symbol const* Find(string_view name) const;
+
+            //
+            //  The defined function or object symbol whose [Value, Value + Size)
+            //  range holds the address (a sizeless symbol only matches its own
+            //  address), or nullptr.
+            //
+            Symbol const* Find_By_Address(uint64_t address) const;
+    };
+
+    template<typename Layout>
+    class ELF_File: public ELF
+    {
+        public:
+            using Header = ELF_Format::Header<Layout>;
+            using Program_Header_Entry = ELF_Format::Program_Header_Entry<Layout>;
+            using Section_Header_Entry = ELF_Format::Section_Header_Entry<Layout>;
+            using Symbol = ELF_Format::Symbol<Layout>;
+            using Symbol_Table = ELF_Format::Symbol_Table<Layout>;
+            using Dynamic_Entry = ELF_Format::Dynamic_Entry<Layout>;
+            using Dynamic_Symbol_Index = ELF_Format::Dynamic_Symbol_Index<Layout>;
+
+        private:
+            mutable std::once_flag _section_name_index_built;
+            mutable Name_Index _section_name_index;
+
+            mutable std::once_flag _symbol_tables_found;
+            mutable std::unique_ptr<Symbol_Table> _symbol_table;
+            mutable std::unique_ptr<Symbol_Table> _dynamic_symbol_table;
+
+            //
+            //  The dynamic section and its string table, from the section
+            //  table or, in files stripped of it, from the Dynamic segment.
+            //
+            mutable std::once_flag _dynamic_table_found;
+            mutable array_view<Dynamic_Entry const> _dynamic_table { static_cast<Dynamic_Entry const*>(nullptr), size_t(0) };
+            mutable string_view _dynamic_strings;
+
+            mutable std::once_flag _dynamic_symbol_index_found;
+            mutable std::unique_ptr<Dynamic_Symbol_Index> _dynamic_symbol_index;
+
+            void build_section_name_index() const;
+            void find_dynamic_table() const;
+            void find_dynamic_symbol_index() const;
+
+            // The string of the first entry with the tag; empty when there is none.
+            string_view get_dynamic_string_entry(Dynamic_Tag tag) const;
+
+            // Up to count entries at a virtual address: the part of the table that lies inside the file.
+            template<typename Entry>
+            array_view<Entry const> get_table_at_address(uint64_t address, uint64_t count) const;
+            void find_symbol_tables() const;
+            std::unique_ptr<Symbol_Table> make_symbol_table(Section_Header_Entry const& section) const;
 
         public:
             using ELF::ELF;
@@ -274,10 +762,17 @@ namespace ELF64
             {
                 switch (Get_File_Type())
                 {
-                    case File_Type::Relocatable:    return File_Format::ELF64_Object;
-                    case File_Type::Executable:     return File_Format::ELF64_Executable;
-                    case File_Type::Dynamic:        return File_Format::ELF64_Shared_Object;
-                    case File_Type::Core:           return File_Format::ELF64_Core_Dump;
+                    case File_Type::Relocatable:
+                        return Layout::Is_64 ? File_Format::ELF64_Object : File_Format::ELF_Object;
+
+                    case File_Type::Executable:
+                        return Layout::Is_64 ? File_Format::ELF64_Executable : File_Format::ELF_Executable;
+
+                    case File_Type::Dynamic:
+                        return Layout::Is_64 ? File_Format::ELF64_Shared_Object : File_Format::ELF_Shared_Object;
+
+                    case File_Type::Core:
+                        return Layout::Is_64 ? File_Format::ELF64_Core_Dump : File_Format::ELF_Core_Dump;
 
                     case File_Type::None:
                     default:
@@ -285,13 +780,14 @@ namespace ELF64
                 }
             }
 
-            bool Is_ELF64() const override { return true; }
+            bool Is_ELF64() const override { return Layout::Is_64; }
+            bool Is_Big_Endian() const override { return Layout::Is_Big_Endian; }
 
             auto const& Get_Header() const
             { return get_header<Header>(); }
 
             File_Type Get_File_Type() const 
-            { return File_Type(Get_Header().Type); }
+            { return File_Type(Get_Header().Type.value()); }
 
             array_view<Program_Header_Entry const> Get_Program_Header_Table() const
             {
@@ -301,17 +797,119 @@ namespace ELF64
                             Get_Header().Program_Header_Entry_Count);
             }
 
+            //
+            //  With 0xff00 sections or more, e_shnum is 0 and the real count
+            //  lives in the Size of section 0.  The table is cut to the part
+            //  that lies inside the file.
+            //
             array_view<Section_Header_Entry const> Get_Section_Header_Table() const
             {
-                return
-                    get_table<Section_Header_Entry>(
-                            Get_Header().Section_Header_Offset,
-                            Get_Header().Section_Header_Entry_Count);
+                uint64_t const offset = Get_Header().Section_Header_Offset;
+                uint64_t count = Get_Header().Section_Header_Entry_Count;
+
+                if (offset == 0)
+                    return { static_cast<Section_Header_Entry const*>(nullptr), size_t(0) };
+
+                if ((count == 0) && (Get_Range(offset, sizeof(Section_Header_Entry)).size() == sizeof(Section_Header_Entry)))
+                    count = get_field<Section_Header_Entry>(offset).Size;
+
+                auto const range = Get_Range(offset, std::min<uint64_t>(count, buffer().size()) * sizeof(Section_Header_Entry));
+
+                return array_view<Section_Header_Entry const>(
+                    reinterpret_cast<Section_Header_Entry const*>(range.data()), range.size() / sizeof(Section_Header_Entry));
+            }
+
+            // The contents of .shstrtab, or an empty view if there is none.
+            string_view Get_Section_Name_Table() const;
+
+            // A view into .shstrtab; empty if the name cannot be resolved.
+            string_view Get_Section_Name(Section_Header_Entry const& section) const;
+
+            // The first section with the given name, found through a hash index.
+            Section_Header_Entry const* Find_Section(string_view name) const;
+
+            // .symtab, or nullptr when the file has been stripped.
+            Symbol_Table const* Get_Symbol_Table() const
+            {
+                std::call_once(_symbol_tables_found, [this] { find_symbol_tables(); });
+                return _symbol_table.get();
+            }
+
+            // .dynsym, or nullptr for static executables and most objects.
+            Symbol_Table const* Get_Dynamic_Symbol_Table() const
+            {
+                std::call_once(_symbol_tables_found, [this] { find_symbol_tables(); });
+                return _dynamic_symbol_table.get();
             }
 
-            ~ELF64() override {}
-    };  // class ELF64
+            // The file offset of a virtual address inside a loadable segment, or npos.
+            static constexpr uint64_t npos = ~uint64_t(0);
+            uint64_t Get_File_Offset(uint64_t address) const;
+
+            // The dynamic section up to its Null entry; empty for static files.
+            array_view<Dynamic_Entry const> Get_Dynamic_Table() const
+            {
+                std::call_once(_dynamic_table_found, [this] { find_dynamic_table(); });
+                return _dynamic_table;
+            }
+
+            // A string of the dynamic string table; empty if the offset lies outside it.
+            string_view Get_Dynamic_String(uint64_t offset) const;
+
+            // The Needed entries, in order, and the SONAME (empty when there is none).
+            std::vector<string_view> Get_Needed_Libraries() const;
+            string_view Get_SONAME() const;
+
+            // Colon-separated search paths; empty when there are none.  RUNPATH makes the loader ignore RPATH.
+            string_view Get_RPATH() const;
+            string_view Get_RUNPATH() const;
+
+            // nullptr for static files and for dynamic ones with neither DT_GNU_HASH nor DT_HASH.
+            Dynamic_Symbol_Index const* Get_Dynamic_Symbol_Index() const
+            {
+                std::call_once(_dynamic_symbol_index_found, [this] { find_dynamic_symbol_index(); });
+                return _dynamic_symbol_index.get();
+            }
+
+            ~ELF_File() override {}
+    };  // class ELF_File
+
+    // The member bodies live in elf.cpp, symbol-table.cpp and dynamic.cpp.
+    extern template class Symbol_Table<ELF32_LSB>;
+    extern template class Symbol_Table<ELF32_MSB>;
+    extern template class Symbol_Table<ELF64_LSB>;
+    extern template class Symbol_Table<ELF64_MSB>;
+
+    extern template class Dynamic_Symbol_Index<ELF32_LSB>;
+    extern template class Dynamic_Symbol_Index<ELF32_MSB>;
+    extern template class Dynamic_Symbol_Index<ELF64_LSB>;
+    extern template class Dynamic_Symbol_Index<ELF64_MSB>;
+
+    extern template class ELF_File<ELF32_LSB>;
+    extern template class ELF_File<ELF32_MSB>;
+    extern template class ELF_File<ELF64_LSB>;
+    extern template class ELF_File<ELF64_MSB>;
+
+    //
+    //  Calls visitor with elf cast to the ELF_File matching its class and
+    //  byte order, so callers can be written once as a generic lambda.
+    //
+    template<typename Visitor>
+    decltype(auto) Visit(ELF const& elf, Visitor&& visitor)
+    {
+        if (elf.Is_ELF64())
+        {
+            if (elf.Is_Big_Endian())
+                return visitor(static_cast<ELF_File<ELF64_MSB> const&>(elf));
+
+            return visitor(static_cast<ELF_File<ELF64_LSB> const&>(elf));
+        }
+
+        if (elf.Is_Big_Endian())
+            return visitor(static_cast<ELF_File<ELF32_MSB> const&>(elf));
+
+        return visitor(static_cast<ELF_File<ELF32_LSB> const&>(elf));
+    }
 }
 
 #endif  // ELF_H__INCLUDED
-
@@ -0,0 +1,160 @@
+#include "elf.h"
+
+#include <memory>
+#include <string_view>
+
+using std::string_view;
+
+namespace ELF_Format
+{
+    template<typename Symbol_Entry>
+    static bool Is_Defined(Symbol_Entry const& symbol)
+    {
+        uint16_t const section_index = symbol.Section_Index;
+
+        return
+            (section_index != uint16_t(Special_Section_Index::Undefined)) &&
+            (section_index < uint16_t(Special_Section_Index::LO_Reserve));
+    }
+
+    template<typename Layout>
+    string_view Symbol_Table<Layout>::Get_Name(Symbol const& symbol) const
+    {
+        if (symbol.Name >= _strings.size())
+            return {};
+
+        auto const name = _strings.substr(symbol.Name);
+        return name.substr(0, name.find('\0'));
+    }
+
+    template<typename Layout>
+    void Symbol_Table<Layout>::build_name_index() const
+    {
+        auto get_name = [this](uint32_t i) { return Get_Name(_symbols[i]); };
+
+        _name_index.reserve(_symbols.size());
+
+        //
+        //  Defined global and weak symbols go in first so that they win over
+        //  locals and undefined references that share their name.
+        //
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (uint32_t i = 1; i < _symbols.size(); ++i)
+            {
+                auto const& symbol = _symbols[i];
+                bool const preferred = Is_Defined(symbol) && (Get_Symbol_Binding(symbol) != Symbol_Binding::Local);
+
+                if (preferred != (pass == 0))
+                    continue;
+
+                if (auto const name = Get_Name(symbol); !name.empty())
+                    _name_index.Insert(i, name, get_name);
+            }
+        }
+    }
+
+    template<typename Layout>
+    void Symbol_Table<Layout>::build_address_index() const
+    {
+        _address_index.reserve(_symbols.size());
+
+        for (uint32_t i = 1; i < _symbols.size(); ++i)
+        {
+            auto const& symbol = _symbols[i];
+            auto const type = Get_Symbol_Type(symbol);
+
+            if (!Is_Defined(symbol) || ((type != Symbol_Type::Function) && (type != Symbol_Type::Object)))
+                continue;
+
+            uint64_t const value = symbol.Value;
+            uint64_t const size = symbol.Size ? uint64_t(symbol.Size) : 1;
+            _address_index.Add(value, value + size, i);
+        }
+
+        _address_index.Build();
+    }
+
+    template<typename Layout>
+    typename Symbol_Table<Layout>::Symbol const* Symbol_Table<Layout>::Find(string_view name) const
+    {
+        std::call_once(_name_index_built, [this] { build_name_index(); });
+
+        auto const i = _name_index.Find(name, [this](uint32_t i) { return Get_Name(_symbols[i]); });
+
+        return (i == Name_Index::npos) ? nullptr : &_symbols[i];
+    }
+
+    template<typename Layout>
+    typename Symbol_Table<Layout>::Symbol const* Symbol_Table<Layout>::Find_By_Address(uint64_t address) const
+    {
+        std::call_once(_address_index_built, [this] { build_address_index(); });
+
+        auto const* interval = _address_index.Find(address);
+
+        return interval ? &_symbols[interval->Value] : nullptr;
+    }
+
+    template<typename Layout>
+    std::unique_ptr<Symbol_Table<Layout>> ELF_File<Layout>::make_symbol_table(Section_Header_Entry const& section) const
+    {
+        auto const sections = Get_Section_Header_Table();
+        auto const buffer_size = buffer().size();
+
+        uint64_t const offset = section.Segment_Offset;
+        uint64_t const size = section.Size;
+
+        if ((section.Link >= sections.size()) || (offset > buffer_size) || (size > (buffer_size - offset)))
+            return nullptr;
+
+        auto const& string_section = sections[section.Link];
+        uint64_t const strings_offset = string_section.Segment_Offset;
+        uint64_t const strings_size = string_section.Size;
+
+        if ((strings_offset > buffer_size) || (strings_size > (buffer_size - strings_offset)))
+            return nullptr;
+
+        return std::make_unique<Symbol_Table>(
+            get_table<Symbol>(offset, size / sizeof(Symbol)),
+            buffer().substr(strings_offset, strings_size));
+    }
+
+    template<typename Layout>
+    void ELF_File<Layout>::find_symbol_tables() const
+    {
+        for (auto const& section: Get_Section_Header_Table())
+        {
+            switch (Section_Type(section.Type.value()))
+            {
+                case Section_Type::Symbol_Table:
+                    if (!_symbol_table)
+                        _symbol_table = make_symbol_table(section);
+                    break;
+
+                case Section_Type::Dynamic_Symbol_Table:
+                    if (!_dynamic_symbol_table)
+                        _dynamic_symbol_table = make_symbol_table(section);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    template class Symbol_Table<ELF32_LSB>;
+    template class Symbol_Table<ELF32_MSB>;
+    template class Symbol_Table<ELF64_LSB>;
+    template class Symbol_Table<ELF64_MSB>;
+
+    // The rest of ELF_File is instantiated in elf.cpp.
+    template void ELF_File<ELF32_LSB>::find_symbol_tables() const;
+    template void ELF_File<ELF32_MSB>::find_symbol_tables() const;
+    template void ELF_File<ELF64_LSB>::find_symbol_tables() const;
+    template void ELF_File<ELF64_MSB>::find_symbol_tables() const;
+
+    template auto ELF_File<ELF32_LSB>::make_symbol_table(Section_Header_Entry const&) const -> std::unique_ptr<Symbol_Table>;
+    template auto ELF_File<ELF32_MSB>::make_symbol_table(Section_Header_Entry const&) const -> std::unique_ptr<Symbol_Table>;
+    template auto ELF_File<ELF64_LSB>::make_symbol_table(Section_Header_Entry const&) const -> std::unique_ptr<Symbol_Table>;
+    template auto ELF_File<ELF64_MSB>::make_symbol_table(Section_Header_Entry const&) const -> std::unique_ptr<Symbol_Table>;
+}
@@ -0,0 +1,126 @@
+#include "checksum.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using Sum_Kernel = uint64_t (*)(uint8_t const* data, size_t size);
+
+//
+//  The kernels add words into 32-bit lanes, two words per lane per step;
+//  data is fed to them in pieces small enough that no lane overflows.
+//
+static size_t const Kernel_Piece_Size = size_t(1) << 16;
+
+static uint64_t Sum_Tail(uint8_t const* data, size_t size)
+{
+    uint64_t sum = 0;
+    size_t i = 0;
+
+    for (; size - i >= 2; i += 2)
+        sum += uint16_t(data[i] | (data[i + 1] << 8));
+
+    if (i < size)
+        sum += data[i];
+
+    return sum;
+}
+
+static uint64_t Sum_Portable(uint8_t const* data, size_t size)
+{
+    uint64_t lanes = 0;
+    size_t i = 0;
+
+    // Words 0 and 2 of each 8 bytes go to the low lane, 1 and 3 to the high one.
+    for (; size - i >= 8; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+
+        lanes += (word & 0x0000ffff0000ffff) + ((word >> 16) & 0x0000ffff0000ffff);
+    }
+
+    return (lanes & 0xffffffff) + (lanes >> 32) + Sum_Tail(data + i, size - i);
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+static uint64_t Sum_AVX2(uint8_t const* data, size_t size)
+{
+    auto const low_words = _mm256_set1_epi32(0xffff);
+    auto lanes = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; size - i >= 32; i += 32)
+    {
+        auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+
+        lanes = _mm256_add_epi32(lanes, _mm256_and_si256(block, low_words));
+        lanes = _mm256_add_epi32(lanes, _mm256_srli_epi32(block, 16));
+    }
+
+    // Widen to 64 bits before adding the lanes together.
+    auto const wide = _mm256_add_epi64(
+        _mm256_and_si256(lanes, _mm256_set1_epi64x(0xffffffff)),
+        _mm256_srli_epi64(lanes, 32));
+
+    uint64_t sums[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), wide);
+
+    return sums[0] + sums[1] + sums[2] + sums[3] + Sum_Tail(data + i, size - i);
+}
+
+#endif
+
+struct Sum_Implementation
+{
+    Sum_Kernel Sum;
+    string_view Name;
+};
+
+static Sum_Implementation const& Get_Sum_Implementation()
+{
+    static Sum_Implementation const implementation = []() -> Sum_Implementation
+    {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return { Sum_AVX2, "avx2" };
+#endif
+
+        return { Sum_Portable, "portable" };
+    }();
+
+    return implementation;
+}
+
+string_view Get_Word_Sum_Implementation_Name()
+{
+    return Get_Sum_Implementation().Name;
+}
+
+uint64_t Sum_Words(string_view data)
+{
+    auto const sum = Get_Sum_Implementation().Sum;
+    auto const* bytes = reinterpret_cast<uint8_t const*>(data.data());
+
+    uint64_t total = 0;
+
+    for (size_t offset = 0; offset < data.size(); offset += Kernel_Piece_Size)
+        total += sum(bytes + offset, std::min(Kernel_Piece_Size, data.size() - offset));
+
+    return total;
+}
+
+uint16_t Fold_Word_Sum(uint64_t sum)
+{
+    while (sum > 0xffff)
+        sum = (sum & 0xffff) + (sum >> 16);
+
+    return uint16_t(sum);
+}
@@ -0,0 +1,26 @@
+#ifndef CHECKSUM_H__INCLUDED
+#define CHECKSUM_H__INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using std::string_view;
+
+//
+//  The plain sum of the little-endian 16-bit words of data, an odd last
+//  byte counting as a word of its own, for ones'-complement checksums
+//  such as the PE image checksum.  Carries are kept rather than folded, so
+//  sums of pieces split on even offsets add up to the sum of the whole,
+//  and a word can be taken back out by subtracting it.  The AVX2 kernel,
+//  used when the CPU has it, adds 16 words at a time.
+//
+uint64_t Sum_Words(string_view data);
+
+// Adds the carries back in until the sum fits in 16 bits.
+uint16_t Fold_Word_Sum(uint64_t sum);
+
+// The name of the word sum kernel in use, for diagnostics.
+string_view Get_Word_Sum_Implementation_Name();
+
+#endif  // CHECKSUM_H__INCLUDED
@@ -0,0 +1,66 @@
+#include "digests.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+// Small enough to stay in L2 between the passes of the different hashes.
+static size_t const Chunk_Size = 64 * 1024;
+
+Digests Compute_Digests(string_view data)
+{
+    XXH64_State xxh64;
+    SHA256_State sha256;
+
+    for (size_t offset = 0; offset < data.size(); offset += Chunk_Size)
+    {
+        auto const chunk = data.substr(offset, Chunk_Size);
+
+        xxh64.Update(chunk);
+        sha256.Update(chunk);
+    }
+
+    return { xxh64.Digest(), sha256.Digest() };
+}
+
+static char const Hex_Digits[] = "0123456789abcdef";
+
+template<typename Bytes>
+static std::string Format_Hex(Bytes const& bytes)
+{
+    std::string text;
+    text.reserve(bytes.size() * 2);
+
+    for (auto const byte: bytes)
+    {
+        text.push_back(Hex_Digits[uint8_t(byte) >> 4]);
+        text.push_back(Hex_Digits[uint8_t(byte) & 0xf]);
+    }
+
+    return text;
+}
+
+std::string To_Hex(SHA256_Digest const& digest)
+{
+    return Format_Hex(digest);
+}
+
+std::string To_Hex(MD5_Digest const& digest)
+{
+    return Format_Hex(digest);
+}
+
+std::string To_Hex(string_view bytes)
+{
+    return Format_Hex(bytes);
+}
+
+std::string To_Hex(uint64_t value)
+{
+    std::string text(16, '0');
+
+    for (size_t i = text.size(); i-- > 0; value >>= 4)
+        text[i] = Hex_Digits[value & 0xf];
+
+    return text;
+}
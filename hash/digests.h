@@ -0,0 +1,30 @@
+#ifndef DIGESTS_H__INCLUDED
+#define DIGESTS_H__INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "md5.h"
+#include "sha256.h"
+#include "xxhash.h"
+
+struct Digests
+{
+    uint64_t XXH64;
+    SHA256_Digest SHA256;
+};
+
+//
+//  Every digest of the data in one pass: the data is fed to all of the
+//  hashes a cache-sized chunk at a time, so each byte is read from memory
+//  once however many digests are wanted.
+//
+Digests Compute_Digests(string_view data);
+
+std::string To_Hex(SHA256_Digest const& digest);
+std::string To_Hex(MD5_Digest const& digest);
+std::string To_Hex(string_view bytes);
+std::string To_Hex(uint64_t value);
+
+#endif  // DIGESTS_H__INCLUDED
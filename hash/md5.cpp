@@ -0,0 +1,131 @@
+#include "md5.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <include/endian.h>
+
+static constexpr uint32_t Round_Constants[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+static constexpr int Shifts[4][4] = {
+    { 7, 12, 17, 22 },
+    { 5, 9, 14, 20 },
+    { 4, 11, 16, 23 },
+    { 6, 10, 15, 21 }
+};
+
+static constexpr uint32_t Initial_State[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+static void Compress(uint32_t (&state)[4], uint8_t const* data, size_t block_count)
+{
+    for (; block_count > 0; --block_count, data += 64)
+    {
+        uint32_t m[16];
+
+        for (int i = 0; i < 16; ++i)
+        {
+            Endian_Value<uint32_t, std::endian::little> word;
+            std::memcpy(&word, data + (i * 4), sizeof(word));
+            m[i] = word;
+        }
+
+        auto a = state[0], b = state[1], c = state[2], d = state[3];
+
+        for (int i = 0; i < 64; ++i)
+        {
+            uint32_t f;
+            int g;
+
+            switch (i / 16)
+            {
+                case 0:  f = (b & c) | (~b & d);    g = i;                  break;
+                case 1:  f = (d & b) | (~d & c);    g = ((5 * i) + 1) % 16; break;
+                case 2:  f = b ^ c ^ d;             g = ((3 * i) + 5) % 16; break;
+                default: f = c ^ (b | ~d);          g = (7 * i) % 16;       break;
+            }
+
+            auto const rotated = std::rotl(a + f + Round_Constants[i] + m[g], Shifts[i / 16][i % 4]);
+
+            a = d, d = c, c = b, b = b + rotated;
+        }
+
+        state[0] += a, state[1] += b, state[2] += c, state[3] += d;
+    }
+}
+
+MD5_State::MD5_State(): _total_size{0}, _pending_size{0}
+{
+    std::memcpy(_state, Initial_State, sizeof(_state));
+}
+
+void MD5_State::Update(string_view data)
+{
+    auto const* bytes = reinterpret_cast<uint8_t const*>(data.data());
+    auto size = data.size();
+
+    _total_size += size;
+
+    if (_pending_size > 0)
+    {
+        auto const fill = std::min(size, sizeof(_pending) - _pending_size);
+
+        std::memcpy(_pending + _pending_size, bytes, fill);
+        _pending_size += fill;
+        bytes += fill;
+        size -= fill;
+
+        if (_pending_size < sizeof(_pending))
+            return;
+
+        Compress(_state, _pending, 1);
+        _pending_size = 0;
+    }
+
+    Compress(_state, bytes, size / 64);
+    bytes += size & ~size_t(63);
+    size &= 63;
+
+    std::memcpy(_pending, bytes, size);
+    _pending_size = size;
+}
+
+MD5_Digest MD5_State::Digest() const
+{
+    auto state = *this;
+
+    // Padding: 0x80, zeros up to 56 bytes into the last block, then the length in bits, little-endian.
+    uint8_t padding[72] = { 0x80 };
+    auto const padding_size = ((_pending_size < 56) ? 56 : 120) - _pending_size;
+    auto const bit_count = Endian_Value<uint64_t, std::endian::little>::From(_total_size * 8);
+
+    std::memcpy(padding + padding_size, &bit_count, sizeof(bit_count));
+    state.Update(string_view(reinterpret_cast<char const*>(padding), padding_size + sizeof(bit_count)));
+
+    MD5_Digest digest;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        auto const word = Endian_Value<uint32_t, std::endian::little>::From(state._state[i]);
+        std::memcpy(&digest[i * 4], &word, sizeof(word));
+    }
+
+    return digest;
+}
+
+MD5_Digest MD5(string_view data)
+{
+    MD5_State state;
+    state.Update(data);
+
+    return state.Digest();
+}
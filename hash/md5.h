@@ -0,0 +1,36 @@
+#ifndef MD5_H__INCLUDED
+#define MD5_H__INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using std::string_view;
+
+using MD5_Digest = std::array<uint8_t, 16>;
+
+//
+//  MD5 over data that arrives in pieces, the same way as SHA256_State.
+//  Not for anything that needs collision resistance: it is here because
+//  published fingerprints such as the PE import hash are defined with it.
+//
+class MD5_State
+{
+    private:
+        uint32_t _state[4];
+        uint64_t _total_size;
+
+        uint8_t _pending[64];
+        size_t _pending_size;
+
+    public:
+        MD5_State();
+
+        void Update(string_view data);
+        MD5_Digest Digest() const;
+};
+
+MD5_Digest MD5(string_view data);
+
+#endif  // MD5_H__INCLUDED
@@ -0,0 +1,247 @@
+#include "sha256.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#include <include/endian.h>
+
+using Compress_Function = void (*)(uint32_t (&state)[8], uint8_t const* data, size_t block_count);
+
+alignas(16) static constexpr uint32_t Round_Constants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static constexpr uint32_t Initial_State[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static uint32_t Read_Big(uint8_t const* data)
+{
+    Endian_Value<uint32_t, std::endian::big> value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static void Compress_Portable(uint32_t (&state)[8], uint8_t const* data, size_t block_count)
+{
+    for (; block_count > 0; --block_count, data += 64)
+    {
+        uint32_t w[64];
+
+        for (int i = 0; i < 16; ++i)
+            w[i] = Read_Big(data + (i * 4));
+
+        for (int i = 16; i < 64; ++i)
+        {
+            auto const s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            auto const s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        auto a = state[0], b = state[1], c = state[2], d = state[3];
+        auto e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; ++i)
+        {
+            auto const s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+            auto const choice = (e & f) ^ (~e & g);
+            auto const t1 = h + s1 + choice + Round_Constants[i] + w[i];
+            auto const s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+            auto const majority = (a & b) ^ (a & c) ^ (b & c);
+            auto const t2 = s0 + majority;
+
+            h = g, g = f, f = e, e = d + t1;
+            d = c, c = b, b = a, a = t1 + t2;
+        }
+
+        state[0] += a, state[1] += b, state[2] += c, state[3] += d;
+        state[4] += e, state[5] += f, state[6] += g, state[7] += h;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+//
+//  The SHA extensions keep the state as ABEF/CDGH halves and run four rounds
+//  per pair of sha256rnds2; sha256msg1/msg2 extend the message schedule four
+//  words at a time, kept in a ring of four registers.
+//
+__attribute__((target("sha,sse4.1")))
+static void Compress_SHA_NI(uint32_t (&state)[8], uint8_t const* data, size_t block_count)
+{
+    auto const byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    auto dcba = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[0]));
+    auto hgfe = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[4]));
+
+    dcba = _mm_shuffle_epi32(dcba, 0xB1);
+    hgfe = _mm_shuffle_epi32(hgfe, 0x1B);
+
+    auto abef = _mm_alignr_epi8(dcba, hgfe, 8);
+    auto cdgh = _mm_blend_epi16(hgfe, dcba, 0xF0);
+
+    for (; block_count > 0; --block_count, data += 64)
+    {
+        auto const saved_abef = abef;
+        auto const saved_cdgh = cdgh;
+
+        __m128i w[4];
+
+        for (int i = 0; i < 16; ++i)
+        {
+            auto& words = w[i % 4];
+
+            if (i < 4)
+            {
+                words = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + (i * 16))), byte_swap);
+            } else {
+                auto const previous = w[(i + 3) % 4];
+
+                words = _mm_sha256msg1_epu32(words, w[(i + 1) % 4]);
+                words = _mm_add_epi32(words, _mm_alignr_epi8(previous, w[(i + 2) % 4], 4));
+                words = _mm_sha256msg2_epu32(words, previous);
+            }
+
+            auto const message = _mm_add_epi32(words, _mm_load_si128(reinterpret_cast<__m128i const*>(&Round_Constants[i * 4])));
+
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0E));
+        }
+
+        abef = _mm_add_epi32(abef, saved_abef);
+        cdgh = _mm_add_epi32(cdgh, saved_cdgh);
+    }
+
+    auto const feba = _mm_shuffle_epi32(abef, 0x1B);
+    auto const dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+static bool Has_SHA_Extensions()
+{
+    unsigned eax, ebx, ecx, edx;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    bool const sha = (ebx & (1u << 29)) != 0;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    bool const sse4_1 = (ecx & (1u << 19)) != 0;
+
+    return sha && sse4_1;
+}
+
+#endif
+
+struct Compress_Implementation
+{
+    Compress_Function Compress;
+    string_view Name;
+};
+
+static Compress_Implementation const& Get_Compress_Implementation()
+{
+    static Compress_Implementation const implementation = []() -> Compress_Implementation
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        if (Has_SHA_Extensions())
+            return { Compress_SHA_NI, "sha-ni" };
+#endif
+
+        return { Compress_Portable, "portable" };
+    }();
+
+    return implementation;
+}
+
+string_view Get_SHA256_Implementation_Name()
+{
+    return Get_Compress_Implementation().Name;
+}
+
+SHA256_State::SHA256_State(): _total_size{0}, _pending_size{0}
+{
+    std::memcpy(_state, Initial_State, sizeof(_state));
+}
+
+void SHA256_State::Update(string_view data)
+{
+    auto const compress = Get_Compress_Implementation().Compress;
+    auto const* bytes = reinterpret_cast<uint8_t const*>(data.data());
+    auto size = data.size();
+
+    _total_size += size;
+
+    if (_pending_size > 0)
+    {
+        auto const fill = std::min(size, sizeof(_pending) - _pending_size);
+
+        std::memcpy(_pending + _pending_size, bytes, fill);
+        _pending_size += fill;
+        bytes += fill;
+        size -= fill;
+
+        if (_pending_size < sizeof(_pending))
+            return;
+
+        compress(_state, _pending, 1);
+        _pending_size = 0;
+    }
+
+    compress(_state, bytes, size / 64);
+    bytes += size & ~size_t(63);
+    size &= 63;
+
+    std::memcpy(_pending, bytes, size);
+    _pending_size = size;
+}
+
+SHA256_Digest SHA256_State::Digest() const
+{
+    auto state = *this;
+
+    // Padding: 0x80, zeros up to 56 bytes into the last block, then the length in bits.
+    uint8_t padding[72] = { 0x80 };
+    auto const padding_size = ((_pending_size < 56) ? 56 : 120) - _pending_size;
+    auto const bit_count = Endian_Value<uint64_t, std::endian::big>::From(_total_size * 8);
+
+    std::memcpy(padding + padding_size, &bit_count, sizeof(bit_count));
+    state.Update(string_view(reinterpret_cast<char const*>(padding), padding_size + sizeof(bit_count)));
+
+    SHA256_Digest digest;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        auto const word = Endian_Value<uint32_t, std::endian::big>::From(state._state[i]);
+        std::memcpy(&digest[i * 4], &word, sizeof(word));
+    }
+
+    return digest;
+}
+
+SHA256_Digest SHA256(string_view data)
+{
+    SHA256_State state;
+    state.Update(data);
+
+    return state.Digest();
+}
@@ -0,0 +1,41 @@
+#ifndef SHA256_H__INCLUDED
+#define SHA256_H__INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using std::string_view;
+
+using SHA256_Digest = std::array<uint8_t, 32>;
+
+//
+//  SHA-256 over data that arrives in pieces.  Whole 64-byte blocks are
+//  compressed straight from the caller's buffer; only a block split between
+//  two Update() calls is copied.  The compression function is picked once
+//  per process: the SHA extensions when the CPU has them, portable code
+//  otherwise.
+//
+class SHA256_State
+{
+    private:
+        uint32_t _state[8];
+        uint64_t _total_size;
+
+        uint8_t _pending[64];
+        size_t _pending_size;
+
+    public:
+        SHA256_State();
+
+        void Update(string_view data);
+        SHA256_Digest Digest() const;
+};
+
+SHA256_Digest SHA256(string_view data);
+
+// The name of the compression function in use, for diagnostics.
+string_view Get_SHA256_Implementation_Name();
+
+#endif  // SHA256_H__INCLUDED
@@ -0,0 +1,146 @@
+#include "xxhash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <include/endian.h>
+
+static constexpr uint64_t Prime_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t Prime_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t Prime_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t Prime_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t Prime_5 = 0x27D4EB2F165667C5ULL;
+
+template<typename T>
+static T Read_Little(char const* data)
+{
+    Endian_Value<T, std::endian::little> value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint64_t Round(uint64_t accumulator, uint64_t lane)
+{
+    accumulator += lane * Prime_2;
+    accumulator = std::rotl(accumulator, 31);
+    return accumulator * Prime_1;
+}
+
+static uint64_t Merge_Round(uint64_t hash, uint64_t accumulator)
+{
+    hash ^= Round(0, accumulator);
+    return (hash * Prime_1) + Prime_4;
+}
+
+// Runs the four lanes over every whole 32-byte stripe; returns the bytes consumed.
+static size_t Consume_Stripes(uint64_t (&lanes)[4], char const* data, size_t size)
+{
+    auto v1 = lanes[0], v2 = lanes[1], v3 = lanes[2], v4 = lanes[3];
+    size_t offset = 0;
+
+    for (; size - offset >= 32; offset += 32)
+    {
+        v1 = Round(v1, Read_Little<uint64_t>(data + offset));
+        v2 = Round(v2, Read_Little<uint64_t>(data + offset + 8));
+        v3 = Round(v3, Read_Little<uint64_t>(data + offset + 16));
+        v4 = Round(v4, Read_Little<uint64_t>(data + offset + 24));
+    }
+
+    lanes[0] = v1, lanes[1] = v2, lanes[2] = v3, lanes[3] = v4;
+
+    return offset;
+}
+
+// Folds the lanes, the length and the final partial stripe into the digest.
+static uint64_t Finish(uint64_t const (&lanes)[4], uint64_t seed, uint64_t total_size, char const* p, size_t size)
+{
+    auto const* const end = p + size;
+    uint64_t hash;
+
+    if (total_size >= 32)
+    {
+        hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+        hash = Merge_Round(hash, lanes[0]);
+        hash = Merge_Round(hash, lanes[1]);
+        hash = Merge_Round(hash, lanes[2]);
+        hash = Merge_Round(hash, lanes[3]);
+    } else {
+        hash = seed + Prime_5;
+    }
+
+    hash += total_size;
+
+    for (; end - p >= 8; p += 8)
+    {
+        hash ^= Round(0, Read_Little<uint64_t>(p));
+        hash = (std::rotl(hash, 27) * Prime_1) + Prime_4;
+    }
+
+    if (end - p >= 4)
+    {
+        hash ^= uint64_t(Read_Little<uint32_t>(p)) * Prime_1;
+        hash = (std::rotl(hash, 23) * Prime_2) + Prime_3;
+        p += 4;
+    }
+
+    for (; p < end; ++p)
+    {
+        hash ^= uint64_t(uint8_t(*p)) * Prime_5;
+        hash = std::rotl(hash, 11) * Prime_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime_2;
+    hash ^= hash >> 29;
+    hash *= Prime_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+uint64_t XXH64(string_view data, uint64_t seed)
+{
+    uint64_t lanes[4] = { seed + Prime_1 + Prime_2, seed + Prime_2, seed, seed - Prime_1 };
+
+    auto const consumed = Consume_Stripes(lanes, data.data(), data.size());
+
+    return Finish(lanes, seed, data.size(), data.data() + consumed, data.size() - consumed);
+}
+
+XXH64_State::XXH64_State(uint64_t seed):
+    _lanes{ seed + Prime_1 + Prime_2, seed + Prime_2, seed, seed - Prime_1 },
+    _seed{seed},
+    _total_size{0},
+    _pending_size{0}
+{}
+
+void XXH64_State::Update(string_view data)
+{
+    _total_size += data.size();
+
+    if (_pending_size > 0)
+    {
+        auto const fill = std::min(data.size(), sizeof(_pending) - _pending_size);
+
+        std::memcpy(_pending + _pending_size, data.data(), fill);
+        _pending_size += fill;
+        data.remove_prefix(fill);
+
+        if (_pending_size < sizeof(_pending))
+            return;
+
+        Consume_Stripes(_lanes, _pending, sizeof(_pending));
+        _pending_size = 0;
+    }
+
+    data.remove_prefix(Consume_Stripes(_lanes, data.data(), data.size()));
+
+    std::memcpy(_pending, data.data(), data.size());
+    _pending_size = data.size();
+}
+
+uint64_t XXH64_State::Digest() const
+{
+    return Finish(_lanes, _seed, _total_size, _pending, _pending_size);
+}
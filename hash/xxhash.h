@@ -0,0 +1,39 @@
+#ifndef XXHASH_H__INCLUDED
+#define XXHASH_H__INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using std::string_view;
+
+//
+//  XXH64, the 64-bit xxHash.  It is not a cryptographic hash; it is meant
+//  for keying caches and indexes by file contents, where it runs at memory
+//  speed.  Results match the reference implementation for the same seed.
+//
+uint64_t XXH64(string_view data, uint64_t seed = 0);
+
+//
+//  XXH64 over data that arrives in pieces.  Feeding the same bytes in any
+//  split gives the same digest as the one-shot XXH64().
+//
+class XXH64_State
+{
+    private:
+        uint64_t _lanes[4];
+        uint64_t _seed;
+        uint64_t _total_size;
+
+        // Bytes of an incomplete 32-byte stripe.
+        char _pending[32];
+        size_t _pending_size;
+
+    public:
+        explicit XXH64_State(uint64_t seed = 0);
+
+        void Update(string_view data);
+        uint64_t Digest() const;
+};
+
+#endif  // XXHASH_H__INCLUDED
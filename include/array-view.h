@@ -30,6 +30,10 @@ class array_view
 
         size_t size() const             { return (_end - _begin); }
         size_t length() const           { return (_end - _begin); }
+        bool empty() const              { return (_end == _begin); }
+
+        T const& operator[](size_t i) const     { return _begin[i]; }
+        T& operator[](size_t i)                 { return _begin[i]; }
 
         const_iterator begin() const    { return _begin; }
         const_iterator end() const      { return _end; }
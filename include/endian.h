@@ -0,0 +1,70 @@
+#ifndef ENDIAN_H__INCLUDED
+#define ENDIAN_H__INCLUDED
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+template<typename T>
+constexpr T Byte_Swap(T value)
+{
+    static_assert(std::is_integral_v<T>, "Only integers can be byte-swapped.");
+
+    using unsigned_type = std::make_unsigned_t<T>;
+
+    if constexpr (sizeof(T) == 1)
+        return value;
+    else if constexpr (sizeof(T) == 2)
+        return T(__builtin_bswap16(unsigned_type(value)));
+    else if constexpr (sizeof(T) == 4)
+        return T(__builtin_bswap32(unsigned_type(value)));
+    else
+        return T(__builtin_bswap64(unsigned_type(value)));
+}
+
+//
+//  An integer stored in the file with the given byte order.  Reading it
+//  converts to host order, which is a plain load when the orders match.
+//  It is packed so that it can be laid over unaligned file structures.
+//
+template<typename T, std::endian Order>
+struct __attribute__((packed)) Endian_Value
+{
+    using value_type = T;
+
+    T Raw;
+
+    constexpr T value() const
+    {
+        if constexpr (Order == std::endian::native)
+            return Raw;
+        else
+            return Byte_Swap(Raw);
+    }
+
+    constexpr operator T() const { return value(); }
+
+    static constexpr Endian_Value From(T value)
+    {
+        if constexpr (Order == std::endian::native)
+            return Endian_Value{value};
+        else
+            return Endian_Value{Byte_Swap(value)};
+    }
+};
+
+//
+//  The integer behind a file field, for code that formats or stores
+//  numbers: Endian_Value unwraps to its value_type, while plain integers
+//  and enums pass through unchanged.
+//
+template<typename T>
+constexpr auto Integer_Value(T value)
+{
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        return value;
+    else
+        return typename T::value_type(value);
+}
+
+#endif  // ENDIAN_H__INCLUDED
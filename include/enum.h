@@ -1,10 +1,12 @@
 #ifndef ENUM_H__INCLUDED
 #define ENUM_H__INCLUDED
 
-#include <functional>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 #include <type_traits>
-#include <vector>
 
 template<typename Enum>
 struct Enable_Bitwise_Operations
@@ -19,44 +21,189 @@ struct Enable_Bitwise_Operations
         static const bool value = true;         \
     };                                          \
 
-template<typename Enum, typename base_type = typename std::underlying_type<Enum>::type>
-static inline constexpr typename std::enable_if<Enable_Bitwise_Operations<Enum>::value, Enum>::type
-Perform_Enum_Operation(Enum left, Enum right,std::function<base_type(base_type, base_type)> op) 
-{
-    static_assert(std::is_enum<Enum>::value, "Template type parameter is not an enum.");
-
-    return Enum{op(base_type(left), base_type(right))};
-}
+template<typename Enum>
+concept Bitwise_Enum = std::is_enum_v<Enum> && Enable_Bitwise_Operations<Enum>::value;
 
-#define DEFINE_BINARY_BITWISE_OPERATOR(op)                                                                      \
-    template<typename Enum>                                                                                     \
-    constexpr Enum operator op(Enum left, Enum right)                                                           \
-    {                                                                                                           \
-        using base_type = typename std::underlying_type<Enum>::type;                                            \
-        std::function<base_type(base_type, base_type)> fn = [](auto left, auto right) {return left op right;};  \
-        return Perform_Enum_Operation(left, right, fn);                                                         \
-    }                                                                                                           \
+#define DEFINE_BINARY_BITWISE_OPERATOR(op)                                      \
+    template<Bitwise_Enum Enum>                                                 \
+    constexpr Enum operator op(Enum left, Enum right)                           \
+    {                                                                           \
+        using base_type = typename std::underlying_type<Enum>::type;            \
+        return Enum(base_type(left) op base_type(right));                       \
+    }                                                                           \
 
 DEFINE_BINARY_BITWISE_OPERATOR(&);
 DEFINE_BINARY_BITWISE_OPERATOR(|);
 DEFINE_BINARY_BITWISE_OPERATOR(^);
 
-template<typename Enum>
-static inline auto Get_Enum_Names(Enum value, std::function<std::string_view(Enum)> Get_Name)
+template<Bitwise_Enum Enum>
+constexpr Enum operator~(Enum value)
 {
-    std::vector<std::string_view> names;
+    using base_type = typename std::underlying_type<Enum>::type;
+    return Enum(base_type(~base_type(value)));
+}
+
+template<Bitwise_Enum Enum>
+constexpr bool Has_Flags(Enum value, Enum flags)
+{
+    return ((value & flags) == flags);
+}
+
+//
+//  A range over the names of the bits set in a flags value, lowest bit
+//  first.  Walking it only clears bits in a copy of the value and calls
+//  Get_Name, so it allocates nothing.
+//
+template<typename Enum, auto Get_Name>
+class Enum_Flag_Names
+{
+    private:
+        using bits_type = std::make_unsigned_t<typename std::underlying_type<Enum>::type>;
+
+        bits_type _bits;
+
+    public:
+        class iterator
+        {
+            private:
+                bits_type _bits;
 
-    for (int i = 0; i < sizeof(Enum) * 8; ++i)
-    {
-        auto probing = Enum(1<<i);
+            public:
+                constexpr explicit iterator(bits_type bits): _bits{bits} {}
 
-        if (int(value & probing) != 0)
-            names.push_back(Get_Name(probing));
-    }
+                constexpr std::string_view operator*() const
+                { return Get_Name(Enum(_bits & bits_type(-_bits))); }
 
-    return names;
+                constexpr iterator& operator++()
+                {
+                    _bits &= bits_type(_bits - 1);
+                    return *this;
+                }
+
+                constexpr bool operator==(iterator const& other) const { return (_bits == other._bits); }
+                constexpr bool operator!=(iterator const& other) const { return (_bits != other._bits); }
+        };
+
+        constexpr explicit Enum_Flag_Names(Enum value): _bits{bits_type(value)} {}
+
+        constexpr iterator begin() const { return iterator{_bits}; }
+        constexpr iterator end() const { return iterator{0}; }
+
+        constexpr bool empty() const { return (_bits == 0); }
+        constexpr size_t size() const { return size_t(std::popcount(_bits)); }
+};
+
+template<auto Get_Name, typename Enum>
+constexpr auto Get_Enum_Names(Enum value)
+{
+    return Enum_Flag_Names<Enum, Get_Name>(value);
 }
 
+template<typename Enum>
+struct Enum_Name
+{
+    Enum Value;
+    std::string_view Name;
+};
+
+//
+//  An immutable value -> name table built at compile time.  Entries are kept
+//  sorted by value (first one wins on duplicates) and, when the values span
+//  no more than Dense_Range, also indexed directly by (value - minimum).
+//  Lookups never allocate or modify anything, so a table can be shared by
+//  any number of threads.  Unknown values map to an empty name.
+//
+template<typename Enum, size_t N>
+class Enum_Name_Table
+{
+    private:
+        using base_type = typename std::underlying_type<Enum>::type;
+
+        static constexpr size_t Dense_Range = 64;
+
+        std::array<Enum_Name<Enum>, N> _entries;
+        std::array<uint8_t, Dense_Range> _slots;
+        uint64_t _minimum;
+        bool _dense;
+
+        static constexpr uint64_t key(Enum value) { return uint64_t(base_type(value)); }
+
+    public:
+        constexpr Enum_Name_Table(Enum_Name<Enum> const (&entries)[N]):
+            _entries{},
+            _slots{},
+            _minimum{0},
+            _dense{false}
+        {
+            static_assert(N < 256, "Enum_Name_Table holds at most 255 names.");
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                auto entry = entries[i];
+                size_t j = i;
+
+                for (; (j > 0) && (key(entry.Value) < key(_entries[j - 1].Value)); --j)
+                    _entries[j] = _entries[j - 1];
+
+                _entries[j] = entry;
+            }
+
+            if constexpr (N > 0)
+            {
+                _minimum = key(_entries[0].Value);
+                _dense = ((key(_entries[N - 1].Value) - _minimum) < Dense_Range);
+
+                if (_dense)
+                    for (size_t i = N; i > 0; --i)
+                        _slots[key(_entries[i - 1].Value) - _minimum] = uint8_t(i);
+            }
+        }
+
+        constexpr std::string_view operator[](Enum value) const
+        {
+            auto const k = key(value);
+
+            if (_dense)
+            {
+                auto const slot = k - _minimum;
+
+                if ((slot >= Dense_Range) || (_slots[slot] == 0))
+                    return {};
+
+                return _entries[_slots[slot] - 1].Name;
+            }
+
+            size_t low = 0;
+            size_t high = N;
+
+            while (low < high)
+            {
+                auto const middle = (low + high) / 2;
+
+                if (key(_entries[middle].Value) < k)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+
+            if ((low < N) && (key(_entries[low].Value) == k))
+                return _entries[low].Name;
+
+            return {};
+        }
+
+        constexpr bool Contains(Enum value) const { return !(*this)[value].empty(); }
+
+        constexpr size_t size() const { return N; }
+        constexpr auto begin() const { return _entries.begin(); }
+        constexpr auto end() const { return _entries.end(); }
+};
+
+template<typename Enum, size_t N>
+constexpr auto Make_Enum_Name_Table(Enum_Name<Enum> const (&entries)[N])
+{
+    return Enum_Name_Table<Enum, N>(entries);
+}
 
 #endif  // ENUM_H__INCLUDED
 
@@ -3,10 +3,12 @@
 
 #include "include/interface.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <string_view>
-#include <map>
 
 #include "include/array-view.h"
+#include "include/enum.h"
 
 using std::operator""sv;
 
@@ -15,6 +17,7 @@ enum class File_Format
     ELF_Executable,
     ELF_Object,
     ELF_Shared_Object,
+    ELF_Core_Dump,
     ELF64_Executable,
     ELF64_Object,
     ELF64_Shared_Object,
@@ -25,15 +28,17 @@ enum class File_Format
     MZ_Object,
     MZ_DLL,
     MZ_Library,
+    Columnar,
     Unknown
 };
 
-inline std::string_view const& Get_File_Format_Name(File_Format value)
+inline std::string_view Get_File_Format_Name(File_Format value)
 {
-    static std::map<File_Format, std::string_view> const File_Formats = {
+    static constexpr auto File_Formats = Make_Enum_Name_Table<File_Format>({
         { File_Format::ELF_Executable, "ELF_Executable"sv },
         { File_Format::ELF_Object, "ELF_Object"sv },
         { File_Format::ELF_Shared_Object, "ELF_Shared_Object"sv },
+        { File_Format::ELF_Core_Dump, "ELF_Core_Dump"sv },
         { File_Format::ELF64_Executable, "ELF64_Executable"sv },
         { File_Format::ELF64_Object, "ELF64_Object"sv },
         { File_Format::ELF64_Shared_Object, "ELF64_Shared_Object"sv },
@@ -44,10 +49,11 @@ inline std::string_view const& Get_File_Format_Name(File_Format value)
         { File_Format::MZ_Object, "MZ_Object"sv },
         { File_Format::MZ_DLL, "MZ_DLL"sv },
         { File_Format::MZ_Library, "MZ_Library"sv },
+        { File_Format::Columnar, "Columnar"sv },
         { File_Format::Unknown, "Unknown"sv }
-    };
+    });
 
-    return File_Formats.at(value);
+    return File_Formats[value];
 }
 
 template<typename Target_Type, typename Item_Type>
@@ -101,6 +107,17 @@ class Parsed_File: public Base_Class
         virtual File_Format Get_File_Format() const = 0;
 
         virtual std::string_view buffer() const { return _buffer; }
+
+        // The part of the given range that lies inside the buffer.
+        std::string_view Get_Range(uint64_t offset, uint64_t size) const
+        {
+            auto const contents = buffer();
+
+            if (offset >= contents.size())
+                return {};
+
+            return contents.substr(offset, std::min<uint64_t>(size, contents.size() - offset));
+        }
 };
 
 #endif  // FILE_FORMAT__INCLUDED
@@ -0,0 +1,71 @@
+#ifndef INTERVAL_INDEX_H__INCLUDED
+#define INTERVAL_INDEX_H__INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+//
+//  A flat table of half-open [Start, End) intervals sorted by Start, looked
+//  up with a branch-free binary search.  Intervals are expected not to
+//  overlap; if they do, the one with the greatest Start at or below the
+//  address wins.
+//
+template<typename Address, typename Payload>
+class Interval_Index
+{
+    public:
+        struct Interval
+        {
+            Address Start;
+            Address End;
+            Payload Value;
+        };
+
+    private:
+        std::vector<Interval> _intervals;
+
+    public:
+        void reserve(size_t count) { _intervals.reserve(count); }
+        size_t size() const noexcept { return _intervals.size(); }
+        bool empty() const noexcept { return _intervals.empty(); }
+
+        auto begin() const noexcept { return _intervals.begin(); }
+        auto end() const noexcept { return _intervals.end(); }
+
+        void Add(Address start, Address end, Payload value)
+        {
+            if (start < end)
+                _intervals.push_back(Interval{start, end, value});
+        }
+
+        void Build()
+        {
+            std::stable_sort(
+                _intervals.begin(), _intervals.end(),
+                [](Interval const& left, Interval const& right) { return left.Start < right.Start; });
+        }
+
+        Interval const* Find(Address address) const
+        {
+            if (_intervals.empty())
+                return nullptr;
+
+            Interval const* base = _intervals.data();
+            size_t count = _intervals.size();
+
+            while (count > 1)
+            {
+                auto const half = count / 2;
+                base = (base[half].Start <= address) ? (base + half) : base;
+                count -= half;
+            }
+
+            if ((base->Start <= address) && (address < base->End))
+                return base;
+
+            return nullptr;
+        }
+};
+
+#endif  // INTERVAL_INDEX_H__INCLUDED
@@ -0,0 +1,100 @@
+#ifndef NAME_INDEX_H__INCLUDED
+#define NAME_INDEX_H__INCLUDED
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+//
+//  An open-addressing (linear probing) hash index from names to entry
+//  numbers.  The index stores only hashes and entry numbers; names are
+//  fetched back through the caller's Get_Name(entry) so that they can stay
+//  as views into the file buffer.  The first entry inserted under a name
+//  wins.
+//
+class Name_Index
+{
+    private:
+        struct Slot
+        {
+            uint32_t Hash;
+            uint32_t Entry_Plus_One;    // 0 marks an empty slot.
+        };
+
+        std::vector<Slot> _slots;
+        size_t _mask = 0;
+        size_t _count = 0;
+
+    public:
+        static constexpr uint32_t npos = ~uint32_t(0);
+
+        static constexpr uint32_t Hash(std::string_view name)
+        {
+            uint32_t hash = 2166136261u;
+
+            for (auto const c: name)
+                hash = (hash ^ uint8_t(c)) * 16777619u;
+
+            return hash;
+        }
+
+        void reserve(size_t count)
+        {
+            auto const capacity = std::bit_ceil(std::max<size_t>(count * 2, 16));
+
+            _slots.assign(capacity, Slot{0, 0});
+            _mask = capacity - 1;
+            _count = 0;
+        }
+
+        size_t size() const noexcept { return _count; }
+
+        template<typename Get_Name>
+        bool Insert(uint32_t entry, std::string_view name, Get_Name get_name)
+        {
+            if ((_count + 1) * 2 > _slots.size())
+                return false;
+
+            auto const hash = Hash(name);
+
+            for (auto i = size_t(hash) & _mask; ; i = (i + 1) & _mask)
+            {
+                auto& slot = _slots[i];
+
+                if (slot.Entry_Plus_One == 0)
+                {
+                    slot = Slot{hash, entry + 1};
+                    ++_count;
+                    return true;
+                }
+
+                if ((slot.Hash == hash) && (get_name(slot.Entry_Plus_One - 1) == name))
+                    return false;
+            }
+        }
+
+        template<typename Get_Name>
+        uint32_t Find(std::string_view name, Get_Name get_name) const
+        {
+            if (_slots.empty())
+                return npos;
+
+            auto const hash = Hash(name);
+
+            for (auto i = size_t(hash) & _mask; ; i = (i + 1) & _mask)
+            {
+                auto const& slot = _slots[i];
+
+                if (slot.Entry_Plus_One == 0)
+                    return npos;
+
+                if ((slot.Hash == hash) && (get_name(slot.Entry_Plus_One - 1) == name))
+                    return slot.Entry_Plus_One - 1;
+            }
+        }
+};
+
+#endif  // NAME_INDEX_H__INCLUDED
@@ -0,0 +1,197 @@
+#ifndef WORK_STEALING_POOL_H__INCLUDED
+#define WORK_STEALING_POOL_H__INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "include/interface.h"
+
+//
+//  A fixed set of workers, each with its own task deque.  A worker pops the
+//  newest task from its own deque and, when that is empty, steals the oldest
+//  task from a sibling.  Threads that need to wait for results (including
+//  workers waiting on tasks they submitted themselves) help by running
+//  pending tasks instead of blocking, so nested submissions cannot deadlock.
+//
+class Work_Stealing_Pool: public Base_Class
+{
+    public:
+        using Task = std::function<void()>;
+
+    private:
+        struct Worker_Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker_Queue>> _queues;
+        std::vector<std::thread> _threads;
+
+        std::atomic<size_t> _queued_count;
+        std::atomic<size_t> _next_queue;
+        std::atomic<bool> _stopping;
+
+        std::mutex _sleep_mutex;
+        std::condition_variable _wake;
+
+        inline static thread_local Work_Stealing_Pool* _current_pool = nullptr;
+        inline static thread_local size_t _current_queue = 0;
+
+        bool pop_local(size_t index, Task& task)
+        {
+            auto& queue = *_queues[index];
+            std::lock_guard lock(queue.mutex);
+
+            if (queue.tasks.empty())
+                return false;
+
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            --_queued_count;
+
+            return true;
+        }
+
+        bool steal(size_t thief, Task& task)
+        {
+            for (size_t i = 1; i <= _queues.size(); ++i)
+            {
+                auto& queue = *_queues[(thief + i) % _queues.size()];
+                std::lock_guard lock(queue.mutex);
+
+                if (queue.tasks.empty())
+                    continue;
+
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --_queued_count;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        bool take(Task& task)
+        {
+            if (_current_pool == this)
+                return (pop_local(_current_queue, task) || steal(_current_queue, task));
+
+            return steal(_next_queue.load(std::memory_order_relaxed), task);
+        }
+
+        void worker_loop(size_t index)
+        {
+            _current_pool = this;
+            _current_queue = index;
+
+            for (;;)
+            {
+                Task task;
+
+                if (take(task))
+                {
+                    task();
+                    continue;
+                }
+
+                std::unique_lock lock(_sleep_mutex);
+
+                _wake.wait(lock, [this] { return (_stopping || (_queued_count > 0)); });
+
+                if (_stopping && (_queued_count == 0))
+                    return;
+            }
+        }
+
+    public:
+        explicit Work_Stealing_Pool(size_t thread_count = std::thread::hardware_concurrency()):
+            _queued_count{0},
+            _next_queue{0},
+            _stopping{false}
+        {
+            if (thread_count == 0)
+                thread_count = 1;
+
+            for (size_t i = 0; i < thread_count; ++i)
+                _queues.push_back(std::make_unique<Worker_Queue>());
+
+            for (size_t i = 0; i < thread_count; ++i)
+                _threads.emplace_back(&Work_Stealing_Pool::worker_loop, this, i);
+        }
+
+        Work_Stealing_Pool(Work_Stealing_Pool const&) = delete;
+        Work_Stealing_Pool& operator=(Work_Stealing_Pool const&) = delete;
+
+        ~Work_Stealing_Pool() override
+        {
+            {
+                std::lock_guard lock(_sleep_mutex);
+                _stopping = true;
+            }
+
+            _wake.notify_all();
+
+            for (auto& thread: _threads)
+                thread.join();
+        }
+
+        size_t Thread_Count() const noexcept { return _threads.size(); }
+
+        // The pool whose worker is running the caller, or nullptr.
+        static Work_Stealing_Pool* Current() noexcept { return _current_pool; }
+
+        //
+        //  Tasks submitted from one of this pool's workers go to that worker's
+        //  own deque; tasks from any other thread are spread round-robin.
+        //
+        void Submit(Task task)
+        {
+            auto const index =
+                (_current_pool == this)
+                    ? _current_queue
+                    : (_next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size());
+
+            {
+                auto& queue = *_queues[index];
+                std::lock_guard lock(queue.mutex);
+
+                queue.tasks.push_back(std::move(task));
+                ++_queued_count;
+            }
+
+            // Taking the sleep mutex orders this wake-up after any worker's
+            // predicate check, so a worker about to sleep cannot miss it.
+            { std::lock_guard lock(_sleep_mutex); }
+            _wake.notify_one();
+        }
+
+        bool Run_Pending_Task()
+        {
+            Task task;
+
+            if (!take(task))
+                return false;
+
+            task();
+            return true;
+        }
+
+        template<typename Predicate>
+        void Wait_Until(Predicate done)
+        {
+            while (!done())
+                if (!Run_Pending_Task())
+                    std::this_thread::yield();
+        }
+};
+
+#endif  // WORK_STEALING_POOL_H__INCLUDED
@@ -0,0 +1,129 @@
+#include "ar-dumper.h"
+
+#include <exception>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <variant>
+
+#include <ar/ar.h>
+#include <include/work-stealing-pool.h>
+
+#include "batch.h"
+#include "command-line-arguments.h"
+#include "file-details.h"
+#include "table-writer.h"
+
+using std::string_view;
+
+static string_view Get_Field_Text(char const* field, size_t size)
+{
+    auto const text = string_view(field, size);
+    auto const end = text.find_last_not_of(' ');
+
+    return (end == string_view::npos) ? string_view{} : text.substr(0, end + 1);
+}
+
+static void Show_AR_Symbol_Index(AR const& ar, std::ostream& out)
+{
+    auto const& symbols = ar.Get_Symbols();
+
+    out << "Symbol index: " << std::dec << symbols.size() << " entries" << std::hex << '\n';
+
+    Table_Writer table {
+        "Index",
+        "Member_Offset",
+        "Name"
+    };
+
+    int index = 0;
+
+    for (auto const& symbol: symbols)
+    {
+        table.Decimal(index++);
+
+        if (symbol.Defining_Member)
+            table.Hexadecimal(symbol.Defining_Member->Offset);
+        else
+            table.Text("??");
+
+        table.Text(symbol.Name);
+    }
+
+    table.Print(out);
+}
+
+static void Show_AR_Member_Details(
+        AR::Member const& member, size_t index,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out)
+{
+    out
+        << "Member " << std::dec << index << ": " << member.Name << ": "
+        << member.Contents.length() << "(0x" << std::hex << member.Contents.length() << ")" << " bytes."
+        << '\n';
+
+    auto parsed_content = Parse(member.Contents);
+
+    if (parsed_content.index() == 0)
+    {
+        out << "Could not understand the format." << '\n' << '\n';
+        return;
+    }
+
+    Show_File_Details(*std::get<std::unique_ptr<Parsed_File>>(parsed_content), arguments, out);
+}
+
+void Show_AR_File_Details(AR const& ar, Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    auto const& members = ar.Get_Members();
+
+    out << "Archive members: " << std::dec << members.size() << " entries" << std::hex << '\n';
+
+    Table_Writer table {
+        "Index",
+        "Offset",
+        "Size",
+        "Mode",
+        "Name"
+    };
+
+    int index = 0;
+
+    for (auto const& member: members)
+    {
+        table
+            .Decimal(index++)
+            .Hexadecimal(member.Offset)
+            .Decimal(member.Contents.size())
+            .Text(Get_Field_Text(member.Header->Mode, sizeof(member.Header->Mode)))
+            .Text(member.Name);
+    }
+
+    table.Print(out);
+
+    if (arguments.Get_Switch("--symbols"))
+        Show_AR_Symbol_Index(ar, out);
+    else
+        out << "Symbol index: " << std::dec << ar.Get_Symbols().size() << " entries" << std::hex << '\n' << '\n';
+
+    // An archive inside a batch shares the batch's workers.
+    Nested_Pool pool(arguments);
+
+    Write_Reports_In_Order(
+        *pool, members.size(),
+        [&](size_t index, std::ostream& report) -> int
+        {
+            try
+            {
+                Show_AR_Member_Details(members[index], index, arguments, report);
+            }
+            catch (std::exception const& e)
+            {
+                report << "Failed to analyze member " << members[index].Name << ": " << e.what() << '\n';
+            }
+
+            return 0;
+        },
+        out);
+}
@@ -0,0 +1,12 @@
+#ifndef AR_DUMPER_H__INCLUDED
+#define AR_DUMPER_H__INCLUDED
+
+#include <ostream>
+
+#include <ar/ar.h>
+
+#include "command-line-arguments.h"
+
+void Show_AR_File_Details(AR const& ar, Command_Line_Arguments const& arguments, std::ostream& out);
+
+#endif  // AR_DUMPER_H__INCLUDED
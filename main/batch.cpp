@@ -0,0 +1,197 @@
+#include "batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <include/work-stealing-pool.h>
+
+#include "columnar-dumper.h"
+#include "command-line-arguments.h"
+#include "file-details.h"
+
+namespace fs = std::filesystem;
+
+using std::string;
+using std::string_view;
+
+bool Is_Batch_Invocation(Command_Line_Arguments const& arguments)
+{
+    if (!arguments.Get_Parameter("--manifest").empty())
+        return true;
+
+    if (arguments.Standalone().size() > 1)
+        return true;
+
+    std::error_code error;
+
+    return (!arguments.Standalone().empty() && fs::is_directory(arguments.Standalone()[0], error));
+}
+
+static void Collect_Directory(string const& directory, std::vector<string>& inputs, std::ostream& out)
+{
+    std::vector<string> files;
+    std::error_code error;
+
+    auto const options = fs::directory_options::skip_permission_denied;
+
+    for (auto it = fs::recursive_directory_iterator(directory, options, error);
+         !error && (it != fs::recursive_directory_iterator());
+         it.increment(error))
+    {
+        std::error_code status_error;
+
+        if (it->is_regular_file(status_error))
+            files.push_back(it->path().string());
+    }
+
+    if (error)
+        out << "Could not list directory " << directory << ": " << error.message() << '\n';
+
+    // Directory order is up to the filesystem; sort so that reruns match.
+    std::sort(files.begin(), files.end());
+
+    inputs.insert(inputs.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+}
+
+static void Collect_Manifest(std::istream& manifest, std::vector<string>& inputs)
+{
+    string line;
+
+    while (std::getline(manifest, line))
+    {
+        if (!line.empty() && (line.back() == '\r'))
+            line.pop_back();
+
+        if (line.empty() || (line[0] == '#'))
+            continue;
+
+        inputs.push_back(std::move(line));
+    }
+}
+
+std::vector<string> Collect_Batch_Inputs(Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    std::vector<string> inputs;
+
+    for (auto const& path: arguments.Standalone())
+    {
+        std::error_code error;
+
+        if (fs::is_directory(path, error))
+            Collect_Directory(path, inputs, out);
+        else
+            inputs.push_back(path);
+    }
+
+    if (auto const manifest_name = arguments.Get_Parameter("--manifest");
+        !manifest_name.empty())
+    {
+        if (manifest_name == "-")
+        {
+            Collect_Manifest(std::cin, inputs);
+        } else {
+            std::ifstream manifest(manifest_name);
+
+            if (manifest)
+                Collect_Manifest(manifest, inputs);
+            else
+                out << "Could not open manifest " << manifest_name << '\n';
+        }
+    }
+
+    return inputs;
+}
+
+size_t Get_Job_Count(Command_Line_Arguments const& arguments)
+{
+    auto const jobs = arguments.Get_Parameter("--jobs");
+    size_t job_count = 0;
+
+    std::from_chars(jobs.data(), jobs.data() + jobs.size(), job_count);
+
+    if (job_count == 0)
+        job_count = std::thread::hardware_concurrency();
+
+    return job_count;
+}
+
+Nested_Pool::Nested_Pool(Command_Line_Arguments const& arguments):
+    _pool{Work_Stealing_Pool::Current()}
+{
+    if (_pool == nullptr)
+    {
+        _own_pool = std::make_unique<Work_Stealing_Pool>(Get_Job_Count(arguments));
+        _pool = _own_pool.get();
+    }
+}
+
+int Write_Reports_In_Order(
+        Work_Stealing_Pool& pool,
+        size_t count,
+        std::function<int(size_t, std::ostream&)> const& report,
+        std::ostream& out)
+{
+    int result = 0;
+
+    Run_In_Order<std::pair<string, int>>(
+        pool, count,
+        [&](size_t index)
+        {
+            std::ostringstream text;
+            auto const code = report(index, text);
+
+            return std::pair{text.str(), code};
+        },
+        [&](size_t, std::pair<string, int>&& report)
+        {
+            out.write(report.first.data(), report.first.size());
+
+            if (report.second != 0)
+                result = 1;
+        });
+
+    return result;
+}
+
+int Run_Batch(Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    auto const inputs = Collect_Batch_Inputs(arguments, out);
+
+    if (Get_Output_Format(arguments) == Output_Format::Columnar)
+        return Write_Columnar_Output(inputs, arguments, out);
+
+    Work_Stealing_Pool pool(Get_Job_Count(arguments));
+
+    auto const result =
+        Write_Reports_In_Order(
+            pool, inputs.size(),
+            [&](size_t index, std::ostream& report) -> int
+            {
+                try
+                {
+                    return Report_File(inputs[index], arguments, report);
+                }
+                catch (std::exception const& e)
+                {
+                    report << "Failed to analyze " << inputs[index] << ": " << e.what() << '\n';
+                    return -4;
+                }
+            },
+            out);
+
+    out.flush();
+
+    return result;
+}
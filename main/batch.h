@@ -0,0 +1,106 @@
+#ifndef BATCH_H__INCLUDED
+#define BATCH_H__INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <include/work-stealing-pool.h>
+
+#include "command-line-arguments.h"
+
+//
+//  Batch mode: any invocation with more than one input, a directory, or a
+//  manifest file (--manifest, one path per line).  Files are dumped on a
+//  work-stealing pool and their reports are written in input order; with
+//  --format columnar they go into a single --output file instead.
+//
+bool Is_Batch_Invocation(Command_Line_Arguments const& arguments);
+
+std::vector<std::string> Collect_Batch_Inputs(Command_Line_Arguments const& arguments, std::ostream& out);
+
+int Run_Batch(Command_Line_Arguments const& arguments, std::ostream& out);
+
+// --jobs, or one job per hardware thread.
+size_t Get_Job_Count(Command_Line_Arguments const& arguments);
+
+//
+//  The pool for work nested inside one file's report: the batch pool when
+//  the caller runs on one, so nested work shares its workers, or else a
+//  pool of --jobs threads that lives as long as this object.  Waiting on
+//  the batch pool runs other tasks on the waiting thread, other files'
+//  reports included, so nothing that is shared between reports on one
+//  thread may be left half-done across a wait.
+//
+class Nested_Pool
+{
+    private:
+        std::unique_ptr<Work_Stealing_Pool> _own_pool;
+        Work_Stealing_Pool* _pool;
+
+    public:
+        explicit Nested_Pool(Command_Line_Arguments const& arguments);
+
+        Work_Stealing_Pool& operator*() const { return *_pool; }
+        Work_Stealing_Pool* operator->() const { return _pool; }
+};
+
+// How many results may be in flight per worker before the oldest is consumed.
+inline constexpr size_t Results_In_Flight_Per_Worker = 16;
+
+//
+//  Runs produce(index) for every index below count on the pool and hands
+//  each result to consume(index, result) on the calling thread, in index
+//  order, as soon as it and every result before it are ready.  Only a
+//  bounded window of results is in flight, so memory use does not grow
+//  with count.
+//
+template<typename Result, typename Produce, typename Consume>
+void Run_In_Order(Work_Stealing_Pool& pool, size_t count, Produce const& produce, Consume const& consume)
+{
+    std::vector<Result> results(count);
+    auto done = std::make_unique<std::atomic<bool>[]>(count);
+
+    auto submit = [&](size_t index)
+    {
+        pool.Submit([&, index]
+        {
+            results[index] = produce(index);
+            done[index].store(true, std::memory_order_release);
+        });
+    };
+
+    auto const window = pool.Thread_Count() * Results_In_Flight_Per_Worker;
+
+    for (size_t i = 0; i < std::min(window, count); ++i)
+        submit(i);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        pool.Wait_Until([&] { return done[i].load(std::memory_order_acquire); });
+
+        consume(i, std::move(results[i]));
+        results[i] = Result{};
+
+        if (i + window < count)
+            submit(i + window);
+    }
+}
+
+//
+//  Runs report(index, out) for every index below count on the pool and
+//  writes the reports to out in index order as they complete.  Returns 1 if
+//  any report returned non-zero, 0 otherwise.
+//
+int Write_Reports_In_Order(
+        Work_Stealing_Pool& pool,
+        size_t count,
+        std::function<int(size_t, std::ostream&)> const& report,
+        std::ostream& out);
+
+#endif  // BATCH_H__INCLUDED
@@ -0,0 +1,45 @@
+#include "byte-statistics.h"
+
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include <analysis/histogram.h>
+#include <include/work-stealing-pool.h>
+
+#include "batch.h"
+#include "command-line-arguments.h"
+
+// Below this much data one thread keeps up with memory on its own.
+static size_t const Parallel_Histogram_Threshold = size_t(64) << 20;
+
+Byte_Histogram Get_Byte_Histogram(std::string_view data, Command_Line_Arguments const& arguments)
+{
+    if (data.size() < Parallel_Histogram_Threshold)
+        return Compute_Byte_Histogram(data);
+
+    return Compute_Byte_Histogram(data, *Nested_Pool(arguments));
+}
+
+void Byte_Histogram_Set::Add(std::string_view data, Command_Line_Arguments const& arguments)
+{
+    if (data.size() >= Parallel_Histogram_Threshold)
+        _histograms.emplace_back(data, Get_Byte_Histogram(data, arguments));
+}
+
+Byte_Histogram Byte_Histogram_Set::Get(std::string_view data) const
+{
+    for (auto const& [range, histogram]: _histograms)
+        if ((range.data() == data.data()) && (range.size() == data.size()))
+            return histogram;
+
+    return Compute_Byte_Histogram(data);
+}
+
+std::string Format_Entropy(double entropy)
+{
+    char digits[16];
+    auto const result = std::to_chars(std::begin(digits), std::end(digits), entropy, std::chars_format::fixed, 3);
+
+    return std::string(digits, result.ptr);
+}
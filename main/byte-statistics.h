@@ -0,0 +1,40 @@
+#ifndef BYTE_STATISTICS_H__INCLUDED
+#define BYTE_STATISTICS_H__INCLUDED
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <analysis/histogram.h>
+
+#include "command-line-arguments.h"
+
+//
+//  --entropy: the byte histogram of a section or segment.  Ranges of many
+//  megabytes are counted in chunks on the current pool (or a pool of
+//  --jobs threads), so a multi-gigabyte section is not left to one core.
+//
+Byte_Histogram Get_Byte_Histogram(std::string_view data, Command_Line_Arguments const& arguments);
+
+//
+//  Histograms of the ranges large enough to be counted on the pool,
+//  computed ahead of time so that a JSON record can look them up instead
+//  of waiting on the pool while it is half-written.  Other ranges are
+//  counted on the calling thread when asked for.
+//
+class Byte_Histogram_Set
+{
+    private:
+        std::vector<std::pair<std::string_view, Byte_Histogram>> _histograms;
+
+    public:
+        void Add(std::string_view data, Command_Line_Arguments const& arguments);
+
+        Byte_Histogram Get(std::string_view data) const;
+};
+
+// Entropy with three decimals, as shown in the section tables.
+std::string Format_Entropy(double entropy);
+
+#endif  // BYTE_STATISTICS_H__INCLUDED
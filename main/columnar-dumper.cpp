@@ -0,0 +1,437 @@
+#include "columnar-dumper.h"
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include <ar/ar.h>
+#include <columnar/columnar.h>
+#include <columnar/writer.h>
+#include <elf/elf.h>
+#include <hash/digests.h>
+#include <include/file-format.h>
+#include <include/work-stealing-pool.h>
+#include <mz/mz.h>
+
+#include "batch.h"
+#include "command-line-arguments.h"
+#include "file-details.h"
+#include "fingerprint-dumper.h"
+#include "mapped-file.h"
+#include "table-writer.h"
+
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+
+using namespace Columnar;
+using namespace ELF_Format;
+
+enum Table: size_t
+{
+    Files_Table,
+    Segments_Table,
+    Sections_Table,
+    Imports_Table,
+    Import_Fingerprints_Table
+};
+
+static Schema const& Get_Output_Schema()
+{
+    static Schema const schema {
+        { "files", {
+            { "path",                   Column_Type::String },
+            { "container",              Column_Type::String },
+            { "size",                   Column_Type::U64 },
+            { "format",                 Column_Type::String },
+            { "error",                  Column_Type::String } } },
+
+        { "segments", {
+            { "file",                   Column_Type::Row_Id },
+            { "index",                  Column_Type::U32 },
+            { "type",                   Column_Type::U32 },
+            { "flags",                  Column_Type::U32 },
+            { "offset",                 Column_Type::U64 },
+            { "virtual_address",        Column_Type::U64 },
+            { "physical_address",       Column_Type::U64 },
+            { "size_in_file",           Column_Type::U64 },
+            { "size_in_memory",         Column_Type::U64 },
+            { "alignment",              Column_Type::U64 } } },
+
+        //
+        //  ELF and PE sections share a table.  For PE sections the type is
+        //  0, the flags are the section characteristics and the size is the
+        //  size of the raw data.
+        //
+        { "sections", {
+            { "file",                   Column_Type::Row_Id },
+            { "index",                  Column_Type::U32 },
+            { "name",                   Column_Type::String },
+            { "type",                   Column_Type::U32 },
+            { "flags",                  Column_Type::U64 },
+            { "virtual_address",        Column_Type::U64 },
+            { "offset",                 Column_Type::U64 },
+            { "size",                   Column_Type::U64 } } },
+
+        // PE import table entries, and undefined ELF dynamic symbols.
+        { "imports", {
+            { "file",                   Column_Type::Row_Id },
+            { "library",                Column_Type::String },
+            { "function",               Column_Type::String },
+            { "ordinal",                Column_Type::U32 },
+            { "hint",                   Column_Type::U32 } } },
+
+        // --imphash: the import hash of a PE file, or the symbol hash of an ELF file.
+        { "import_fingerprints", {
+            { "file",                   Column_Type::Row_Id },
+            { "kind",                   Column_Type::String },
+            { "md5",                    Column_Type::String },
+            { "count",                  Column_Type::U32 } } }
+    };
+
+    return schema;
+}
+
+// How many input files go into one row group.
+static size_t const Files_Per_Row_Group = 4096;
+
+template<typename Layout>
+static void Add_ELF_Rows(
+        ELF_File<Layout> const& elf, uint32_t file,
+        Command_Line_Arguments const& arguments,
+        Row_Group_Builder& rows)
+{
+    uint32_t index = 0;
+
+    for (auto const& entry: elf.Get_Program_Header_Table())
+    {
+        rows.Row(Segments_Table)
+            .Number(file)
+            .Number(index++)
+            .Number(entry.Type)
+            .Number(entry.Flags)
+            .Number(entry.Segment_Offset)
+            .Number(entry.Virtual_Address)
+            .Number(entry.Physical_Address)
+            .Number(entry.Size_In_File)
+            .Number(entry.Size_In_Memory)
+            .Number(entry.Alignment);
+    }
+
+    index = 0;
+
+    for (auto const& entry: elf.Get_Section_Header_Table())
+    {
+        rows.Row(Sections_Table)
+            .Number(file)
+            .Number(index++)
+            .String(elf.Get_Section_Name(entry))
+            .Number(entry.Type)
+            .Number(entry.Flags)
+            .Number(entry.Virtual_Address)
+            .Number(entry.Segment_Offset)
+            .Number(entry.Size);
+    }
+
+    if (!arguments.Get_Switch("--imports"))
+        return;
+
+    if (auto const* symbols = elf.Get_Dynamic_Symbol_Table())
+    {
+        for (auto const& symbol: *symbols)
+        {
+            auto const name = symbols->Get_Name(symbol);
+
+            if ((symbol.Section_Index != 0) || name.empty())
+                continue;
+
+            rows.Row(Imports_Table).Number(file).String({}).String(name).Number(0).Number(0);
+        }
+    }
+}
+
+static void Add_MZ_Rows(
+        MZ const& mz, uint32_t file,
+        Command_Line_Arguments const& arguments,
+        Row_Group_Builder& rows)
+{
+    for (uint16_t i = 0; i < mz.Get_Number_of_Sections(); ++i)
+    {
+        auto const& sh = mz.Get_Section_Header(i);
+
+        rows.Row(Sections_Table)
+            .Number(file)
+            .Number(i)
+            .String(mz.Get_Section_Name(sh))
+            .Number(0)
+            .Number(uint32_t(sh.Characteristics))
+            .Number(sh.Virtual_Address)
+            .Number(sh.Pointer_To_Raw_Data)
+            .Number(sh.Size_Of_Raw_Data);
+    }
+
+    if (!arguments.Get_Switch("--imports"))
+        return;
+
+    for (auto const& library: mz.Get_Imports())
+    {
+        for (auto const& function: library.Functions)
+        {
+            if (function.By_Ordinal)
+            {
+                rows.Row(Imports_Table).Number(file).String(library.Name).String({}).Number(function.Ordinal).Number(0);
+            } else {
+                rows.Row(Imports_Table)
+                    .Number(file)
+                    .String(library.Name)
+                    .String(function.Name)
+                    .Number(0)
+                    .Number(function.Hint);
+            }
+        }
+    }
+}
+
+//
+//  Adds the file's row, then its segments, sections and imports.  Archive
+//  members are added after the archive, each as a file of its own.  Returns
+//  0 or the same error codes as Report_File.
+//
+static int Add_File_Rows(
+        string_view path, string_view container, string_view contents,
+        Command_Line_Arguments const& arguments,
+        Row_Group_Builder& rows)
+{
+    auto const file = uint32_t(rows.Get_Row_Count(Files_Table));
+
+    try
+    {
+        auto parsed_content = Parse(contents);
+
+        if (parsed_content.index() == 0)
+        {
+            rows.Row(Files_Table)
+                .String(path)
+                .String(container)
+                .Number(contents.size())
+                .String(Get_File_Format_Name(File_Format::Unknown))
+                .String("Could not understand the format.");
+
+            return -3;
+        }
+
+        auto const& parsed_file = *std::get<unique_ptr<Parsed_File>>(parsed_content);
+        auto const file_format = parsed_file.Get_File_Format();
+
+        rows.Row(Files_Table)
+            .String(path)
+            .String(container)
+            .Number(contents.size())
+            .String(Get_File_Format_Name(file_format))
+            .String({});
+
+        switch (file_format)
+        {
+            case File_Format::ELF_Executable:
+            case File_Format::ELF_Object:
+            case File_Format::ELF_Shared_Object:
+            case File_Format::ELF_Core_Dump:
+            case File_Format::ELF64_Executable:
+            case File_Format::ELF64_Object:
+            case File_Format::ELF64_Shared_Object:
+            case File_Format::ELF64_Core_Dump:
+                Visit(
+                    static_cast<ELF const&>(parsed_file),
+                    [&](auto const& elf) { Add_ELF_Rows(elf, file, arguments, rows); });
+                break;
+
+            case File_Format::MZ_Executable:
+            case File_Format::MZ_Object:
+            case File_Format::MZ_DLL:
+            case File_Format::MZ_Library:
+                Add_MZ_Rows(static_cast<MZ const&>(parsed_file), file, arguments, rows);
+                break;
+
+            case File_Format::AR_Arch:
+                for (auto const& member: static_cast<AR const&>(parsed_file).Get_Members())
+                {
+                    auto const label = string(path) + '(' + string(member.Name) + ')';
+                    Add_File_Rows(label, path, member.Contents, arguments, rows);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if (arguments.Get_Switch("--imphash"))
+        {
+            if (auto const fingerprint = Get_Import_Fingerprint(parsed_file))
+            {
+                rows.Row(Import_Fingerprints_Table)
+                    .Number(file)
+                    .String(fingerprint->Kind)
+                    .String(To_Hex(fingerprint->Digest))
+                    .Number(fingerprint->Count);
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        // Rows added before the failure stay; the file row records the error.
+        if (rows.Get_Row_Count(Files_Table) == file)
+        {
+            rows.Row(Files_Table)
+                .String(path)
+                .String(container)
+                .Number(contents.size())
+                .String(Get_File_Format_Name(File_Format::Unknown))
+                .String(e.what());
+        }
+
+        return -4;
+    }
+
+    return 0;
+}
+
+int Write_Columnar_Output(
+        std::vector<string> const& inputs,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out)
+{
+    auto const output_name = string(arguments.Get_Parameter("--output"));
+
+    if (output_name.empty())
+    {
+        out << "The columnar format needs an --output file." << '\n';
+        return 1;
+    }
+
+    auto const& schema = Get_Output_Schema();
+    auto writer = unique_ptr<Columnar_Writer>(Columnar_Writer::Create(output_name, schema));
+
+    if (!writer)
+    {
+        out << "Could not create " << output_name << ": " << std::strerror(errno) << '\n';
+        return 1;
+    }
+
+    struct File_Rows
+    {
+        unique_ptr<Row_Group_Builder> Rows;
+        int Result;
+    };
+
+    Work_Stealing_Pool pool(Get_Job_Count(arguments));
+    int result = 0;
+
+    Run_In_Order<File_Rows>(
+        pool, inputs.size(),
+        [&](size_t index)
+        {
+            auto rows = std::make_unique<Row_Group_Builder>(schema);
+            auto const& path = inputs[index];
+            auto mapped_file = unique_ptr<Mapped_File>(Mapped_File::Open(path));
+
+            if (!mapped_file)
+            {
+                rows->Row(Files_Table)
+                    .String(path)
+                    .String({})
+                    .Number(0)
+                    .String(Get_File_Format_Name(File_Format::Unknown))
+                    .String(std::strerror(errno));
+
+                return File_Rows{std::move(rows), -2};
+            }
+
+            auto const code = Add_File_Rows(path, {}, mapped_file->contents(), arguments, *rows);
+
+            return File_Rows{std::move(rows), code};
+        },
+        [&](size_t index, File_Rows&& file_rows)
+        {
+            writer->Append(*file_rows.Rows);
+
+            if (file_rows.Result != 0)
+                result = 1;
+
+            if (((index + 1) % Files_Per_Row_Group) == 0)
+                writer->Flush_Row_Group();
+        });
+
+    if (!writer->Close())
+    {
+        out << "Could not write " << output_name << ": " << std::strerror(errno) << '\n';
+        return 1;
+    }
+
+    return result;
+}
+
+static string_view Get_Column_Type_Name(Column_Type type)
+{
+    switch (type)
+    {
+        case Column_Type::U8:       return "u8";
+        case Column_Type::U16:      return "u16";
+        case Column_Type::U32:      return "u32";
+        case Column_Type::U64:      return "u64";
+        case Column_Type::String:   return "string";
+        case Column_Type::Row_Id:   return "row_id";
+        default:                    return "??";
+    }
+}
+
+void Show_Columnar_File_Details(Columnar_File const& file, Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    out
+        << "Row groups: " << std::dec << file.Row_Group_Count()
+        << ", strings: " << file.String_Count() << std::hex << '\n';
+
+    Table_Writer tables {
+        "Table",
+        "Columns",
+        "Rows"
+    };
+
+    for (size_t table = 0; table < file.Table_Count(); ++table)
+    {
+        tables
+            .Text(file.Get_Table_Name(table))
+            .Decimal(file.Get_Column_Count(table))
+            .Decimal(file.Get_Row_Count(table));
+    }
+
+    tables.Print(out);
+
+    if (!arguments.Get_Switch("--verbose"))
+        return;
+
+    for (size_t table = 0; table < file.Table_Count(); ++table)
+    {
+        out << "Table " << file.Get_Table_Name(table) << ":" << '\n';
+
+        Table_Writer columns {
+            "Index",
+            "Name",
+            "Type"
+        };
+
+        for (size_t column = 0; column < file.Get_Column_Count(table); ++column)
+        {
+            columns
+                .Decimal(column)
+                .Text(file.Get_Column_Name(table, column))
+                .Text(Get_Column_Type_Name(file.Get_Column_Type(table, column)));
+        }
+
+        columns.Print(out);
+    }
+}
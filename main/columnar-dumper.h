@@ -0,0 +1,25 @@
+#ifndef COLUMNAR_DUMPER_H__INCLUDED
+#define COLUMNAR_DUMPER_H__INCLUDED
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <columnar/columnar.h>
+
+#include "command-line-arguments.h"
+
+//
+//  --format columnar: parses every input on the batch pool and writes one
+//  columnar file (--output) with "files", "segments", "sections" and
+//  "imports" tables.  Archive members are rows of their own in "files".
+//  Returns 0 on success and 1 if any input could not be read or understood.
+//
+int Write_Columnar_Output(
+        std::vector<std::string> const& inputs,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out);
+
+void Show_Columnar_File_Details(Columnar::Columnar_File const& file, Command_Line_Arguments const& arguments, std::ostream& out);
+
+#endif  // COLUMNAR_DUMPER_H__INCLUDED
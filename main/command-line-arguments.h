@@ -154,6 +154,15 @@ class Command_Line_Arguments
 
             return false;
         }
+
+        string Get_Parameter(string_view name) const
+        {
+            for (auto const& p: Parameters())
+                if ((p.Short_Name() == name) || (p.Long_Name() == name))
+                    return p;
+
+            return string{};
+        }
 };
 
 #endif  // COMMAND_LINE_ARGUMENTS__INCLUDED
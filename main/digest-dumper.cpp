@@ -0,0 +1,190 @@
+#include "digest-dumper.h"
+
+#include <atomic>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <elf/elf.h>
+#include <hash/digests.h>
+#include <include/file-format.h>
+#include <include/work-stealing-pool.h>
+#include <mz/mz.h>
+
+#include "batch.h"
+#include "command-line-arguments.h"
+#include "json-writer.h"
+#include "table-writer.h"
+
+using std::string_view;
+
+using namespace ELF_Format;
+
+// Below this much data, handing regions to other threads costs more than it saves.
+static uint64_t const Parallel_Hashing_Threshold = 8 << 20;
+
+template<typename Layout>
+static void Add_ELF_Regions(ELF_File<Layout> const& elf, std::vector<Hashed_Region>& regions)
+{
+    uint32_t index = 0;
+
+    for (auto const& entry: elf.Get_Program_Header_Table())
+    {
+        regions.push_back(
+            Hashed_Region {
+                "segment", index++, Get_Segment_Type_Name(entry.Type),
+                entry.Segment_Offset, elf.Get_Range(entry.Segment_Offset, entry.Size_In_File) });
+    }
+
+    index = 0;
+
+    for (auto const& entry: elf.Get_Section_Header_Table())
+    {
+        auto const section_index = index++;
+
+        if ((Section_Type(uint32_t(entry.Type)) == Section_Type::No_Bits) ||
+            (Section_Type(uint32_t(entry.Type)) == Section_Type::Null))
+            continue;
+
+        regions.push_back(
+            Hashed_Region {
+                "section", section_index, elf.Get_Section_Name(entry),
+                entry.Segment_Offset, elf.Get_Range(entry.Segment_Offset, entry.Size) });
+    }
+}
+
+static void Add_MZ_Regions(MZ const& mz, std::vector<Hashed_Region>& regions)
+{
+
+    for (uint16_t i = 0; i < mz.Get_Number_of_Sections(); ++i)
+    {
+        auto const& sh = mz.Get_Section_Header(i);
+
+        if (!MZ::Has_File_Data(sh))
+            continue;
+
+        regions.push_back(
+            Hashed_Region {
+                "section", i, mz.Get_Section_Name(sh),
+                sh.Pointer_To_Raw_Data, mz.Get_Range(sh.Pointer_To_Raw_Data, sh.Size_Of_Raw_Data) });
+    }
+}
+
+std::vector<Hashed_Region> Get_Hashed_Regions(Parsed_File const& parsed_file)
+{
+    std::vector<Hashed_Region> regions;
+
+    regions.push_back(Hashed_Region { "file", 0, {}, 0, parsed_file.buffer() });
+
+    switch (parsed_file.Get_File_Format())
+    {
+        case File_Format::ELF_Executable:
+        case File_Format::ELF_Object:
+        case File_Format::ELF_Shared_Object:
+        case File_Format::ELF_Core_Dump:
+        case File_Format::ELF64_Executable:
+        case File_Format::ELF64_Object:
+        case File_Format::ELF64_Shared_Object:
+        case File_Format::ELF64_Core_Dump:
+            Visit(
+                static_cast<ELF const&>(parsed_file),
+                [&](auto const& elf) { Add_ELF_Regions(elf, regions); });
+            break;
+
+        case File_Format::MZ_Executable:
+        case File_Format::MZ_Object:
+        case File_Format::MZ_DLL:
+        case File_Format::MZ_Library:
+            Add_MZ_Regions(static_cast<MZ const&>(parsed_file), regions);
+            break;
+
+        default:
+            break;
+    }
+
+    return regions;
+}
+
+void Compute_Region_Digests(std::vector<Hashed_Region>& regions, Command_Line_Arguments const& arguments)
+{
+    uint64_t total_size = 0;
+
+    for (auto const& region: regions)
+        total_size += region.Contents.size();
+
+    if ((regions.size() < 2) || (total_size < Parallel_Hashing_Threshold))
+    {
+        for (auto& region: regions)
+            region.Result = Compute_Digests(region.Contents);
+
+        return;
+    }
+
+    Nested_Pool pool(arguments);
+
+    std::atomic<size_t> remaining = regions.size();
+
+    for (auto& region: regions)
+    {
+        pool->Submit([&region, &remaining]
+        {
+            region.Result = Compute_Digests(region.Contents);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    pool->Wait_Until([&] { return remaining.load(std::memory_order_acquire) == 0; });
+}
+
+void Show_Digests(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    auto regions = Get_Hashed_Regions(parsed_file);
+    Compute_Region_Digests(regions, arguments);
+
+    out << "Digests:" << '\n';
+
+    Table_Writer table {
+        "Region",
+        "Index",
+        "Name",
+        "Offset",
+        "Size",
+        "XXH64",
+        "SHA-256"
+    };
+
+    for (auto const& region: regions)
+    {
+        table
+            .Text(region.Kind)
+            .Decimal(region.Index)
+            .Text(region.Name)
+            .Hexadecimal(region.Offset)
+            .Decimal(region.Contents.size())
+            .Text(To_Hex(region.Result.XXH64))
+            .Text(To_Hex(region.Result.SHA256));
+    }
+
+    table.Print(out);
+}
+
+void Write_Digests_JSON(std::vector<Hashed_Region> const& regions, JSON_Writer& json)
+{
+    json.Key("digests").Begin_Array();
+
+    for (auto const& region: regions)
+    {
+        json
+            .Begin_Object()
+            .Field("region", region.Kind)
+            .Field("index", region.Index)
+            .Field("name", region.Name)
+            .Field("offset", region.Offset)
+            .Field("size", region.Contents.size())
+            .Field("xxh64", To_Hex(region.Result.XXH64))
+            .Field("sha256", To_Hex(region.Result.SHA256))
+            .End_Object();
+    }
+
+    json.End_Array();
+}
@@ -0,0 +1,45 @@
+#ifndef DIGEST_DUMPER_H__INCLUDED
+#define DIGEST_DUMPER_H__INCLUDED
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <hash/digests.h>
+#include <include/file-format.h>
+
+#include "command-line-arguments.h"
+#include "json-writer.h"
+
+//
+//  A range of the file that gets its own digests: the whole file, an ELF
+//  segment, or an ELF or PE section.  Sections without file contents
+//  (.bss and the like) are left out.
+//
+struct Hashed_Region
+{
+    std::string_view Kind;
+    uint32_t Index;
+    std::string_view Name;
+    uint64_t Offset;
+    std::string_view Contents;
+    Digests Result {};
+};
+
+std::vector<Hashed_Region> Get_Hashed_Regions(Parsed_File const& parsed_file);
+
+//
+//  Fills in the digests of every region.  Regions are hashed in parallel
+//  on the current pool (or a pool of --jobs threads) once there is enough
+//  data to be worth it; each region is a single pass either way.
+//
+void Compute_Region_Digests(std::vector<Hashed_Region>& regions, Command_Line_Arguments const& arguments);
+
+// --hashes: a table of XXH64 and SHA-256 digests per region.
+void Show_Digests(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, std::ostream& out);
+
+// The same as JSON, from regions whose digests are already computed.
+void Write_Digests_JSON(std::vector<Hashed_Region> const& regions, JSON_Writer& json);
+
+#endif  // DIGEST_DUMPER_H__INCLUDED
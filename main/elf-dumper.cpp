@@ -1,239 +1,398 @@
 #include "elf-dumper.h"
 
+#include <charconv>
 #include <cstdint>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
-#include <string>
-#include <vector>
+#include <ostream>
+#include <string_view>
 
 #include <elf/elf.h>
 
+#include "byte-statistics.h"
+#include "command-line-arguments.h"
+#include "digest-dumper.h"
+#include "fingerprint-dumper.h"
+#include "signature-dumper.h"
+#include "strings-dumper.h"
+#include "table-writer.h"
 
-template<typename T>
-string Integer_As_Decimal_String(T value)
+using namespace ELF_Format;
+
+template<typename Layout>
+static void Show_ELF_Symbol_Table(Symbol_Table<Layout> const& symbols, string_view title, std::ostream& out);
+
+template<typename Layout>
+static void Show_ELF_Symbolized_Addresses(ELF_File<Layout> const& elf, string_view addresses, std::ostream& out);
+
+template<typename Layout>
+static void Show_ELF_Dynamic_Section(ELF_File<Layout> const& elf, std::ostream& out);
+
+template<typename Layout>
+static void Show_ELF_Dynamic_Lookups(ELF_File<Layout> const& elf, string_view names, std::ostream& out);
+
+template<typename Layout>
+static void Show_ELF_File_Details(ELF_File<Layout> const& elf, Command_Line_Arguments const& arguments, std::ostream& out)
 {
-    std::ostringstream stream;
+    auto elf_header = elf.Get_Header();
+
+    out
+        << "ELF header values:\n"
+        << "  Machine: " << elf_header.Machine << "\n"
+        << "  Version: " << elf_header.Version << "\n"
+        << "  Entry_Point: " << elf_header.Entry_Point << "\n"
+        << "  Program_Header_Offset: " << elf_header.Program_Header_Offset << "\n"
+        << "  Section_Header_Offset: " << elf_header.Section_Header_Offset << "\n"
+        << "  Flags: " << elf_header.Flags << "\n"
+        << "  ELF_Header_Size: " << elf_header.ELF_Header_Size << "\n"
+        << "  Program_Header_Entry_Size: " << elf_header.Program_Header_Entry_Size << "\n"
+        << "  Program_Header_Entry_Count: " << elf_header.Program_Header_Entry_Count << "\n"
+        << "  Section_Header_Entry_Size: " << elf_header.Section_Header_Entry_Size << "\n"
+        << "  Section_Header_Entry_Count: " << elf_header.Section_Header_Entry_Count << "\n"
+        << "  Section_Header_String_Table_Index: " << elf_header.Section_Header_String_Table_Index << "\n"
+        << '\n';
+
+    Table_Writer raw_segments {
+        "Index",
+        "Type",
+        "Flags",
+        "Segment_Offset",
+        "Virtual_Address",
+        "Physical_Address",
+        "Size_In_File",
+        "Size_In_Memory",
+        "Alignment"
+    };
+
+    Table_Writer segments {
+        "Index",
+        "Type",
+        "Flags",
+        "Segment_Offset",
+        "Virtual_Address",
+        "Physical_Address",
+        "Size_In_File",
+        "Size_In_Memory",
+        "Alignment"
+    };
+
+    bool const entropy = arguments.Get_Switch("--entropy");
+
+    if (entropy)
+        segments.Add_Field("Entropy");
+
+    int index = 0;
 
-    stream << std::dec << value;
+    for (auto const& entry: elf.Get_Program_Header_Table())
+    {
+        raw_segments
+            .Decimal(index)
+            .Hexadecimal(entry.Type)
+            .Hexadecimal(entry.Flags)
+            .Hexadecimal(entry.Segment_Offset)
+            .Hexadecimal(entry.Virtual_Address)
+            .Hexadecimal(entry.Physical_Address)
+            .Hexadecimal(entry.Size_In_File)
+            .Hexadecimal(entry.Size_In_Memory)
+            .Hexadecimal(entry.Alignment);
+
+        segments
+            .Decimal(index)
+            .Text(Get_Segment_Type_Name(entry.Type))
+            .Text(Get_Segment_Flag_Names(entry.Flags))
+            .Hexadecimal(entry.Segment_Offset)
+            .Hexadecimal(entry.Virtual_Address)
+            .Hexadecimal(entry.Physical_Address)
+            .Hexadecimal(entry.Size_In_File)
+            .Hexadecimal(entry.Size_In_Memory)
+            .Hexadecimal(entry.Alignment);
+
+        if (entropy)
+        {
+            auto const histogram = Get_Byte_Histogram(elf.Get_Range(entry.Segment_Offset, entry.Size_In_File), arguments);
+            segments.Text(Format_Entropy(Get_Entropy(histogram)));
+        }
 
-    return stream.str();
+        ++index;
+    }
+
+    raw_segments.Print(out);
+    segments.Print(out);
+
+    Table_Writer raw_sections {
+        "Index",
+        "Name",
+        "Type",
+        "Flags",
+        "Virtual_Address",
+        "Segment_Offset",
+        "Size",
+        "Link",
+        "Info",
+        "Address_Alignment",
+        "Entry_Size"
+    };
+
+    Table_Writer sections {
+        "Index",
+        "Name",
+        "Type",
+        "Flags",
+        "Virtual_Address",
+        "Segment_Offset",
+        "Size",
+        "Link",
+        "Info",
+        "Address_Alignment",
+        "Entry_Size"
+    };
+
+    if (entropy)
+        sections.Add_Field("Entropy");
+
+    index = 0;
+
+    for (auto const& entry: elf.Get_Section_Header_Table())
+    {
+        raw_sections
+            .Decimal(index)
+            .Decimal(entry.Name)
+            .Hexadecimal(entry.Type)
+            .Hexadecimal(entry.Flags)
+            .Hexadecimal(entry.Virtual_Address)
+            .Hexadecimal(entry.Segment_Offset)
+            .Decimal(entry.Size)
+            .Decimal(entry.Link)
+            .Decimal(entry.Info)
+            .Hexadecimal(entry.Address_Alignment)
+            .Decimal(entry.Entry_Size);
+
+        sections
+            .Decimal(index)
+            .Text(elf.Get_Section_Name(entry))
+            .Text(Get_Section_Type_Name(entry.Type))
+            .Text(Get_Section_Flag_Names(entry.Flags))
+            .Hexadecimal(entry.Virtual_Address)
+            .Hexadecimal(entry.Segment_Offset)
+            .Decimal(entry.Size)
+            .Decimal(entry.Link)
+            .Decimal(entry.Info)
+            .Hexadecimal(entry.Address_Alignment)
+            .Decimal(entry.Entry_Size);
+
+        if (entropy)
+        {
+            // Sections without file contents (.bss) have nothing to count.
+            auto const contents =
+                (Section_Type(uint32_t(entry.Type)) == Section_Type::No_Bits)
+                    ? string_view{}
+                    : elf.Get_Range(entry.Segment_Offset, entry.Size);
+
+            sections.Text(Format_Entropy(Get_Entropy(Get_Byte_Histogram(contents, arguments))));
+        }
+
+        ++index;
+    }
+
+    raw_sections.Print(out);
+    sections.Print(out);
+
+    if (arguments.Get_Switch("--symbols"))
+    {
+        if (auto const* symbols = elf.Get_Symbol_Table())
+            Show_ELF_Symbol_Table(*symbols, "Symbol table (.symtab)", out);
+
+        if (auto const* symbols = elf.Get_Dynamic_Symbol_Table())
+            Show_ELF_Symbol_Table(*symbols, "Dynamic symbol table (.dynsym)", out);
+    }
+
+    if (auto const addresses = arguments.Get_Parameter("--symbolize"); !addresses.empty())
+        Show_ELF_Symbolized_Addresses(elf, addresses, out);
+
+    if (arguments.Get_Switch("--dynamic"))
+        Show_ELF_Dynamic_Section(elf, out);
+
+    if (auto const names = arguments.Get_Parameter("--lookup"); !names.empty())
+        Show_ELF_Dynamic_Lookups(elf, names, out);
+
+    if (arguments.Get_Switch("--hashes"))
+        Show_Digests(elf, arguments, out);
+
+    if (arguments.Get_Switch("--imphash"))
+        Show_Import_Fingerprint(elf, out);
+
+    if (arguments.Get_Switch("--strings"))
+        Show_Strings(elf, out);
+
+    Show_Signature_Matches(elf, arguments, out);
 }
 
-template<typename T>
-string Integer_As_Hexadecimal_String(T value)
+template<typename Layout>
+static void Show_ELF_Symbol_Table(Symbol_Table<Layout> const& symbols, string_view title, std::ostream& out)
 {
-    std::ostringstream stream;
+    out << title << ": " << std::dec << symbols.size() << " entries" << std::hex << '\n';
+
+    Table_Writer table {
+        "Index",
+        "Value",
+        "Size",
+        "Type",
+        "Binding",
+        "Section_Index",
+        "Name"
+    };
 
-    stream << std::hex << value;
+    int index = 0;
 
-    return stream.str();
+    for (auto const& symbol: symbols)
+    {
+        table
+            .Decimal(index++)
+            .Hexadecimal(symbol.Value)
+            .Decimal(symbol.Size)
+            .Text(Get_Symbol_Type_Name(Get_Symbol_Type(symbol)))
+            .Text(Get_Symbol_Binding_Name(Get_Symbol_Binding(symbol)))
+            .Decimal(symbol.Section_Index)
+            .Text(symbols.Get_Name(symbol));
+    }
+
+    table.Print(out);
 }
 
-template<typename Element>
-void Prepare_Table(
-        array_view<Element const> table,
-        std::vector<std::vector<string>>& matrix,
-        std::vector<string> const& field_names,
-        std::function<std::vector<string>(int, Element const&)> transform)
+//
+//  addresses is a comma-separated list of hexadecimal addresses, with or
+//  without a 0x prefix.
+//
+template<typename Layout>
+static void Show_ELF_Symbolized_Addresses(ELF_File<Layout> const& elf, string_view addresses, std::ostream& out)
 {
-    matrix.clear();
-    matrix.reserve(table.size());
+    out << "Symbolized addresses:" << '\n';
 
-    size_t field_count = field_names.size();
+    while (!addresses.empty())
+    {
+        auto const comma = addresses.find(',');
+        auto text = addresses.substr(0, comma);
+        addresses = (comma == string_view::npos) ? string_view{} : addresses.substr(comma + 1);
 
-    matrix.push_back(field_names);
-    matrix.push_back(std::vector<string>(field_count));
+        if (text.starts_with("0x") || text.starts_with("0X"))
+            text.remove_prefix(2);
 
-    for (size_t i = 0; i < field_count; ++i)
-        matrix[1][i].assign(matrix[0][i].length(), '-');
+        uint64_t address = 0;
 
-    int index = 0;
+        if (std::from_chars(text.data(), text.data() + text.size(), address, 16).ec != std::errc{})
+            continue;
 
-    for (auto const& entry: table)
-        matrix.push_back(std::move(transform(index++, entry)));
-}
+        out << "  0x" << std::hex << address << ": ";
 
-void Print_Table(std::vector<std::vector<string>> const& table)
-{
-    std::vector<size_t> field_lengths(table[0].size(), 0);
+        Symbol_Table<Layout> const* tables[] = { elf.Get_Symbol_Table(), elf.Get_Dynamic_Symbol_Table() };
+        bool found = false;
 
-    for (auto const& entry: table)
-        for (int i = 0; i < field_lengths.size(); ++i)
-            field_lengths[i] = std::max(field_lengths[i], entry[i].length() + 1);
+        for (auto const* symbols: tables)
+        {
+            Symbol<Layout> const* symbol = symbols ? symbols->Find_By_Address(address) : nullptr;
 
-    for (auto const& entry: table)
-    {
-        for (int i = 0; i < field_lengths.size(); ++i)
-            std::cout << std::setw(field_lengths[i]) << entry[i];
+            if (symbol == nullptr)
+                continue;
+
+            out << symbols->Get_Name(*symbol) << "+0x" << (address - symbol->Value);
+            found = true;
+            break;
+        }
 
-        std::cout << std::endl;
+        if (!found)
+            out << "??";
+
+        out << '\n';
     }
 
-    std::cout << std::endl;
+    out << '\n';
 }
 
-void Show_ELF_File_Details(ELF64::ELF64 const& elf)
+template<typename Layout>
+static void Show_ELF_Dynamic_Section(ELF_File<Layout> const& elf, std::ostream& out)
 {
-    auto elf_header = elf.Get_Header();
+    auto const entries = elf.Get_Dynamic_Table();
 
-    std::cout
-        << "ELF header values:\n"
-        << "  Machine: " << elf_header.Machine << "\n"
-        << "  Version: " << elf_header.Version << "\n"
-        << "  Entry_Point: " << elf_header.Entry_Point << "\n"
-        << "  Program_Header_Offset: " << elf_header.Program_Header_Offset << "\n"
-        << "  Section_Header_Offset: " << elf_header.Section_Header_Offset << "\n"
-        << "  Flags: " << elf_header.Flags << "\n"
-        << "  ELF_Header_Size: " << elf_header.ELF_Header_Size << "\n"
-        << "  Program_Header_Entry_Size: " << elf_header.Program_Header_Entry_Size << "\n"
-        << "  Program_Header_Entry_Count: " << elf_header.Program_Header_Entry_Count << "\n"
-        << "  Section_Header_Entry_Size: " << elf_header.Section_Header_Entry_Size << "\n"
-        << "  Section_Header_Entry_Count: " << elf_header.Section_Header_Entry_Count << "\n"
-        << std::endl;
-
-    std::vector<std::vector<string>> table;
-
-    Prepare_Table<ELF64::Program_Header_Entry>(
-        elf.Get_Program_Header_Table(),
-        table,
-        std::vector<string> {
-            "Index",
-            "Type",
-            "Flags",
-            "Segment_Offset",
-            "Virtual_Address",
-            "Physical_Address",
-            "Size_In_File",
-            "Size_In_Memory",
-            "Alignment"
-        },
-        [](int index, ELF64::Program_Header_Entry const& entry) -> std::vector<string>
-        {
-            return std::vector<string> {
-                Integer_As_Decimal_String(index),
-                Integer_As_Hexadecimal_String(entry.Type),
-                Integer_As_Hexadecimal_String(entry.Flags),
-                Integer_As_Hexadecimal_String(entry.Segment_Offset),
-                Integer_As_Hexadecimal_String(entry.Virtual_Address),
-                Integer_As_Hexadecimal_String(entry.Physical_Address),
-                Integer_As_Hexadecimal_String(entry.Size_In_File),
-                Integer_As_Hexadecimal_String(entry.Size_In_Memory),
-                Integer_As_Hexadecimal_String(entry.Alignment)
-            };
-        });
-
-    Print_Table(table);
-
-    Prepare_Table<ELF64::Program_Header_Entry>(
-        elf.Get_Program_Header_Table(),
-        table,
-        std::vector<string> {
-            "Index",
-            "Type",
-            "Flags",
-            "Segment_Offset",
-            "Virtual_Address",
-            "Physical_Address",
-            "Size_In_File",
-            "Size_In_Memory",
-            "Alignment"
-        },
-        [](int index, ELF64::Program_Header_Entry const& entry) -> std::vector<string>
-        {
-            return std::vector<string> {
-                Integer_As_Decimal_String(index),
-                string(ELF64::Get_Segment_Type_Name(entry.Type)),
-                string(ELF64::Get_Segment_Flag_Names(entry.Flags)),
-                Integer_As_Hexadecimal_String(entry.Segment_Offset),
-                Integer_As_Hexadecimal_String(entry.Virtual_Address),
-                Integer_As_Hexadecimal_String(entry.Physical_Address),
-                Integer_As_Hexadecimal_String(entry.Size_In_File),
-                Integer_As_Hexadecimal_String(entry.Size_In_Memory),
-                Integer_As_Hexadecimal_String(entry.Alignment)
-            };
-        });
-
-    Print_Table(table);
-
-    Prepare_Table<ELF64::Section_Header_Entry>(
-        elf.Get_Section_Header_Table(),
-        table,
-        std::vector<string> {
-            "Index",
-            "Name",
-            "Type",
-            "Flags",
-            "Virtual_Address",
-            "Segment_Offset",
-            "Size",
-            "Link",
-            "Info",
-            "Address_Alignment",
-            "Entry_Size"
-        },
-        [](int index, ELF64::Section_Header_Entry const& entry) -> std::vector<string>
-        {
-            return std::vector<string> {
-                Integer_As_Decimal_String(index++),
-                Integer_As_Decimal_String(entry.Name),
-                Integer_As_Hexadecimal_String(entry.Type),
-                Integer_As_Hexadecimal_String(entry.Flags),
-                Integer_As_Hexadecimal_String(entry.Virtual_Address),
-                Integer_As_Hexadecimal_String(entry.Segment_Offset),
-                Integer_As_Decimal_String(entry.Size),
-                Integer_As_Decimal_String(entry.Link),
-                Integer_As_Decimal_String(entry.Info),
-                Integer_As_Hexadecimal_String(entry.Address_Alignment),
-                Integer_As_Decimal_String(entry.Entry_Size)
-            };
-        });
-
-    Print_Table(table);
-
-    Prepare_Table<ELF64::Section_Header_Entry>(
-        elf.Get_Section_Header_Table(),
-        table,
-        std::vector<string> {
-            "Index",
-            "Name",
-            "Type",
-            "Flags",
-            "Virtual_Address",
-            "Segment_Offset",
-            "Size",
-            "Link",
-            "Info",
-            "Address_Alignment",
-            "Entry_Size"
-        },
-        [](int index, ELF64::Section_Header_Entry const& entry) -> std::vector<string>
-        {
-            return std::vector<string> {
-                Integer_As_Decimal_String(index++),
-                Integer_As_Decimal_String(entry.Name),
-                string(ELF64::Get_Section_Type_Name(entry.Type)),
-                string(ELF64::Get_Section_Flag_Names(entry.Flags)),
-                Integer_As_Hexadecimal_String(entry.Virtual_Address),
-                Integer_As_Hexadecimal_String(entry.Segment_Offset),
-                Integer_As_Decimal_String(entry.Size),
-                Integer_As_Decimal_String(entry.Link),
-                Integer_As_Decimal_String(entry.Info),
-                Integer_As_Hexadecimal_String(entry.Address_Alignment),
-                Integer_As_Decimal_String(entry.Entry_Size)
-            };
-        });
-
-    Print_Table(table);
+    if (entries.empty())
+    {
+        out << "No dynamic section." << "\n\n";
+        return;
+    }
+
+    out << "Dynamic section: " << std::dec << entries.size() << " entries" << std::hex << '\n';
+
+    Table_Writer table {
+        "Index",
+        "Tag",
+        "Name",
+        "Value"
+    };
+
+    int index = 0;
+
+    for (auto const& entry: entries)
+    {
+        table
+            .Decimal(index++)
+            .Hexadecimal(entry.Tag)
+            .Text(Get_Dynamic_Tag_Name(entry.Tag));
+
+        if (Is_Dynamic_String_Tag(entry.Tag))
+            table.Text(elf.Get_Dynamic_String(entry.Value));
+        else
+            table.Hexadecimal(entry.Value);
+    }
+
+    table.Print(out);
+
+    if (auto const* index = elf.Get_Dynamic_Symbol_Index())
+    {
+        out
+            << "Dynamic symbol index: " << std::dec << index->size() << " symbols"
+            << ", GNU hash buckets: " << index->Get_GNU_Bucket_Count()
+            << ", SysV hash buckets: " << index->Get_SysV_Bucket_Count()
+            << std::hex << "\n\n";
+    }
 }
 
-void Show_ELF_File_Details(ELF const& elf)
+//
+//  names is a comma-separated list of symbol names, looked up the way the
+//  dynamic linker would, through the file's own hash table.
+//
+template<typename Layout>
+static void Show_ELF_Dynamic_Lookups(ELF_File<Layout> const& elf, string_view names, std::ostream& out)
 {
-    auto const format_name = Get_File_Format_Name(elf.Get_File_Format());
+    out << "Dynamic symbol lookups:" << '\n';
+
+    auto const* index = elf.Get_Dynamic_Symbol_Index();
+
+    while (!names.empty())
+    {
+        auto const comma = names.find(',');
+        auto const name = names.substr(0, comma);
+        names = (comma == string_view::npos) ? string_view{} : names.substr(comma + 1);
+
+        if (name.empty())
+            continue;
 
-    std::cout << "This is a file of type " << format_name << "." << std::endl;
+        out << "  " << name << ": ";
 
-    if (elf.Is_ELF64())
-        Show_ELF_File_Details(static_cast<ELF64::ELF64 const&>(elf));
+        if (auto const* symbol = index ? index->Find(name) : nullptr)
+        {
+            out
+                << "0x" << std::hex << symbol->Value
+                << " size " << std::dec << symbol->Size << std::hex
+                << ' ' << Get_Symbol_Type_Name(Get_Symbol_Type(*symbol))
+                << ' ' << Get_Symbol_Binding_Name(Get_Symbol_Binding(*symbol));
+        }
+        else
+            out << "not found";
+
+        out << '\n';
+    }
+
+    out << '\n';
 }
 
+void Show_ELF_File_Details(ELF const& elf, Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    Visit(elf, [&](auto const& elf_file) { Show_ELF_File_Details(elf_file, arguments, out); });
+}
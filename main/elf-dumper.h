@@ -1,10 +1,13 @@
 #ifndef ELF_DUMPER_H__INCLUDED
 #define ELF_DUMPER_H__INCLUDED
 
+#include <ostream>
+
 #include <elf/elf.h>
 
-void Show_ELF_File_Details(ELF64::ELF64 const& elf);
-void Show_ELF_File_Details(ELF const& elf);
+#include "command-line-arguments.h"
+
+void Show_ELF_File_Details(ELF const& elf, Command_Line_Arguments const& arguments, std::ostream& out);
 
 #endif  // ELF_DUMPER_H__INCLUDED
 
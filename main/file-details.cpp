@@ -0,0 +1,264 @@
+#include "file-details.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include <include/file-format.h>
+#include <ar/ar.h>
+#include <columnar/columnar.h>
+#include <elf/elf.h>
+#include <mz/mz.h>
+
+#include "ar-dumper.h"
+#include "columnar-dumper.h"
+#include "command-line-arguments.h"
+#include "elf-dumper.h"
+#include "json-dumper.h"
+#include "mapped-file.h"
+#include "mz-dumper.h"
+#include "parse-cache.h"
+#include "signature-dumper.h"
+
+using std::nullptr_t;
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+
+Output_Format Get_Output_Format(Command_Line_Arguments const& arguments)
+{
+    auto const format = arguments.Get_Parameter("--format");
+
+    if (format.empty() || (format == "text"))
+        return Output_Format::Text;
+
+    if (format == "json")
+        return Output_Format::JSON;
+
+    if (format == "columnar")
+        return Output_Format::Columnar;
+
+    return Output_Format::Unknown;
+}
+
+std::variant<nullptr_t, unique_ptr<Parsed_File>>
+Parse(string_view file_contents)
+{
+    if (file_contents.length() < 8)
+        return nullptr;
+
+    if (auto elf = unique_ptr<ELF>(ELF::Parse(file_contents));
+             elf != nullptr)
+        return elf;
+
+    if (auto ar = unique_ptr<AR>(AR::Parse(file_contents));
+             ar != nullptr)
+        return ar;
+
+    if (auto columnar = unique_ptr<Columnar::Columnar_File>(Columnar::Columnar_File::Parse(file_contents));
+             columnar != nullptr)
+        return columnar;
+
+//    if (file_contents.substr(0, 8) == "!<bigaf>")
+//        return File_Format::AR_BigAF;
+
+    if (auto mz = unique_ptr<MZ>(MZ::Parse(file_contents));
+             mz != nullptr)
+        return mz;
+
+    return nullptr;
+}
+
+void Show_File_Details(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    auto const file_format = parsed_file.Get_File_Format();
+    auto const file_format_name = Get_File_Format_Name(file_format);
+
+    out << "This is a file of type " << file_format_name << "." << '\n';
+
+    switch(file_format)
+    {
+        case File_Format::ELF_Executable:
+        case File_Format::ELF_Object:
+        case File_Format::ELF_Shared_Object:
+        case File_Format::ELF_Core_Dump:
+        case File_Format::ELF64_Executable:
+        case File_Format::ELF64_Object:
+        case File_Format::ELF64_Shared_Object:
+        case File_Format::ELF64_Core_Dump:
+            Show_ELF_File_Details(static_cast<ELF const&>(parsed_file), arguments, out);
+            break;
+
+        case File_Format::AR_Arch:
+            Show_AR_File_Details(static_cast<AR const&>(parsed_file), arguments, out);
+            break;
+
+        case File_Format::Columnar:
+            Show_Columnar_File_Details(static_cast<Columnar::Columnar_File const&>(parsed_file), arguments, out);
+            break;
+
+        case File_Format::AR_BigAF:
+            out << "Arch not understood." << '\n';
+            break;
+
+        case File_Format::MZ_Executable:
+        case File_Format::MZ_Object:
+        case File_Format::MZ_DLL:
+        case File_Format::MZ_Library:
+            Show_MZ_File_Details(static_cast<MZ const&>(parsed_file), arguments, out);
+            break;
+
+        default:
+            out << "Unknown file format " << file_format_name << '\n';
+            break;
+    }
+}
+
+// Default for --cache-size, in MiB.
+static uint64_t const Default_Cache_Size = 1024;
+
+//
+//  The cache named by --cache, opened once per process and shared by all
+//  batch workers; nullptr when there is none or it cannot be opened.
+//
+static Parse_Cache* Get_Parse_Cache(Command_Line_Arguments const& arguments)
+{
+    static auto const cache = [&]() -> unique_ptr<Parse_Cache>
+    {
+        auto const directory = arguments.Get_Parameter("--cache");
+
+        if (directory.empty())
+            return nullptr;
+
+        auto const size_text = arguments.Get_Parameter("--cache-size");
+        uint64_t size = 0;
+
+        std::from_chars(size_text.data(), size_text.data() + size_text.size(), size);
+
+        if (size == 0)
+            size = Default_Cache_Size;
+
+        auto cache = unique_ptr<Parse_Cache>(Parse_Cache::Open(directory, size << 20));
+
+        if (!cache)
+            std::cerr << "Could not open cache " << directory << ": " << std::strerror(errno) << '\n';
+
+        return cache;
+    }();
+
+    return cache.get();
+}
+
+//
+//  Everything besides the file contents that a report depends on: the
+//  output format, the switches and parameters that shape it, and the
+//  signature rules.  JSON records carry the file name, so it is part of
+//  the variant too.
+//
+static string Get_Cache_Variant(string const& file_name, Command_Line_Arguments const& arguments)
+{
+    static string_view const Unrelated_Parameters[] = { "--manifest", "--jobs", "--output", "--cache", "--cache-size" };
+
+    string variant;
+
+    for (auto const& s: arguments.Switches())
+        variant.push_back(s ? '1' : '0');
+
+    for (auto const& p: arguments.Parameters())
+    {
+        if (std::find(std::begin(Unrelated_Parameters), std::end(Unrelated_Parameters), p.Long_Name()) != std::end(Unrelated_Parameters))
+            continue;
+
+        variant.append(p.Long_Name()).append("=").append(string(p)).push_back('\0');
+    }
+
+    // The rules file can change under the same name.
+    if (auto const rules_hash = Get_Signature_Rules_Hash(arguments); rules_hash != 0)
+        variant.append(std::to_string(rules_hash)).push_back('\0');
+
+    if (Get_Output_Format(arguments) == Output_Format::JSON)
+        variant.append(file_name);
+
+    return variant;
+}
+
+static int Report_Contents(
+        string const& file_name, string_view contents,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out)
+{
+    if (Get_Output_Format(arguments) == Output_Format::JSON)
+        return Report_Contents_JSON(file_name, contents, arguments, out);
+
+    switch (auto parsed_content = Parse(contents); parsed_content.index())
+    {
+        case 0:
+            out << "Could not understand the format." << '\n';
+            return -3;
+
+        case 1:
+            Show_File_Details(*std::get<unique_ptr<Parsed_File>>(parsed_content), arguments, out);
+            break;
+    }
+
+    return 0;
+}
+
+int Report_File(string const& file_name, Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    auto const output_format = Get_Output_Format(arguments);
+    auto mapped_file = unique_ptr<Mapped_File>(Mapped_File::Open(file_name));
+
+    if (!mapped_file)
+    {
+        if (output_format == Output_Format::JSON)
+            Report_Error_JSON(file_name, std::strerror(errno), out);
+        else
+            out << "Could not open file " << file_name << ": " << std::strerror(errno) << '\n';
+
+        return -2;
+    }
+
+    auto const contents = mapped_file->contents();
+
+    if (output_format == Output_Format::Text)
+    {
+        out
+            << file_name << ": " << contents.length() << "(0x" << std::hex << contents.length() << ")" << " bytes."
+            << '\n';
+    }
+
+    auto* cache = Get_Parse_Cache(arguments);
+
+    if (!cache)
+        return Report_Contents(file_name, contents, arguments, out);
+
+    auto const key = cache->Make_Key(contents, Get_Cache_Variant(file_name, arguments));
+    string report;
+    int result = 0;
+
+    if (!cache->Load(key, contents.size(), report, result))
+    {
+        std::ostringstream text;
+
+        // The text report continues in hexadecimal after the size line.
+        if (output_format == Output_Format::Text)
+            text << std::hex;
+
+        result = Report_Contents(file_name, contents, arguments, text);
+        report = std::move(text).str();
+
+        cache->Store(key, contents.size(), report, result);
+    }
+
+    out.write(report.data(), report.size());
+
+    return result;
+}
@@ -0,0 +1,39 @@
+#ifndef FILE_DETAILS_H__INCLUDED
+#define FILE_DETAILS_H__INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include <include/file-format.h>
+
+#include "command-line-arguments.h"
+
+enum class Output_Format
+{
+    Text,
+    JSON,
+    Columnar,
+    Unknown
+};
+
+// --format: "text" (the default), "json" or "columnar".
+Output_Format Get_Output_Format(Command_Line_Arguments const& arguments);
+
+std::variant<std::nullptr_t, std::unique_ptr<Parsed_File>> Parse(std::string_view file_contents);
+
+void Show_File_Details(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, std::ostream& out);
+
+//
+//  Maps, parses and dumps a single file in the requested output format.
+//  Returns 0 on success, -2 if the file could not be read and -3 if its
+//  format was not understood.  With --cache <directory>, reports are looked
+//  up by file contents first and stored after they are made (see
+//  Parse_Cache); --cache-size bounds the cache in MiB.
+//
+int Report_File(std::string const& file_name, Command_Line_Arguments const& arguments, std::ostream& out);
+
+#endif  // FILE_DETAILS_H__INCLUDED
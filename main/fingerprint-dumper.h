@@ -0,0 +1,43 @@
+#ifndef FINGERPRINT_DUMPER_H__INCLUDED
+#define FINGERPRINT_DUMPER_H__INCLUDED
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+#include <hash/md5.h>
+#include <include/file-format.h>
+
+#include "json-writer.h"
+
+//
+//  A digest of what a module imports, for grouping builds of the same code.
+//
+//  For PE images it is the usual import hash ("imphash"): the MD5 of the
+//  "library.function" pairs in import table order, lower-cased and joined
+//  by commas.  A .dll, .ocx or .sys extension is dropped from the library
+//  name; a function imported by ordinal from ws2_32.dll, wsock32.dll or
+//  oleaut32.dll is named from pefile's ordinal tables, and any other is
+//  "ordN", so imports by ordinal match pefile only as far as those tables
+//  are carried here.
+//
+//  For ELF files it is the MD5 of the distinct names of the undefined
+//  dynamic symbols, sorted and joined by commas ("symhash"), so that it
+//  does not depend on the order the linker wrote them in.
+//
+struct Import_Fingerprint
+{
+    std::string_view Kind;
+    MD5_Digest Digest;
+    uint32_t Count;
+};
+
+// Nothing for files that are neither PE nor ELF, or import nothing.
+std::optional<Import_Fingerprint> Get_Import_Fingerprint(Parsed_File const& parsed_file);
+
+// --imphash
+void Show_Import_Fingerprint(Parsed_File const& parsed_file, std::ostream& out);
+void Write_Import_Fingerprint_JSON(Parsed_File const& parsed_file, JSON_Writer& json);
+
+#endif  // FINGERPRINT_DUMPER_H__INCLUDED
@@ -0,0 +1,249 @@
+#include "image-loader.h"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <hash/digests.h>
+#include <hash/xxhash.h>
+#include <include/file-format.h>
+#include <mz/image.h>
+#include <mz/mz.h>
+
+#include "batch.h"
+#include "file-details.h"
+#include "json-writer.h"
+#include "mapped-file.h"
+#include "table-writer.h"
+
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+
+// Closes the descriptor whichever way the load ends.
+class File_Descriptor
+{
+    private:
+        int _fd;
+
+    public:
+        explicit File_Descriptor(int fd): _fd{fd} {}
+        ~File_Descriptor() { if (_fd >= 0) ::close(_fd); }
+
+        File_Descriptor(File_Descriptor const&) = delete;
+        File_Descriptor& operator=(File_Descriptor const&) = delete;
+
+        int get() const noexcept { return _fd; }
+};
+
+// What was loaded; the image itself is dropped before the next input is loaded.
+struct Loaded_Image
+{
+    string Path;
+    string Error;           // Empty when the image loaded.
+
+    uint64_t Base;
+    uint64_t Preferred_Base;
+    uint64_t Size;
+    uint32_t Mapped_Sections;
+    uint32_t Copied_Sections;
+    uint64_t Relocations;
+    uint64_t Unsupported_Relocations;
+    uint64_t XXH64;
+};
+
+// The base to load at, or nothing for "preferred".
+static bool Parse_Base(string_view text, std::optional<uint64_t>& base)
+{
+    if (text == "preferred")
+    {
+        base.reset();
+        return true;
+    }
+
+    if (text.starts_with("0x") || text.starts_with("0X"))
+        text.remove_prefix(2);
+
+    uint64_t value = 0;
+    auto const result = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+
+    if ((result.ec != std::errc{}) || (result.ptr != text.data() + text.size()))
+        return false;
+
+    base = value;
+    return true;
+}
+
+// Also writes the image to output_name, unless that is empty.
+static Loaded_Image Load_Image(string const& path, std::optional<uint64_t> base, string const& output_name)
+{
+    Loaded_Image loaded { path, {}, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    auto const file = unique_ptr<Mapped_File>(Mapped_File::Open(path, Mapped_File::Access_Pattern::Sequential));
+
+    if (!file)
+    {
+        loaded.Error = std::strerror(errno);
+        return loaded;
+    }
+
+    auto parsed = Parse(file->contents());
+
+    if ((parsed.index() == 0) ||
+        ((std::get<1>(parsed)->Get_File_Format() != File_Format::MZ_Executable) &&
+         (std::get<1>(parsed)->Get_File_Format() != File_Format::MZ_DLL)))
+    {
+        loaded.Error = "Not a PE image.";
+        return loaded;
+    }
+
+    auto const& mz = static_cast<MZ const&>(*std::get<1>(parsed));
+
+    // A second descriptor for the copy-on-write section mappings; without it sections are copied.
+    File_Descriptor fd(file->Is_Mapped() ? ::open(path.c_str(), O_RDONLY | O_CLOEXEC) : -1);
+
+    auto const image = unique_ptr<MZ_Image>(base ? MZ_Image::Load(mz, *base, fd.get()) : MZ_Image::Load(mz, fd.get()));
+
+    if (!image)
+    {
+        loaded.Error = std::strerror(errno);
+        return loaded;
+    }
+
+    loaded.Base = image->Get_Image_Base();
+    loaded.Preferred_Base = image->Get_Preferred_Base();
+    loaded.Size = image->size();
+    loaded.Mapped_Sections = image->Get_Mapped_Section_Count();
+    loaded.Copied_Sections = image->Get_Copied_Section_Count();
+    loaded.Relocations = image->Get_Relocation_Count();
+    loaded.Unsupported_Relocations = image->Get_Unsupported_Relocation_Count();
+    loaded.XXH64 = XXH64(image->contents());
+
+    if (!output_name.empty())
+    {
+        std::ofstream output(output_name, std::ios::binary | std::ios::trunc);
+        auto const contents = image->contents();
+
+        if (!output.write(contents.data(), contents.size()).flush())
+            loaded.Error = "Could not write " + output_name + ": " + std::strerror(errno);
+    }
+
+    return loaded;
+}
+
+static void Show_Loaded_Images(std::vector<Loaded_Image> const& images, std::ostream& out)
+{
+    Table_Writer table {
+        "File",
+        "Base",
+        "Preferred",
+        "Size",
+        "Mapped",
+        "Copied",
+        "Relocations",
+        "Unsupported",
+        "XXH64"
+    };
+
+    for (auto const& loaded: images)
+    {
+        table.Text(loaded.Path);
+
+        if (!loaded.Error.empty())
+        {
+            table.Text("-").Text("-").Text("-").Text("-").Text("-").Text("-").Text("-").Text(loaded.Error);
+            continue;
+        }
+
+        table
+            .Hexadecimal(loaded.Base)
+            .Hexadecimal(loaded.Preferred_Base)
+            .Hexadecimal(loaded.Size)
+            .Decimal(loaded.Mapped_Sections)
+            .Decimal(loaded.Copied_Sections)
+            .Decimal(loaded.Relocations)
+            .Decimal(loaded.Unsupported_Relocations)
+            .Text(To_Hex(loaded.XXH64));
+    }
+
+    table.Print(out);
+}
+
+static void Write_Loaded_Images_JSON(std::vector<Loaded_Image> const& images, std::ostream& out)
+{
+    JSON_Writer json;
+
+    for (auto const& loaded: images)
+    {
+        json.Begin_Object().Field("file", loaded.Path);
+
+        if (!loaded.Error.empty())
+        {
+            json.Field("error", loaded.Error).End_Object().End_Record().Write_To(out);
+            continue;
+        }
+
+        json
+            .Key("image").Begin_Object()
+                .Field("base", loaded.Base)
+                .Field("preferred_base", loaded.Preferred_Base)
+                .Field("size", loaded.Size)
+                .Field("mapped_sections", loaded.Mapped_Sections)
+                .Field("copied_sections", loaded.Copied_Sections)
+                .Field("relocations", loaded.Relocations)
+                .Field("unsupported_relocations", loaded.Unsupported_Relocations)
+                .Field("xxh64", To_Hex(loaded.XXH64))
+            .End_Object()
+            .End_Object().End_Record().Write_To(out);
+    }
+}
+
+int Run_Image_Loader(Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    std::optional<uint64_t> base;
+
+    if (!Parse_Base(arguments.Get_Parameter("--load-image"), base))
+    {
+        out << "--load-image takes a hexadecimal address or \"preferred\"." << '\n';
+        return 1;
+    }
+
+    auto const inputs = Collect_Batch_Inputs(arguments, out);
+    auto const output_name = string(arguments.Get_Parameter("--output"));
+
+    if (!output_name.empty() && (inputs.size() != 1))
+    {
+        out << "--output writes one image; give a single input file." << '\n';
+        return 1;
+    }
+
+    std::vector<Loaded_Image> images;
+    int result = 0;
+
+    // One at a time: an image can be as large as the address space allows.
+    for (auto const& path: inputs)
+    {
+        images.push_back(Load_Image(path, base, output_name));
+
+        if (!images.back().Error.empty())
+            result = 1;
+    }
+
+    if (Get_Output_Format(arguments) == Output_Format::JSON)
+        Write_Loaded_Images_JSON(images, out);
+    else
+        Show_Loaded_Images(images, out);
+
+    return result;
+}
@@ -0,0 +1,17 @@
+#ifndef IMAGE_LOADER_H__INCLUDED
+#define IMAGE_LOADER_H__INCLUDED
+
+#include <ostream>
+
+#include "command-line-arguments.h"
+
+//
+//  --load-image <base>: lays out every PE input the way the loader maps it
+//  (see MZ_Image), relocated to base, a hexadecimal address or "preferred",
+//  and reports what it took along with the XXH64 of the image, so that
+//  images can be compared as they run rather than as they sit on disk.
+//  With a single input, --output writes the image to a file.
+//
+int Run_Image_Loader(Command_Line_Arguments const& arguments, std::ostream& out);
+
+#endif  // IMAGE_LOADER_H__INCLUDED
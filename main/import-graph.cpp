@@ -0,0 +1,856 @@
+#include "import-graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <elf/elf.h>
+#include <hash/xxhash.h>
+#include <include/file-format.h>
+#include <include/work-stealing-pool.h>
+#include <mz/mz.h>
+
+#include "batch.h"
+#include "file-details.h"
+#include "json-writer.h"
+#include "mapped-file.h"
+#include "table-writer.h"
+
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+
+using namespace ELF_Format;
+
+static uint32_t const No_Module = ~uint32_t(0);
+static uint32_t const No_Entry = ~uint32_t(0);
+
+// Forwarder chains longer than this are taken to be cycles.
+static size_t const Maximum_Forwarder_Hops = 16;
+
+//
+//  Copies of the names a module keeps once its file is unmapped, packed
+//  into blocks that double in size, so that loading a tree of modules does
+//  not cost an allocation per name.
+//
+class String_Arena
+{
+    private:
+        static constexpr size_t First_Block_Size = 1024;
+        static constexpr size_t Largest_Block_Size = 64 * 1024;
+
+        std::vector<unique_ptr<char[]>> _blocks;
+        char* _next = nullptr;
+        size_t _available = 0;
+        size_t _block_size = First_Block_Size;
+
+        char* allocate(size_t size)
+        {
+            if (size > _available)
+            {
+                auto const block_size = std::max(size, _block_size);
+
+                _blocks.push_back(std::make_unique<char[]>(block_size));
+                _next = _blocks.back().get();
+                _available = block_size;
+                _block_size = std::min(_block_size * 2, Largest_Block_Size);
+            }
+
+            auto* result = _next;
+
+            _next += size;
+            _available -= size;
+
+            return result;
+        }
+
+    public:
+        string_view Add(string_view text)
+        {
+            if (text.empty())
+                return {};
+
+            auto* copy = allocate(text.size());
+            std::memcpy(copy, text.data(), text.size());
+
+            return { copy, text.size() };
+        }
+
+        // PE module names are compared case-insensitively, so they are kept in lower case.
+        string_view Add_Lower_Case(string_view text)
+        {
+            if (text.empty())
+                return {};
+
+            auto* copy = allocate(text.size());
+            std::transform(text.begin(), text.end(), copy, [](char c) { return ((c >= 'A') && (c <= 'Z')) ? char(c + ('a' - 'A')) : c; });
+
+            return { copy, text.size() };
+        }
+};
+
+enum class Module_Kind
+{
+    PE,
+    ELF
+};
+
+struct Module_Import
+{
+    uint32_t Dependency;    // No_Entry for ELF symbols, which do not name their library.
+    string_view Name;
+    uint16_t Ordinal;
+    bool By_Ordinal;
+};
+
+struct Module_Export
+{
+    string_view Name;       // Empty for PE exports by ordinal only.
+    string_view Forwarder;
+    uint32_t Ordinal;
+};
+
+struct Module
+{
+    string Path;
+    Module_Kind Kind;
+    string_view Name;
+
+    std::vector<string_view> Dependencies;
+    std::vector<Module_Import> Imports;
+
+    // PE exports are kept in ordinal order.
+    std::vector<Module_Export> Exports;
+
+    String_Arena Strings;
+};
+
+static string_view Get_File_Name(string_view path)
+{
+    auto const slash = path.rfind('/');
+
+    return (slash == string_view::npos) ? path : path.substr(slash + 1);
+}
+
+template<typename Layout>
+static void Load_ELF_Module(ELF_File<Layout> const& elf, Module& module)
+{
+    module.Kind = Module_Kind::ELF;
+
+    auto const soname = elf.Get_SONAME();
+    module.Name = module.Strings.Add(soname.empty() ? Get_File_Name(module.Path) : soname);
+
+    for (auto const library: elf.Get_Needed_Libraries())
+        module.Dependencies.push_back(module.Strings.Add(library));
+
+    auto const* symbols = elf.Get_Dynamic_Symbol_Table();
+
+    if (symbols == nullptr)
+        return;
+
+    for (auto const& symbol: *symbols)
+    {
+        auto const name = symbols->Get_Name(symbol);
+
+        if (name.empty())
+            continue;
+
+        auto const binding = Get_Symbol_Binding(symbol);
+        auto const type = Get_Symbol_Type(symbol);
+
+        // A weak undefined symbol may stay unresolved.
+        if (uint16_t(symbol.Section_Index) == uint16_t(Special_Section_Index::Undefined))
+        {
+            if (binding == Symbol_Binding::Global)
+                module.Imports.push_back(Module_Import { No_Entry, module.Strings.Add(name), 0, false });
+        }
+        else if (((binding == Symbol_Binding::Global) || (binding == Symbol_Binding::Weak) || (binding == Symbol_Binding::GNU_Unique)) &&
+                 (type != Symbol_Type::Section) && (type != Symbol_Type::File))
+        {
+            module.Exports.push_back(Module_Export { module.Strings.Add(name), {}, 0 });
+        }
+    }
+}
+
+static void Load_PE_Module(MZ const& mz, Module& module)
+{
+    module.Kind = Module_Kind::PE;
+    module.Name = module.Strings.Add_Lower_Case(Get_File_Name(module.Path));
+
+    for (auto const& library: mz.Get_Imports())
+    {
+        auto const dependency = uint32_t(module.Dependencies.size());
+
+        module.Dependencies.push_back(module.Strings.Add_Lower_Case(library.Name));
+
+        for (auto const& function: library.Functions)
+        {
+            module.Imports.push_back(
+                Module_Import { dependency, module.Strings.Add(function.Name), function.Ordinal, function.By_Ordinal });
+        }
+    }
+
+    auto const* exports = mz.Get_Export_Table();
+
+    if (exports == nullptr)
+        return;
+
+    std::vector<bool> named(exports->size(), false);
+
+    for (uint32_t i = 0; i < exports->Get_Name_Count(); ++i)
+    {
+        auto const target = exports->Get_Name_Target(i);
+
+        if (target >= exports->size())
+            continue;
+
+        auto const entry = exports->Get_Export(target);
+
+        named[target] = true;
+        module.Exports.push_back(
+            Module_Export { module.Strings.Add(exports->Get_Name(i)), module.Strings.Add(entry.Forwarder), entry.Ordinal });
+    }
+
+    for (uint32_t i = 0; i < exports->size(); ++i)
+    {
+        auto const entry = exports->Get_Export(i);
+
+        if (!named[i] && (entry.RVA != 0))
+            module.Exports.push_back(Module_Export { {}, module.Strings.Add(entry.Forwarder), entry.Ordinal });
+    }
+
+    std::stable_sort(
+        module.Exports.begin(), module.Exports.end(),
+        [](Module_Export const& a, Module_Export const& b) { return a.Ordinal < b.Ordinal; });
+}
+
+// nullptr for files that are not PE or ELF modules or cannot be read.
+static unique_ptr<Module> Load_Module(string const& path)
+{
+    auto const file = unique_ptr<Mapped_File>(Mapped_File::Open(path, Mapped_File::Access_Pattern::Random));
+
+    if (!file)
+        return nullptr;
+
+    auto parsed = Parse(file->contents());
+
+    if (parsed.index() == 0)
+        return nullptr;
+
+    auto const& parsed_file = *std::get<1>(parsed);
+    auto module = std::make_unique<Module>();
+
+    module->Path = path;
+
+    switch (parsed_file.Get_File_Format())
+    {
+        case File_Format::ELF_Executable:
+        case File_Format::ELF_Shared_Object:
+        case File_Format::ELF64_Executable:
+        case File_Format::ELF64_Shared_Object:
+            Visit(
+                static_cast<ELF const&>(parsed_file),
+                [&](auto const& elf) { Load_ELF_Module(elf, *module); });
+            break;
+
+        case File_Format::MZ_Executable:
+        case File_Format::MZ_DLL:
+            Load_PE_Module(static_cast<MZ const&>(parsed_file), *module);
+            break;
+
+        default:
+            return nullptr;
+    }
+
+    return module;
+}
+
+//
+//  Every named export of every module in one open-addressed table keyed by
+//  (module, name), built once.  A lookup costs one hash and normally one
+//  probe however many modules export the same name, which matters for the
+//  likes of DllMain and _init.
+//
+class Export_Index
+{
+    private:
+        struct Slot
+        {
+            uint64_t Hash;
+            uint32_t Module_Plus_One;   // 0 marks an empty slot.
+            uint32_t Export;
+        };
+
+        std::vector<unique_ptr<Module>> const& _modules;
+        std::vector<Slot> _slots;
+        size_t _mask;
+
+        static uint64_t hash(uint32_t module, string_view name) { return XXH64(name, module); }
+
+        // The slot holding the name, or the empty slot where it would go.
+        Slot const& find_slot(uint64_t hash, uint32_t module, string_view name) const
+        {
+            for (auto i = size_t(hash) & _mask; ; i = (i + 1) & _mask)
+            {
+                auto const& slot = _slots[i];
+
+                if (slot.Module_Plus_One == 0)
+                    return slot;
+
+                if ((slot.Hash == hash) && (slot.Module_Plus_One == module + 1) &&
+                    (_modules[module]->Exports[slot.Export].Name == name))
+                    return slot;
+            }
+        }
+
+    public:
+        explicit Export_Index(std::vector<unique_ptr<Module>> const& modules):
+            _modules{modules},
+            _mask{0}
+        {
+            size_t count = 0;
+
+            for (auto const& module: modules)
+                count += module->Exports.size();
+
+            auto const capacity = std::bit_ceil(std::max<size_t>(count * 2, 16));
+
+            _slots.assign(capacity, Slot { 0, 0, 0 });
+            _mask = capacity - 1;
+
+            for (uint32_t m = 0; m < modules.size(); ++m)
+            {
+                auto const& exports = modules[m]->Exports;
+
+                for (uint32_t e = 0; e < exports.size(); ++e)
+                {
+                    if (exports[e].Name.empty())
+                        continue;
+
+                    auto const h = hash(m, exports[e].Name);
+                    auto& slot = const_cast<Slot&>(find_slot(h, m, exports[e].Name));
+
+                    // The first export under a name wins, as with versioned ELF symbols.
+                    if (slot.Module_Plus_One == 0)
+                        slot = Slot { h, m + 1, e };
+                }
+            }
+        }
+
+        uint32_t Find(uint32_t module, string_view name) const
+        {
+            auto const& slot = find_slot(hash(module, name), module, name);
+
+            return (slot.Module_Plus_One == 0) ? No_Entry : slot.Export;
+        }
+};
+
+using Module_Names = std::unordered_map<string_view, std::vector<uint32_t>>;
+
+struct Import_Graph
+{
+    std::vector<unique_ptr<Module>> Modules;
+
+    // The modules that answer to each PE (lower case) and ELF library name, in input order.
+    Module_Names PE_Names;
+    Module_Names ELF_Names;
+
+    unique_ptr<Export_Index> Exports;
+
+    std::vector<uint32_t> const* Find_Providers(Module_Kind kind, string_view name) const
+    {
+        auto const& names = (kind == Module_Kind::PE) ? PE_Names : ELF_Names;
+        auto const found = names.find(name);
+
+        return (found == names.end()) ? nullptr : &found->second;
+    }
+};
+
+struct Duplicate_Symbol
+{
+    uint32_t Import;
+    std::vector<uint32_t> Providers;
+};
+
+struct Module_Resolution
+{
+    // Per dependency and per import: the providing module, or No_Module.
+    std::vector<uint32_t> Dependency_Providers;
+    std::vector<uint32_t> Import_Providers;
+
+    std::vector<Duplicate_Symbol> Duplicate_Symbols;
+
+    size_t Unresolved_Dependencies = 0;
+    size_t Unresolved_Imports = 0;
+};
+
+static uint32_t Find_By_Ordinal(Module const& module, uint32_t ordinal)
+{
+    auto const found =
+        std::lower_bound(
+            module.Exports.begin(), module.Exports.end(), ordinal,
+            [](Module_Export const& e, uint32_t ordinal) { return e.Ordinal < ordinal; });
+
+    if ((found == module.Exports.end()) || (found->Ordinal != ordinal))
+        return No_Entry;
+
+    return uint32_t(found - module.Exports.begin());
+}
+
+//
+//  The module that finally supplies a PE import from provider, following
+//  forwarders ("NTDLL.RtlAllocateHeap", "KERNEL32.#12") from DLL to DLL.
+//
+static uint32_t Resolve_PE_Import(Import_Graph const& graph, uint32_t provider, Module_Import const& import, string& scratch)
+{
+    auto name = import.Name;
+    uint32_t ordinal = import.Ordinal;
+    bool by_ordinal = import.By_Ordinal;
+
+    for (size_t hop = 0; hop < Maximum_Forwarder_Hops; ++hop)
+    {
+        auto const& module = *graph.Modules[provider];
+        auto const entry = by_ordinal ? Find_By_Ordinal(module, ordinal) : graph.Exports->Find(provider, name);
+
+        if (entry == No_Entry)
+            return No_Module;
+
+        auto const forwarder = module.Exports[entry].Forwarder;
+
+        if (forwarder.empty())
+            return provider;
+
+        auto const [library, target] = MZ::Export_Table::Split_Forwarder(forwarder);
+
+        scratch.assign(library).append(".dll");
+        std::transform(scratch.begin(), scratch.end(), scratch.begin(), [](char c) { return ((c >= 'A') && (c <= 'Z')) ? char(c + ('a' - 'A')) : c; });
+
+        auto const* providers = graph.Find_Providers(Module_Kind::PE, scratch);
+
+        if (providers == nullptr)
+            return No_Module;
+
+        provider = providers->front();
+        by_ordinal = (!target.empty() && (target[0] == '#'));
+
+        if (by_ordinal)
+            std::from_chars(target.data() + 1, target.data() + target.size(), ordinal);
+        else
+            name = target;
+    }
+
+    return No_Module;
+}
+
+static Module_Resolution Resolve_Module(Import_Graph const& graph, uint32_t index)
+{
+    auto const& module = *graph.Modules[index];
+
+    Module_Resolution resolution;
+    resolution.Dependency_Providers.reserve(module.Dependencies.size());
+    resolution.Import_Providers.reserve(module.Imports.size());
+
+    for (auto const dependency: module.Dependencies)
+    {
+        auto const* providers = graph.Find_Providers(module.Kind, dependency);
+
+        resolution.Dependency_Providers.push_back(providers ? providers->front() : No_Module);
+
+        if (providers == nullptr)
+            ++resolution.Unresolved_Dependencies;
+    }
+
+    if (module.Kind == Module_Kind::PE)
+    {
+        string scratch;
+
+        for (auto const& import: module.Imports)
+        {
+            auto const provider = resolution.Dependency_Providers[import.Dependency];
+            auto const resolved = (provider == No_Module) ? No_Module : Resolve_PE_Import(graph, provider, import, scratch);
+
+            resolution.Import_Providers.push_back(resolved);
+
+            if (resolved == No_Module)
+                ++resolution.Unresolved_Imports;
+        }
+
+        return resolution;
+    }
+
+    // The loader's search scope: the Needed closure, breadth first.
+    std::vector<uint32_t> scope;
+
+    for (auto const provider: resolution.Dependency_Providers)
+        if ((provider != No_Module) && (provider != index) && (std::find(scope.begin(), scope.end(), provider) == scope.end()))
+            scope.push_back(provider);
+
+    for (size_t i = 0; i < scope.size(); ++i)
+    {
+        for (auto const dependency: graph.Modules[scope[i]]->Dependencies)
+        {
+            auto const* providers = graph.Find_Providers(Module_Kind::ELF, dependency);
+
+            if (providers && (providers->front() != index) && (std::find(scope.begin(), scope.end(), providers->front()) == scope.end()))
+                scope.push_back(providers->front());
+        }
+    }
+
+    std::vector<uint32_t> found;
+
+    for (uint32_t i = 0; i < module.Imports.size(); ++i)
+    {
+        found.clear();
+
+        for (auto const candidate: scope)
+            if (graph.Exports->Find(candidate, module.Imports[i].Name) != No_Entry)
+                found.push_back(candidate);
+
+        resolution.Import_Providers.push_back(found.empty() ? No_Module : found.front());
+
+        if (found.empty())
+            ++resolution.Unresolved_Imports;
+
+        if (found.size() > 1)
+            resolution.Duplicate_Symbols.push_back(Duplicate_Symbol { i, found });
+    }
+
+    return resolution;
+}
+
+template<typename Task>
+static void Run_For_Each(Work_Stealing_Pool& pool, size_t count, Task const& task)
+{
+    std::atomic<size_t> remaining = count;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        pool.Submit([&task, &remaining, i]
+        {
+            task(i);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    pool.Wait_Until([&] { return remaining.load(std::memory_order_acquire) == 0; });
+}
+
+static string Get_Import_Name(Module_Import const& import)
+{
+    return import.By_Ordinal ? '#' + std::to_string(import.Ordinal) : string(import.Name);
+}
+
+static string_view Get_Dependency_Name(Module const& module, Module_Import const& import)
+{
+    return (import.Dependency == No_Entry) ? string_view() : module.Dependencies[import.Dependency];
+}
+
+// The libraries that some module depends on and more than one module answers to, by name.
+static std::vector<std::pair<string_view, std::vector<uint32_t> const*>> Get_Duplicate_Libraries(Import_Graph const& graph)
+{
+    std::vector<std::pair<string_view, std::vector<uint32_t> const*>> duplicates;
+
+    for (auto const& module: graph.Modules)
+    {
+        for (auto const dependency: module->Dependencies)
+        {
+            auto const* providers = graph.Find_Providers(module->Kind, dependency);
+
+            if (providers && (providers->size() > 1))
+                duplicates.emplace_back(dependency, providers);
+        }
+    }
+
+    std::sort(duplicates.begin(), duplicates.end());
+    duplicates.erase(std::unique(duplicates.begin(), duplicates.end()), duplicates.end());
+
+    return duplicates;
+}
+
+static string Join_Providers(Import_Graph const& graph, std::vector<uint32_t> const& providers, bool paths)
+{
+    string text;
+
+    for (auto const provider: providers)
+    {
+        if (!text.empty())
+            text.append(", ");
+
+        auto const& module = *graph.Modules[provider];
+        text.append(paths ? string_view(module.Path) : module.Name);
+    }
+
+    return text;
+}
+
+static void Show_Import_Graph(
+        Import_Graph const& graph, std::vector<Module_Resolution> const& resolutions,
+        size_t skipped, bool verbose, std::ostream& out)
+{
+    size_t dependency_count = 0, import_count = 0, unresolved_dependencies = 0, unresolved_imports = 0, pe_count = 0;
+
+    for (size_t i = 0; i < graph.Modules.size(); ++i)
+    {
+        dependency_count += graph.Modules[i]->Dependencies.size();
+        import_count += graph.Modules[i]->Imports.size();
+        unresolved_dependencies += resolutions[i].Unresolved_Dependencies;
+        unresolved_imports += resolutions[i].Unresolved_Imports;
+        pe_count += (graph.Modules[i]->Kind == Module_Kind::PE);
+    }
+
+    out << std::dec
+        << "Import graph: " << graph.Modules.size() << " modules ("
+        << pe_count << " PE, " << (graph.Modules.size() - pe_count) << " ELF, "
+        << skipped << " other files skipped), "
+        << dependency_count << " dependencies (" << unresolved_dependencies << " unresolved), "
+        << import_count << " imports (" << unresolved_imports << " unresolved)." << '\n'
+        << '\n';
+
+    auto provider_path = [&](uint32_t provider) -> string_view
+    {
+        return (provider == No_Module) ? string_view("-") : string_view(graph.Modules[provider]->Path);
+    };
+
+    Table_Writer dependencies { "Module", "Library", "Provider" };
+    Table_Writer imports { "Module", "Library", "Symbol", "Provider" };
+    Table_Writer duplicates { "Module", "Name", "Providers" };
+
+    for (size_t i = 0; i < graph.Modules.size(); ++i)
+    {
+        auto const& module = *graph.Modules[i];
+        auto const& resolution = resolutions[i];
+
+        for (size_t d = 0; d < module.Dependencies.size(); ++d)
+        {
+            if (verbose || (resolution.Dependency_Providers[d] == No_Module))
+                dependencies.Text(module.Path).Text(module.Dependencies[d]).Text(provider_path(resolution.Dependency_Providers[d]));
+        }
+
+        for (size_t m = 0; m < module.Imports.size(); ++m)
+        {
+            auto const& import = module.Imports[m];
+            auto const provider = resolution.Import_Providers[m];
+
+            // The imports of a missing library are covered by its own line.
+            if ((import.Dependency != No_Entry) && (resolution.Dependency_Providers[import.Dependency] == No_Module))
+                continue;
+
+            if (verbose || (provider == No_Module))
+                imports.Text(module.Path).Text(Get_Dependency_Name(module, import)).Text(Get_Import_Name(import)).Text(provider_path(provider));
+        }
+
+        for (auto const& duplicate: resolution.Duplicate_Symbols)
+            duplicates.Text(module.Path).Text(module.Imports[duplicate.Import].Name).Text(Join_Providers(graph, duplicate.Providers, false));
+    }
+
+    for (auto const& [name, providers]: Get_Duplicate_Libraries(graph))
+        duplicates.Text("-").Text(name).Text(Join_Providers(graph, *providers, true));
+
+    out << (verbose ? "Dependencies:" : "Unresolved dependencies:") << '\n';
+    dependencies.Print(out);
+
+    out << (verbose ? "Imports:" : "Unresolved imports:") << '\n';
+    imports.Print(out);
+
+    out << "Duplicate providers:" << '\n';
+    duplicates.Print(out);
+}
+
+static void Write_Import_Graph_JSON(
+        Import_Graph const& graph, std::vector<Module_Resolution> const& resolutions,
+        size_t skipped, bool verbose, std::ostream& out)
+{
+    JSON_Writer json;
+
+    auto provider_field = [&](string_view key, uint32_t provider)
+    {
+        if (provider == No_Module)
+            json.Key(key).Null();
+        else
+            json.Field(key, string_view(graph.Modules[provider]->Path));
+    };
+
+    for (size_t i = 0; i < graph.Modules.size(); ++i)
+    {
+        auto const& module = *graph.Modules[i];
+        auto const& resolution = resolutions[i];
+
+        json
+            .Begin_Object()
+            .Field("file", string_view(module.Path))
+            .Field("name", module.Name)
+            .Field("format", (module.Kind == Module_Kind::PE) ? "pe" : "elf")
+            .Key("dependencies").Begin_Array();
+
+        for (size_t d = 0; d < module.Dependencies.size(); ++d)
+        {
+            json.Begin_Object().Field("name", module.Dependencies[d]);
+            provider_field("provider", resolution.Dependency_Providers[d]);
+            json.End_Object();
+        }
+
+        json.End_Array().Key(verbose ? "imports" : "unresolved_imports").Begin_Array();
+
+        for (size_t m = 0; m < module.Imports.size(); ++m)
+        {
+            auto const& import = module.Imports[m];
+            auto const provider = resolution.Import_Providers[m];
+
+            if (!verbose && (provider != No_Module))
+                continue;
+
+            json.Begin_Object();
+
+            if (import.Dependency != No_Entry)
+                json.Field("library", module.Dependencies[import.Dependency]);
+
+            json.Field("name", Get_Import_Name(import));
+
+            if (verbose)
+                provider_field("provider", provider);
+
+            json.End_Object();
+        }
+
+        json.End_Array().Key("duplicate_symbols").Begin_Array();
+
+        for (auto const& duplicate: resolution.Duplicate_Symbols)
+        {
+            json
+                .Begin_Object()
+                .Field("name", module.Imports[duplicate.Import].Name)
+                .Key("providers").Begin_Array();
+
+            for (auto const provider: duplicate.Providers)
+                json.String(graph.Modules[provider]->Path);
+
+            json.End_Array().End_Object();
+        }
+
+        json.End_Array().End_Object().End_Record().Write_To(out);
+    }
+
+    size_t unresolved_dependencies = 0, unresolved_imports = 0;
+
+    for (auto const& resolution: resolutions)
+    {
+        unresolved_dependencies += resolution.Unresolved_Dependencies;
+        unresolved_imports += resolution.Unresolved_Imports;
+    }
+
+    json
+        .Begin_Object()
+        .Key("import_graph").Begin_Object()
+            .Field("modules", graph.Modules.size())
+            .Field("skipped", skipped)
+            .Field("unresolved_dependencies", unresolved_dependencies)
+            .Field("unresolved_imports", unresolved_imports)
+            .Key("duplicate_libraries").Begin_Array();
+
+    for (auto const& [name, providers]: Get_Duplicate_Libraries(graph))
+    {
+        json.Begin_Object().Field("name", name).Key("providers").Begin_Array();
+
+        for (auto const provider: *providers)
+            json.String(graph.Modules[provider]->Path);
+
+        json.End_Array().End_Object();
+    }
+
+    json.End_Array().End_Object().End_Object().End_Record().Write_To(out);
+}
+
+int Run_Import_Graph(Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    auto inputs = Collect_Batch_Inputs(arguments, out);
+    auto const input_count = inputs.size();
+
+    // A library is usually reached through symbolic links as well; load each file once.
+    {
+        std::set<std::pair<dev_t, ino_t>> seen;
+
+        std::erase_if(
+            inputs,
+            [&](string const& path)
+            {
+                struct stat status;
+
+                return (::stat(path.c_str(), &status) == 0) && !seen.emplace(status.st_dev, status.st_ino).second;
+            });
+    }
+
+    Work_Stealing_Pool pool(Get_Job_Count(arguments));
+
+    std::vector<unique_ptr<Module>> loaded(inputs.size());
+
+    Run_For_Each(
+        pool, inputs.size(),
+        [&](size_t i)
+        {
+            try
+            {
+                loaded[i] = Load_Module(inputs[i]);
+            }
+            catch (std::exception const&)
+            {
+                loaded[i] = nullptr;
+            }
+        });
+
+    Import_Graph graph;
+
+    for (auto& module: loaded)
+        if (module)
+            graph.Modules.push_back(std::move(module));
+
+    auto const skipped = input_count - graph.Modules.size();
+
+    for (uint32_t i = 0; i < graph.Modules.size(); ++i)
+    {
+        auto const& module = *graph.Modules[i];
+        auto& names = (module.Kind == Module_Kind::PE) ? graph.PE_Names : graph.ELF_Names;
+
+        names[module.Name].push_back(i);
+
+        // A library is also found under its file name when its SONAME differs.
+        if (module.Kind == Module_Kind::ELF)
+            if (auto const file_name = Get_File_Name(module.Path); file_name != module.Name)
+                names[file_name].push_back(i);
+    }
+
+    graph.Exports = std::make_unique<Export_Index>(graph.Modules);
+
+    std::vector<Module_Resolution> resolutions(graph.Modules.size());
+
+    Run_For_Each(
+        pool, graph.Modules.size(),
+        [&](size_t i) { resolutions[i] = Resolve_Module(graph, uint32_t(i)); });
+
+    auto const verbose = arguments.Get_Switch("--verbose");
+
+    if (Get_Output_Format(arguments) == Output_Format::JSON)
+        Write_Import_Graph_JSON(graph, resolutions, skipped, verbose, out);
+    else
+        Show_Import_Graph(graph, resolutions, skipped, verbose, out);
+
+    out.flush();
+
+    for (auto const& resolution: resolutions)
+        if ((resolution.Unresolved_Dependencies != 0) || (resolution.Unresolved_Imports != 0))
+            return 1;
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef IMPORT_GRAPH_H__INCLUDED
+#define IMPORT_GRAPH_H__INCLUDED
+
+#include <ostream>
+
+#include "command-line-arguments.h"
+
+//
+//  --import-graph: loads every PE and ELF module among the batch inputs,
+//  then resolves what each one imports against the others.  A PE import
+//  names its DLL, which is matched by file name (case-insensitively), and
+//  is followed through export forwarders.  An ELF module's Needed entries
+//  are matched by SONAME (or file name), and its undefined dynamic symbols
+//  are looked up through its Needed closure in breadth-first order, the
+//  way the dynamic loader searches.
+//
+//  Reports dependencies and imports that nothing in the tree satisfies,
+//  libraries that more than one module provides, and ELF symbols that
+//  more than one library in a module's search scope defines; with
+//  --verbose, every resolved edge as well.  Text and JSON output.
+//
+int Run_Import_Graph(Command_Line_Arguments const& arguments, std::ostream& out);
+
+#endif  // IMPORT_GRAPH_H__INCLUDED
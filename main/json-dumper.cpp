@@ -0,0 +1,835 @@
+#include "json-dumper.h"
+
+#include <exception>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <ar/ar.h>
+#include <elf/elf.h>
+#include <include/file-format.h>
+#include <include/work-stealing-pool.h>
+#include <mz/mz.h>
+
+#include "batch.h"
+#include "byte-statistics.h"
+#include "command-line-arguments.h"
+#include "digest-dumper.h"
+#include "fingerprint-dumper.h"
+#include "file-details.h"
+#include "json-writer.h"
+#include "resource-dumper.h"
+#include "signature-dumper.h"
+#include "strings-dumper.h"
+#include "verification-dumper.h"
+
+using std::string;
+using std::string_view;
+using std::unique_ptr;
+
+using namespace ELF_Format;
+
+//
+//  Writers are kept per thread between records so that their buffers are
+//  reused.  A record holds its writer until it is written out: nested work
+//  that waits on the batch pool may start another file's record on the
+//  same thread, and that record takes a writer of its own.
+//
+class Record_Writer
+{
+    private:
+        inline static thread_local std::vector<unique_ptr<JSON_Writer>> _idle_writers;
+
+        unique_ptr<JSON_Writer> _writer;
+
+    public:
+        Record_Writer()
+        {
+            if (_idle_writers.empty())
+                _writer = std::make_unique<JSON_Writer>();
+            else
+            {
+                _writer = std::move(_idle_writers.back());
+                _idle_writers.pop_back();
+                _writer->clear();
+            }
+        }
+
+        ~Record_Writer() { _idle_writers.push_back(std::move(_writer)); }
+
+        Record_Writer(Record_Writer const&) = delete;
+        Record_Writer& operator=(Record_Writer const&) = delete;
+
+        JSON_Writer& operator*() const { return *_writer; }
+};
+
+//
+//  The parts of a record that may wait on the pool.  Waiting lets this
+//  thread run other tasks, other files' records included, so they are
+//  computed before the record is opened rather than halfway through it.
+//
+struct Record_Inputs
+{
+    std::vector<Hashed_Region> Digests;
+    Byte_Histogram_Set Histograms;
+};
+
+static Record_Inputs Prepare_Record_Inputs(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments)
+{
+    Record_Inputs inputs;
+
+    // Archives report their members in records of their own.
+    if (parsed_file.Get_File_Format() == File_Format::AR_Arch)
+        return inputs;
+
+    if (arguments.Get_Switch("--hashes"))
+    {
+        inputs.Digests = Get_Hashed_Regions(parsed_file);
+        Compute_Region_Digests(inputs.Digests, arguments);
+    }
+
+    // --entropy reports the same segments and sections that get digests, but not the whole file.
+    if (arguments.Get_Switch("--entropy"))
+    {
+        for (auto const& region: Get_Hashed_Regions(parsed_file))
+            if (region.Kind != "file")
+                inputs.Histograms.Add(region.Contents, arguments);
+    }
+
+    return inputs;
+}
+
+template<typename Layout>
+static void Write_ELF_JSON(ELF_File<Layout> const& elf, Command_Line_Arguments const& arguments, Record_Inputs const& inputs, JSON_Writer& json);
+
+static void Write_MZ_Exports_JSON(MZ const& mz, JSON_Writer& json)
+{
+    json.Key("exports");
+
+    auto const* exports = mz.Get_Export_Table();
+
+    if (!exports)
+    {
+        json.Null();
+        return;
+    }
+
+    auto const& directory = exports->Get_Directory();
+
+    json
+        .Begin_Object()
+        .Field("name", exports->Get_DLL_Name())
+        .Field("time_date_stamp", directory.Time_Date_Stamp)
+        .Field("major_version", directory.Major_Version)
+        .Field("minor_version", directory.Minor_Version)
+        .Field("ordinal_base", directory.Ordinal_Base)
+        .Key("functions").Begin_Array();
+
+    auto const names = exports->Get_Names_By_Address();
+
+    for (uint32_t i = 0; i < exports->size(); ++i)
+    {
+        auto const entry = exports->Get_Export(i);
+
+        if (entry.RVA == 0)
+            continue;
+
+        json
+            .Begin_Object()
+            .Field("ordinal", entry.Ordinal)
+            .Field("rva", entry.RVA);
+
+        if (!names[i].empty())
+            json.Field("name", names[i]);
+
+        if (!entry.Forwarder.empty())
+            json.Field("forwarder", entry.Forwarder);
+
+        json.End_Object();
+    }
+
+    json.End_Array().End_Object();
+}
+
+static void Write_MZ_JSON(MZ const& mz, Command_Line_Arguments const& arguments, Record_Inputs const& inputs, JSON_Writer& json);
+static void Write_AR_JSON(AR const& ar, Command_Line_Arguments const& arguments, JSON_Writer& json);
+
+static int Write_Record(
+        string_view label, string_view container, string_view member_name,
+        string_view contents,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out);
+
+template<typename Symbol_Table>
+static void Write_ELF_Symbols_JSON(Symbol_Table const& symbols, JSON_Writer& json)
+{
+    json.Begin_Array();
+
+    for (auto const& symbol: symbols)
+    {
+        json
+            .Begin_Object()
+            .Field("name", symbols.Get_Name(symbol))
+            .Field("value", symbol.Value)
+            .Field("size", symbol.Size)
+            .Field("type", Get_Symbol_Type_Name(Get_Symbol_Type(symbol)))
+            .Field("binding", Get_Symbol_Binding_Name(Get_Symbol_Binding(symbol)))
+            .Field("section_index", symbol.Section_Index)
+            .End_Object();
+    }
+
+    json.End_Array();
+}
+
+static void Write_MZ_Symbols_JSON(MZ::Symbol_Table const& symbols, JSON_Writer& json)
+{
+    json.Begin_Array();
+
+    for (uint32_t i = 0; i < symbols.size(); i = symbols.Next(i))
+    {
+        auto const& symbol = symbols[i];
+        bool const is_file = (symbol.Storage_Class == MZ::Symbol_Storage_Class::IMAGE_SYM_CLASS_FILE);
+
+        json
+            .Begin_Object()
+            .Field("index", i)
+            .Field("name", is_file ? symbols.Get_File_Name(i) : symbols.Get_Name(symbol))
+            .Field("value", symbol.Value)
+            .Field("section_number", symbol.Section_Number)
+            .Field("type", symbol.Type)
+            .Field("storage_class", Get_Symbol_Storage_Class_Name(symbol.Storage_Class))
+            .Field("number_of_aux_symbols", symbol.Number_Of_Aux_Symbols)
+            .End_Object();
+    }
+
+    json.End_Array();
+}
+
+// --dynamic: the dynamic section, its strings, and the hash tables that index .dynsym.
+template<typename Layout>
+static void Write_ELF_Dynamic_JSON(ELF_File<Layout> const& elf, JSON_Writer& json)
+{
+    json.Key("dynamic").Begin_Object();
+
+    json.Key("entries").Begin_Array();
+
+    for (auto const& entry: elf.Get_Dynamic_Table())
+    {
+        json
+            .Begin_Object()
+            .Field("tag", entry.Tag)
+            .Field("tag_name", Get_Dynamic_Tag_Name(entry.Tag))
+            .Field("value", entry.Value);
+
+        if (Is_Dynamic_String_Tag(entry.Tag))
+            json.Field("string", elf.Get_Dynamic_String(entry.Value));
+
+        json.End_Object();
+    }
+
+    json.End_Array();
+
+    json.Key("needed").Begin_Array();
+
+    for (auto const library: elf.Get_Needed_Libraries())
+        json.String(library);
+
+    json.End_Array();
+
+    json
+        .Field("soname", elf.Get_SONAME())
+        .Field("rpath", elf.Get_RPATH())
+        .Field("runpath", elf.Get_RUNPATH());
+
+    if (auto const* index = elf.Get_Dynamic_Symbol_Index())
+    {
+        json
+            .Field("dynamic_symbol_count", index->size())
+            .Field("gnu_hash_buckets", index->Get_GNU_Bucket_Count())
+            .Field("sysv_hash_buckets", index->Get_SysV_Bucket_Count());
+    }
+    else
+        json.Key("dynamic_symbol_count").Null();
+
+    json.End_Object();
+}
+
+// --lookup: each name as the dynamic linker would resolve it, or null.
+template<typename Layout>
+static void Write_ELF_Dynamic_Lookups_JSON(ELF_File<Layout> const& elf, string_view names, JSON_Writer& json)
+{
+    auto const* index = elf.Get_Dynamic_Symbol_Index();
+
+    json.Key("lookups").Begin_Object();
+
+    while (!names.empty())
+    {
+        auto const comma = names.find(',');
+        auto const name = names.substr(0, comma);
+        names = (comma == string_view::npos) ? string_view{} : names.substr(comma + 1);
+
+        if (name.empty())
+            continue;
+
+        json.Key(name);
+
+        if (auto const* symbol = index ? index->Find(name) : nullptr)
+        {
+            json
+                .Begin_Object()
+                .Field("value", symbol->Value)
+                .Field("size", symbol->Size)
+                .Field("type", Get_Symbol_Type_Name(Get_Symbol_Type(*symbol)))
+                .Field("binding", Get_Symbol_Binding_Name(Get_Symbol_Binding(*symbol)))
+                .Field("section_index", symbol->Section_Index)
+                .End_Object();
+        }
+        else
+            json.Null();
+    }
+
+    json.End_Object();
+}
+
+// --entropy: the entropy and byte histogram of a section or segment.
+static void Write_Byte_Statistics_JSON(string_view contents, Record_Inputs const& inputs, JSON_Writer& json)
+{
+    auto const histogram = inputs.Histograms.Get(contents);
+
+    json.Field("entropy", Get_Entropy(histogram)).Key("histogram").Begin_Array();
+
+    for (auto const count: histogram)
+        json.Number(count);
+
+    json.End_Array();
+}
+
+template<typename Layout>
+static void Write_ELF_JSON(ELF_File<Layout> const& elf, Command_Line_Arguments const& arguments, Record_Inputs const& inputs, JSON_Writer& json)
+{
+    bool const entropy = arguments.Get_Switch("--entropy");
+
+    auto const& header = elf.Get_Header();
+
+    json
+        .Key("elf").Begin_Object()
+        .Field("class", Layout::Is_64 ? "ELF64" : "ELF32")
+        .Field("byte_order", Layout::Is_Big_Endian ? "big" : "little")
+        .Key("header").Begin_Object()
+            .Field("type", header.Type)
+            .Field("type_name", Get_File_Type_Name(header.Type))
+            .Field("machine", header.Machine)
+            .Field("version", header.Version)
+            .Field("entry_point", header.Entry_Point)
+            .Field("program_header_offset", header.Program_Header_Offset)
+            .Field("section_header_offset", header.Section_Header_Offset)
+            .Field("flags", header.Flags)
+            .Field("elf_header_size", header.ELF_Header_Size)
+            .Field("program_header_entry_size", header.Program_Header_Entry_Size)
+            .Field("program_header_entry_count", header.Program_Header_Entry_Count)
+            .Field("section_header_entry_size", header.Section_Header_Entry_Size)
+            .Field("section_header_entry_count", header.Section_Header_Entry_Count)
+            .Field("section_header_string_table_index", header.Section_Header_String_Table_Index)
+        .End_Object();
+
+    json.Key("segments").Begin_Array();
+
+    for (auto const& entry: elf.Get_Program_Header_Table())
+    {
+        json
+            .Begin_Object()
+            .Field("type", entry.Type)
+            .Field("type_name", Get_Segment_Type_Name(entry.Type))
+            .Field("flags", entry.Flags)
+            .Field("flag_names", Get_Segment_Flag_Names(entry.Flags))
+            .Field("segment_offset", entry.Segment_Offset)
+            .Field("virtual_address", entry.Virtual_Address)
+            .Field("physical_address", entry.Physical_Address)
+            .Field("size_in_file", entry.Size_In_File)
+            .Field("size_in_memory", entry.Size_In_Memory)
+            .Field("alignment", entry.Alignment);
+
+        if (entropy)
+            Write_Byte_Statistics_JSON(elf.Get_Range(entry.Segment_Offset, entry.Size_In_File), inputs, json);
+
+        json.End_Object();
+    }
+
+    json.End_Array();
+
+    json.Key("sections").Begin_Array();
+
+    for (auto const& entry: elf.Get_Section_Header_Table())
+    {
+        json
+            .Begin_Object()
+            .Field("name", elf.Get_Section_Name(entry))
+            .Field("type", entry.Type)
+            .Field("type_name", Get_Section_Type_Name(entry.Type))
+            .Field("flags", entry.Flags)
+            .Field("flag_names", Get_Section_Flag_Names(entry.Flags))
+            .Field("virtual_address", entry.Virtual_Address)
+            .Field("segment_offset", entry.Segment_Offset)
+            .Field("size", entry.Size)
+            .Field("link", entry.Link)
+            .Field("info", entry.Info)
+            .Field("address_alignment", entry.Address_Alignment)
+            .Field("entry_size", entry.Entry_Size);
+
+        if (entropy)
+        {
+            auto const contents =
+                (Section_Type(uint32_t(entry.Type)) == Section_Type::No_Bits)
+                    ? string_view{}
+                    : elf.Get_Range(entry.Segment_Offset, entry.Size);
+
+            Write_Byte_Statistics_JSON(contents, inputs, json);
+        }
+
+        json.End_Object();
+    }
+
+    json.End_Array();
+
+    if (arguments.Get_Switch("--symbols"))
+    {
+        if (auto const* symbols = elf.Get_Symbol_Table())
+            Write_ELF_Symbols_JSON(*symbols, json.Key("symbols"));
+
+        if (auto const* symbols = elf.Get_Dynamic_Symbol_Table())
+            Write_ELF_Symbols_JSON(*symbols, json.Key("dynamic_symbols"));
+    }
+
+    if (arguments.Get_Switch("--dynamic"))
+        Write_ELF_Dynamic_JSON(elf, json);
+
+    if (auto const names = arguments.Get_Parameter("--lookup"); !names.empty())
+        Write_ELF_Dynamic_Lookups_JSON(elf, names, json);
+
+    if (arguments.Get_Switch("--hashes"))
+        Write_Digests_JSON(inputs.Digests, json);
+
+    if (arguments.Get_Switch("--imphash"))
+        Write_Import_Fingerprint_JSON(elf, json);
+
+    Write_Signature_Matches_JSON(elf, arguments, json);
+
+    json.End_Object();
+}
+
+template<typename Optional_Header_Type>
+static void Write_MZ_Optional_Header_JSON(Optional_Header_Type const& oh, JSON_Writer& json)
+{
+    json
+        .Key("optional_header").Begin_Object()
+        .Field("magic", uint16_t(oh.Magic))
+        .Field("magic_name", Get_Magic_Number_Name(oh.Magic))
+        .Field("major_linker_version", oh.Major_Linker_Version)
+        .Field("minor_linker_version", oh.Minor_Linker_Version)
+        .Field("size_of_code", oh.Size_Of_Code)
+        .Field("size_of_initialized_data", oh.Size_Of_Initialized_Data)
+        .Field("size_of_uninitialized_data", oh.Size_Of_Uninitialized_Data)
+        .Field("address_of_entry_point", oh.Address_Of_Entry_Point)
+        .Field("base_of_code", oh.Base_Of_Code)
+        .Field("image_base", oh.Image_Base)
+        .Field("section_alignment", oh.Section_Alignment)
+        .Field("file_alignment", oh.File_Alignment)
+        .Field("major_operating_system_version", oh.Major_Operating_System_Version)
+        .Field("minor_operating_system_version", oh.Minor_Operating_System_Version)
+        .Field("major_image_version", oh.Major_Image_Version)
+        .Field("minor_image_version", oh.Minor_Image_Version)
+        .Field("major_subsystem_version", oh.Major_Subsystem_Version)
+        .Field("minor_subsystem_version", oh.Minor_Subsystem_Version)
+        .Field("win32_version_value", oh.Win32_Version_Value)
+        .Field("size_of_image", oh.Size_Of_Image)
+        .Field("size_of_headers", oh.Size_Of_Headers)
+        .Field("check_sum", oh.Check_Sum)
+        .Field("subsystem", uint16_t(oh.Subsystem))
+        .Field("dll_characteristics", uint16_t(oh.Dll_Characteristics))
+        .Field("size_of_stack_reserve", oh.Size_Of_Stack_Reserve)
+        .Field("size_of_stack_commit", oh.Size_Of_Stack_Commit)
+        .Field("size_of_heap_reserve", oh.Size_Of_Heap_Reserve)
+        .Field("size_of_heap_commit", oh.Size_Of_Heap_Commit)
+        .Field("loader_flags", oh.Loader_Flags)
+        .Field("number_of_rva_and_sizes", oh.Number_Of_Rva_And_Sizes)
+        .End_Object();
+
+    auto const& idd = oh.Image_Data_Directories;
+
+    // The entries are copied: they are packed and cannot be bound to references.
+    std::pair<string_view, MZ::Image_Data_Directories::Entry> const directories[] = {
+        { "export_table", idd.Export_Table },
+        { "import_table", idd.Import_Table },
+        { "resource_table", idd.Resource_Table },
+        { "exception_table", idd.Exception_Table },
+        { "certificate_table", idd.Certificate_Table },
+        { "base_relocation_table", idd.Base_Relocation_Table },
+        { "debug", idd.Debug },
+        { "architecture", idd.Architecture },
+        { "global_ptr", idd.Global_Ptr },
+        { "tls_table", idd.TLS_Table },
+        { "load_config_table", idd.Load_Config_Table },
+        { "bound_import", idd.Bound_Import },
+        { "iat", idd.IAT },
+        { "delay_import_descriptor", idd.Delay_Import_Descriptor },
+        { "clr_runtime_header", idd.CLR_Runtime_Header }
+    };
+
+    json.Key("data_directories").Begin_Object();
+
+    for (auto const& [name, entry]: directories)
+    {
+        json
+            .Key(name).Begin_Object()
+            .Field("virtual_address", entry.Virtual_Address)
+            .Field("size", entry.Size)
+            .End_Object();
+    }
+
+    json.End_Object();
+}
+
+static void Write_MZ_Imports_JSON(MZ const& mz, bool verbose, JSON_Writer& json)
+{
+    json.Key("imports");
+
+    auto const libraries = mz.Get_Imports();
+
+    if (libraries.empty())
+    {
+        json.Null();
+        return;
+    }
+
+    json.Begin_Array();
+
+    for (auto const& library: libraries)
+    {
+        auto const& entry = library.Directory;
+
+        json
+            .Begin_Object()
+            .Field("name", library.Name)
+            .Field("import_lookup_table_rva", entry.Import_Lookup_Table_RVA)
+            .Field("time_date_stamp", entry.Time_Date_Stamp)
+            .Field("forwarder_chain", entry.Forwarder_Chain)
+            .Field("import_address_table_rva", entry.Import_Address_Table_RVA);
+
+        if (verbose)
+        {
+            json.Key("functions").Begin_Array();
+
+            for (auto const& function: library.Functions)
+            {
+                json.Begin_Object();
+
+                if (function.By_Ordinal)
+                {
+                    json.Field("ordinal", function.Ordinal);
+                } else {
+                    json
+                        .Field("hint", function.Hint)
+                        .Field("name", function.Name);
+                }
+
+                json.End_Object();
+            }
+
+            json.End_Array();
+        }
+
+        json.End_Object();
+    }
+
+    json.End_Array();
+}
+
+static void Write_MZ_JSON(MZ const& mz, Command_Line_Arguments const& arguments, Record_Inputs const& inputs, JSON_Writer& json)
+{
+    auto const coff_header = mz.Get_Header();
+
+    json
+        .Key("pe").Begin_Object()
+        .Key("signature_offset");
+
+    if (mz.Get_File_Format() == File_Format::MZ_Object)
+        json.Null();
+    else
+        json.Number(mz.Get_COFF_Header_Address());
+
+    json
+        .Key("coff_header").Begin_Object()
+            .Field("signature", coff_header.Signature)
+            .Field("machine", uint16_t(coff_header.Machine))
+            .Field("machine_name", Get_Machine_Type_Name(coff_header.Machine))
+            .Field("number_of_sections", coff_header.Number_Of_Sections)
+            .Field("time_date_stamp", coff_header.Time_Date_Stamp)
+            .Field("pointer_to_symbol_table", coff_header.Pointer_to_Symbol_Table)
+            .Field("number_of_symbols", coff_header.Number_Of_Symbols)
+            .Field("size_of_optional_header", coff_header.Size_Of_Optional_Header)
+            .Field("characteristics", uint16_t(coff_header.Characteristics))
+        .End_Object();
+
+    switch (auto optional_header = mz.Get_Optional_Header();
+            optional_header.index())
+    {
+        case 0:
+            json.Key("optional_header").Null();
+            break;
+
+        case 1:
+            Write_MZ_Optional_Header_JSON(std::get<MZ::Optional_Header>(optional_header), json);
+            break;
+
+        case 2:
+            Write_MZ_Optional_Header_JSON(std::get<MZ::Optional_Header_Plus>(optional_header), json);
+            break;
+    }
+
+    json.Key("sections").Begin_Array();
+
+    for (uint16_t i = 0; i < mz.Get_Number_of_Sections(); ++i)
+    {
+        auto const& sh = mz.Get_Section_Header(i);
+
+        json
+            .Begin_Object()
+            .Field("name", mz.Get_Section_Name(sh))
+            .Field("virtual_size", sh.Virtual_Size)
+            .Field("virtual_address", sh.Virtual_Address)
+            .Field("size_of_raw_data", sh.Size_Of_Raw_Data)
+            .Field("pointer_to_raw_data", sh.Pointer_To_Raw_Data)
+            .Field("pointer_to_relocations", sh.Pointer_To_Relocations)
+            .Field("pointer_to_linenumbers", sh.Pointer_To_Linenumbers)
+            .Field("number_of_relocations", sh.Number_Of_Relocations)
+            .Field("number_of_linenumbers", sh.Number_Of_Linenumbers)
+            .Field("characteristics", uint32_t(sh.Characteristics));
+
+        if (arguments.Get_Switch("--entropy"))
+        {
+            auto const contents =
+                MZ::Has_File_Data(sh)
+                    ? mz.Get_Range(sh.Pointer_To_Raw_Data, sh.Size_Of_Raw_Data)
+                    : string_view{};
+
+            Write_Byte_Statistics_JSON(contents, inputs, json);
+        }
+
+        json.End_Object();
+    }
+
+    json.End_Array();
+
+    if (arguments.Get_Switch("--imports"))
+        Write_MZ_Imports_JSON(mz, arguments.Get_Switch("--verbose"), json);
+
+    if (arguments.Get_Switch("--exports"))
+        Write_MZ_Exports_JSON(mz, json);
+
+    if (arguments.Get_Switch("--symbols"))
+        if (auto const* symbols = mz.Get_Symbol_Table())
+            Write_MZ_Symbols_JSON(*symbols, json.Key("symbols"));
+
+    if (arguments.Get_Switch("--hashes"))
+        Write_Digests_JSON(inputs.Digests, json);
+
+    if (arguments.Get_Switch("--verify"))
+        Write_PE_Verification_JSON(mz, json);
+
+    if (arguments.Get_Switch("--imphash"))
+        Write_Import_Fingerprint_JSON(mz, json);
+
+    if (arguments.Get_Switch("--resources"))
+        Write_Resources_JSON(mz, json);
+
+    Write_Signature_Matches_JSON(mz, arguments, json);
+
+    json.End_Object();
+}
+
+static void Write_AR_JSON(AR const& ar, Command_Line_Arguments const& arguments, JSON_Writer& json)
+{
+    json.Key("archive").Begin_Object();
+
+    json.Key("members").Begin_Array();
+
+    for (auto const& member: ar.Get_Members())
+    {
+        json
+            .Begin_Object()
+            .Field("name", member.Name)
+            .Field("offset", member.Offset)
+            .Field("size", member.Contents.size())
+            .End_Object();
+    }
+
+    json.End_Array();
+
+    auto const& symbols = ar.Get_Symbols();
+
+    json.Field("symbol_count", symbols.size());
+
+    if (arguments.Get_Switch("--symbols"))
+    {
+        json.Key("symbols").Begin_Array();
+
+        for (auto const& symbol: symbols)
+        {
+            json.Begin_Object().Field("name", symbol.Name).Key("member");
+
+            if (symbol.Defining_Member)
+                json.String(symbol.Defining_Member->Name);
+            else
+                json.Null();
+
+            json.End_Object();
+        }
+
+        json.End_Array();
+    }
+
+    json.End_Object();
+}
+
+// Member records follow the archive's own record, in member order.
+static void Write_AR_Member_Records(
+        AR const& ar, string_view archive_label,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out)
+{
+    auto const& members = ar.Get_Members();
+
+    Nested_Pool pool(arguments);
+
+    Write_Reports_In_Order(
+        *pool, members.size(),
+        [&](size_t index, std::ostream& report) -> int
+        {
+            auto const& member = members[index];
+            auto const label = string(archive_label) + '(' + string(member.Name) + ')';
+
+            Write_Record(label, archive_label, member.Name, member.Contents, arguments, report);
+            return 0;
+        },
+        out);
+}
+
+static void Write_Error_Record(string_view label, string_view error, std::ostream& out)
+{
+    Record_Writer writer;
+    auto& json = *writer;
+
+    json
+        .Begin_Object()
+        .Field("file", label)
+        .Field("error", error)
+        .End_Object()
+        .End_Record()
+        .Write_To(out);
+}
+
+static int Write_Record(
+        string_view label, string_view container, string_view member_name,
+        string_view contents,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out)
+{
+    Record_Writer writer;
+    auto& json = *writer;
+
+    try
+    {
+        auto parsed_content = Parse(contents);
+
+        Record_Inputs inputs;
+
+        if (parsed_content.index() != 0)
+            inputs = Prepare_Record_Inputs(*std::get<unique_ptr<Parsed_File>>(parsed_content), arguments);
+
+        json.Begin_Object().Field("file", label);
+
+        if (!container.empty())
+            json.Field("container", container).Field("member", member_name);
+
+        json.Field("size", contents.size());
+
+        if (parsed_content.index() == 0)
+        {
+            json
+                .Field("format", Get_File_Format_Name(File_Format::Unknown))
+                .Field("error", "Could not understand the format.")
+                .End_Object()
+                .End_Record()
+                .Write_To(out);
+
+            return -3;
+        }
+
+        auto const& parsed_file = *std::get<unique_ptr<Parsed_File>>(parsed_content);
+        auto const file_format = parsed_file.Get_File_Format();
+
+        json.Field("format", Get_File_Format_Name(file_format));
+
+        switch (file_format)
+        {
+            case File_Format::ELF_Executable:
+            case File_Format::ELF_Object:
+            case File_Format::ELF_Shared_Object:
+            case File_Format::ELF_Core_Dump:
+            case File_Format::ELF64_Executable:
+            case File_Format::ELF64_Object:
+            case File_Format::ELF64_Shared_Object:
+            case File_Format::ELF64_Core_Dump:
+                Visit(
+                    static_cast<ELF const&>(parsed_file),
+                    [&](auto const& elf) { Write_ELF_JSON(elf, arguments, inputs, json); });
+                break;
+
+            case File_Format::AR_Arch:
+                Write_AR_JSON(static_cast<AR const&>(parsed_file), arguments, json);
+                break;
+
+            case File_Format::MZ_Executable:
+            case File_Format::MZ_Object:
+            case File_Format::MZ_DLL:
+            case File_Format::MZ_Library:
+                Write_MZ_JSON(static_cast<MZ const&>(parsed_file), arguments, inputs, json);
+                break;
+
+            default:
+                break;
+        }
+
+        json.End_Object().End_Record().Write_To(out);
+
+        // String records follow their file's record, one per string.
+        if (arguments.Get_Switch("--strings"))
+            Write_Strings_JSON(label, parsed_file, out);
+
+        if (file_format == File_Format::AR_Arch)
+            Write_AR_Member_Records(static_cast<AR const&>(parsed_file), label, arguments, out);
+    }
+    catch (std::exception const& e)
+    {
+        Write_Error_Record(label, e.what(), out);
+        return -4;
+    }
+
+    return 0;
+}
+
+int Report_Contents_JSON(
+        string_view file_name, string_view contents,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out)
+{
+    return Write_Record(file_name, {}, {}, contents, arguments, out);
+}
+
+void Report_Error_JSON(string_view file_name, string_view error, std::ostream& out)
+{
+    Write_Error_Record(file_name, error, out);
+}
@@ -0,0 +1,24 @@
+#ifndef JSON_DUMPER_H__INCLUDED
+#define JSON_DUMPER_H__INCLUDED
+
+#include <ostream>
+#include <string_view>
+
+#include "command-line-arguments.h"
+
+//
+//  --format json: one JSON object per line for each input file, and one for
+//  each member of an archive after the archive's own record.  Headers and
+//  section tables are always included; imports, symbols, digests and
+//  entropy follow the same switches as the text output.  Returns the same
+//  codes as Report_File.
+//
+int Report_Contents_JSON(
+        std::string_view file_name, std::string_view contents,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out);
+
+// A record for a file that could not be read at all.
+void Report_Error_JSON(std::string_view file_name, std::string_view error, std::ostream& out);
+
+#endif  // JSON_DUMPER_H__INCLUDED
@@ -0,0 +1,129 @@
+#include "json-writer.h"
+
+#include <array>
+
+//
+//  For every byte, 0 if it can be copied as is, otherwise the character
+//  that follows the backslash ('u' for the \u00XX form).  Bytes above 0x7f
+//  are marked '8': they are copied when they make up well-formed UTF-8 and
+//  replaced otherwise, since names taken from binaries are not guaranteed
+//  to be UTF-8 and the output must stay valid JSON.
+//
+static constexpr auto Escapes = []
+{
+    std::array<char, 256> escapes {};
+
+    for (int c = 0; c < 0x20; ++c)
+        escapes[c] = 'u';
+
+    escapes[0x7f] = 'u';
+
+    for (int c = 0x80; c < 0x100; ++c)
+        escapes[c] = '8';
+
+    escapes['"'] = '"';
+    escapes['\\'] = '\\';
+    escapes['\b'] = 'b';
+    escapes['\f'] = 'f';
+    escapes['\n'] = 'n';
+    escapes['\r'] = 'r';
+    escapes['\t'] = 't';
+
+    return escapes;
+}();
+
+//
+//  The length of the well-formed UTF-8 sequence at the start of text, or 0
+//  when it does not start with one.  Overlong forms, surrogates and code
+//  points above U+10FFFF are not well-formed.
+//
+static size_t Get_UTF8_Sequence_Length(std::string_view text)
+{
+    auto const byte = [&](size_t i) { return static_cast<unsigned char>(text[i]); };
+
+    auto const lead = byte(0);
+    size_t length = 0;
+    unsigned char low = 0x80;
+    unsigned char high = 0xbf;
+
+    if ((lead >= 0xc2) && (lead <= 0xdf))
+        length = 2;
+    else if ((lead >= 0xe0) && (lead <= 0xef))
+    {
+        length = 3;
+
+        if (lead == 0xe0)
+            low = 0xa0;
+        else if (lead == 0xed)
+            high = 0x9f;
+    } else if ((lead >= 0xf0) && (lead <= 0xf4)) {
+        length = 4;
+
+        if (lead == 0xf0)
+            low = 0x90;
+        else if (lead == 0xf4)
+            high = 0x8f;
+    } else {
+        return 0;
+    }
+
+    if (text.size() < length)
+        return 0;
+
+    // Only the first continuation byte has narrower bounds.
+    if ((byte(1) < low) || (byte(1) > high))
+        return 0;
+
+    for (size_t i = 2; i < length; ++i)
+    {
+        if ((byte(i) & 0xc0) != 0x80)
+            return 0;
+    }
+
+    return length;
+}
+
+void JSON_Writer::quoted(std::string_view text)
+{
+    static constexpr char hex_digits[] = "0123456789abcdef";
+
+    _buffer.push_back('"');
+
+    size_t run_begin = 0;
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        auto const c = static_cast<unsigned char>(text[i]);
+        auto const escape = Escapes[c];
+
+        if (escape == 0)
+            continue;
+
+        if (escape == '8')
+        {
+            if (auto const length = Get_UTF8_Sequence_Length(text.substr(i)); length != 0)
+            {
+                i += length - 1;
+                continue;
+            }
+        }
+
+        _buffer.append(text.data() + run_begin, i - run_begin);
+        run_begin = i + 1;
+
+        if (escape == '8')
+        {
+            // U+FFFD REPLACEMENT CHARACTER, one for each byte that is not part of a sequence.
+            _buffer.append("\\ufffd");
+        } else if (escape == 'u') {
+            char const sequence[] = { '\\', 'u', '0', '0', hex_digits[c >> 4], hex_digits[c & 0xf] };
+            _buffer.append(sequence, sizeof(sequence));
+        } else {
+            char const sequence[] = { '\\', escape };
+            _buffer.append(sequence, sizeof(sequence));
+        }
+    }
+
+    _buffer.append(text.data() + run_begin, text.size() - run_begin);
+    _buffer.push_back('"');
+}
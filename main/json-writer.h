@@ -0,0 +1,176 @@
+#ifndef JSON_WRITER_H__INCLUDED
+#define JSON_WRITER_H__INCLUDED
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <include/endian.h>
+
+//
+//  Streams JSON text straight into a buffer that is kept between records, so
+//  once it has grown to the size of the largest record nothing is allocated.
+//  There is no document tree: the writer only remembers, per nesting level,
+//  whether a separating comma is due.  Nesting is limited to 64 levels.
+//
+class JSON_Writer
+{
+    private:
+        std::string _buffer;
+
+        uint64_t _has_members;
+        unsigned _depth;
+        bool _after_key;
+
+        void separate()
+        {
+            if (_after_key)
+            {
+                _after_key = false;
+                return;
+            }
+
+            auto const bit = uint64_t(1) << _depth;
+
+            if (_has_members & bit)
+                _buffer.push_back(',');
+
+            _has_members |= bit;
+        }
+
+        void open(char bracket)
+        {
+            separate();
+            _buffer.push_back(bracket);
+
+            ++_depth;
+            _has_members &= ~(uint64_t(1) << _depth);
+        }
+
+        void close(char bracket)
+        {
+            --_depth;
+            _buffer.push_back(bracket);
+        }
+
+        void quoted(std::string_view text);
+
+        template<typename T>
+        JSON_Writer& integer(T value)
+        {
+            char digits[24];
+            auto const result = std::to_chars(std::begin(digits), std::end(digits), Integer_Value(value));
+
+            separate();
+            _buffer.append(digits, result.ptr);
+
+            return *this;
+        }
+
+        // Shortest text that reads back as the same double; JSON has no NaN or infinity.
+        JSON_Writer& real(double value)
+        {
+            if (!std::isfinite(value))
+                return Null();
+
+            char digits[32];
+            auto const result = std::to_chars(std::begin(digits), std::end(digits), value);
+
+            separate();
+            _buffer.append(digits, result.ptr);
+
+            return *this;
+        }
+
+    public:
+        JSON_Writer(): _has_members{0}, _depth{0}, _after_key{false} {}
+
+        JSON_Writer& Begin_Object() { open('{'); return *this; }
+        JSON_Writer& End_Object() { close('}'); return *this; }
+
+        JSON_Writer& Begin_Array() { open('['); return *this; }
+        JSON_Writer& End_Array() { close(']'); return *this; }
+
+        JSON_Writer& Key(std::string_view name)
+        {
+            separate();
+            quoted(name);
+            _buffer.push_back(':');
+            _after_key = true;
+
+            return *this;
+        }
+
+        JSON_Writer& String(std::string_view text)
+        {
+            separate();
+            quoted(text);
+
+            return *this;
+        }
+
+        JSON_Writer& Boolean(bool value)
+        {
+            separate();
+            _buffer.append(value ? "true" : "false");
+
+            return *this;
+        }
+
+        JSON_Writer& Null()
+        {
+            separate();
+            _buffer.append("null");
+
+            return *this;
+        }
+
+        template<typename T>
+        JSON_Writer& Number(T value)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                return real(value);
+            else
+                return integer(value);
+        }
+
+        JSON_Writer& Field(std::string_view name, std::string_view text) { return Key(name).String(text); }
+        JSON_Writer& Field(std::string_view name, std::string const& text) { return Key(name).String(text); }
+        JSON_Writer& Field(std::string_view name, char const* text) { return Key(name).String(text); }
+        JSON_Writer& Field(std::string_view name, bool value) { return Key(name).Boolean(value); }
+
+        template<typename T>
+        JSON_Writer& Field(std::string_view name, T value) { return Key(name).Number(value); }
+
+        // Ends a top-level value with a newline, one record per line.
+        JSON_Writer& End_Record()
+        {
+            _buffer.push_back('\n');
+            _has_members = 0;
+
+            return *this;
+        }
+
+        std::string_view view() const noexcept { return _buffer; }
+
+        // Drops the text written so far but keeps the buffer for the next record.
+        void clear()
+        {
+            _buffer.clear();
+            _has_members = 0;
+            _depth = 0;
+            _after_key = false;
+        }
+
+        void Write_To(std::ostream& out)
+        {
+            out.write(_buffer.data(), _buffer.size());
+            clear();
+        }
+};
+
+#endif  // JSON_WRITER_H__INCLUDED
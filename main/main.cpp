@@ -1,4 +1,3 @@
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <list>
@@ -10,13 +9,12 @@
 #include <variant>
 #include <vector>
 
-#include <include/file-format.h>
-#include <elf/elf.h>
-#include <mz/mz.h>
-
+#include "batch.h"
 #include "command-line-arguments.h"
-#include "elf-dumper.h"
-#include "mz-dumper.h"
+#include "file-details.h"
+#include "image-loader.h"
+#include "import-graph.h"
+#include "signature-dumper.h"
 
 using std::nullptr_t;
 using std::string;
@@ -26,103 +24,30 @@ using std::unique_ptr;
 int Usage(string_view program_name)
 {
     std::cout
-        << "Usage: " << program_name << " <filename>"
+        << "Usage: " << program_name << " [options] [--format text|json] [--cache <directory> [--cache-size <MiB>]] <filename>\n"
+        << "       " << program_name << " [options] [--format text|json] [--cache <directory> [--cache-size <MiB>]] [--jobs <n>] [--manifest <file>] <filename|directory>...\n"
+        << "       " << program_name << " [options] --format columnar --output <file> [--jobs <n>] [--manifest <file>] <filename|directory>...\n"
+        << "       " << program_name << " [--verbose] [--format text|json] --import-graph [--jobs <n>] [--manifest <file>] <filename|directory>...\n"
+        << "       " << program_name << " [--format text|json] --load-image <base|preferred> [--output <file>] [--manifest <file>] <filename|directory>...\n"
+        << "\n"
+        << "--cache keeps whole text and JSON reports, keyed by file contents.  It pays off when --hashes,\n"
+        << "--entropy, --strings or --signatures make reports costly; the columnar format and --import-graph\n"
+        << "do not use it."
         << std::endl;
 
     return 1;
 }
 
-std::variant<nullptr_t, unique_ptr<Parsed_File>>
-Parse(string_view file_contents)
-{
-    if (file_contents.length() < 8)
-        return nullptr;
-
-    if (auto elf = unique_ptr<ELF>(ELF::Parse(file_contents));
-             elf != nullptr)
-        return elf;
-
-//    if (file_contents.substr(0, 8) == "!<arch>\n")
-//        return File_Format::AR_Arch;
-//
-//    if (file_contents.substr(0, 8) == "!<bigaf>")
-//        return File_Format::AR_BigAF;
-
-    if (auto mz = unique_ptr<MZ>(MZ::Parse(file_contents));
-             mz != nullptr)
-        return mz;
-
-    return nullptr;
-}
-
-bool Read_File(string const& file_name, string& file_contents)
-{
-    std::ifstream stream(file_name.c_str());
-
-    if (!stream)
-    {
-        std::cout << "Could not open file " << file_name << std::endl;
-        return false;
-    }
-
-    stream.seekg(0, std::ios_base::end);
-    auto const file_size = stream.tellg();
-    stream.seekg(0, std::ios_base::beg);
-
-    file_contents.resize(file_size);
-    stream.read(&file_contents[0], file_size);
-
-    return true;
-}
-
-void Show_File_Details(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments)
-{
-    auto const file_format = parsed_file.Get_File_Format();
-    auto const file_format_name = Get_File_Format_Name(file_format);
-
-    std::cout << "This is a file of type " << file_format_name << "." << std::endl;
-
-    switch(file_format)
-    {
-        case File_Format::ELF_Executable:
-        case File_Format::ELF_Object:
-        case File_Format::ELF_Shared_Object:
-            Show_ELF_File_Details(static_cast<ELF const&>(parsed_file));
-            break;
-
-        case File_Format::ELF64_Executable:
-        case File_Format::ELF64_Object:
-        case File_Format::ELF64_Shared_Object:
-        case File_Format::ELF64_Core_Dump:
-            Show_ELF_File_Details(static_cast<ELF64::ELF64 const&>(parsed_file));
-            break;
-
-        case File_Format::AR_Arch:
-            std::cout << "Arch not understood." << std::endl;
-            break;
-
-        case File_Format::AR_BigAF:
-            std::cout << "Arch not understood." << std::endl;
-            break;
-
-        case File_Format::MZ_Executable:
-        case File_Format::MZ_Object:
-        case File_Format::MZ_DLL:
-        case File_Format::MZ_Library:
-            Show_MZ_File_Details(static_cast<MZ const&>(parsed_file), arguments);
-            break;
-
-        default:
-            std::cout << "Unknown file format " << file_format_name << std::endl;
-            break;
-    }
-}
-
 int main(int argc, char* argv[])
 {
     Command_Line_Arguments arguments {
-        {{"--verbose", "-v"}, {"--imports", "-i"}, {"--sections", "-s"}},
-        {}
+        {{"--verbose", "-v"}, {"--imports", "-i"}, {"--sections", "-s"}, {"--symbols", "-y"},
+         {"--hashes", "-H"}, {"--entropy", "-e"}, {"--strings", "-t"}, {"--exports", "-x"},
+         {"--import-graph", "-G"}, {"--imphash", "-I"}, {"--resources", "-R"},
+         {"--verify", "-V"}, {"--dynamic", "-d"}},
+        {{"--manifest", "-m"}, {"--jobs", "-j"}, {"--symbolize", "-a"}, {"--format", "-f"}, {"--output", "-o"},
+         {"--cache", "-c"}, {"--cache-size", "-C"}, {"--signatures", "-g"},
+         {"--load-image", "-L"}, {"--lookup", "-l"}}
     };
 
     if (!arguments.Parse(std::span(argv, argc)))
@@ -130,31 +55,25 @@ int main(int argc, char* argv[])
         return Usage(argv[0]);
     }
 
-    if (arguments.Standalone().size() != 1)
+    if (Get_Output_Format(arguments) == Output_Format::Unknown)
         return Usage(argv[0]);
 
-    string filename = arguments.Standalone()[0];
-    string contents;
+    // Bad rules are reported once here rather than silently skipped for every file.
+    if (!arguments.Get_Parameter("--signatures").empty() && (Get_Signature_Set(arguments) == nullptr))
+        return 1;
 
-    if (!Read_File(filename, contents))
-        return -2;
+    if (arguments.Get_Switch("--import-graph"))
+        return Run_Import_Graph(arguments, std::cout);
 
-    std::cout
-        << filename << ": " << contents.length() << "(0x" << std::hex << contents.length() << ")" << " bytes."
-        << std::endl;
+    if (!arguments.Get_Parameter("--load-image").empty())
+        return Run_Image_Loader(arguments, std::cout);
 
-    switch (auto parsed_content = Parse(contents); parsed_content.index())
-    {
-        case 0:
-            std::cout << "Could not understand the format." << std::endl;
-            return -3;
-            break;
+    // The columnar format writes one file for all inputs, so it always runs as a batch.
+    if (Is_Batch_Invocation(arguments) || (Get_Output_Format(arguments) == Output_Format::Columnar))
+        return Run_Batch(arguments, std::cout);
 
-        case 1:
-            Show_File_Details(*std::get<unique_ptr<Parsed_File>>(parsed_content), arguments);
-            break;
-    }
+    if (arguments.Standalone().size() != 1)
+        return Usage(argv[0]);
 
-    return 0;
+    return Report_File(arguments.Standalone()[0], arguments, std::cout);
 }
-
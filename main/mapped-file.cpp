@@ -0,0 +1,127 @@
+#include "mapped-file.h"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int Get_Advice(Mapped_File::Access_Pattern pattern)
+{
+    switch (pattern)
+    {
+        case Mapped_File::Access_Pattern::Random:       return MADV_RANDOM;
+        case Mapped_File::Access_Pattern::Sequential:   return MADV_SEQUENTIAL;
+        case Mapped_File::Access_Pattern::Will_Need:    return MADV_WILLNEED;
+
+        case Mapped_File::Access_Pattern::Normal:
+        default:
+            return MADV_NORMAL;
+    }
+}
+
+Mapped_File* Mapped_File::Open(std::string const& file_name, Access_Pattern pattern)
+{
+    int fd = ::open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+        return nullptr;
+
+    auto mapped_file = new Mapped_File;
+
+    struct stat status;
+    bool success = false;
+
+    if ((::fstat(fd, &status) == 0) && S_ISREG(status.st_mode) && (status.st_size > 0))
+        success = mapped_file->map(fd, size_t(status.st_size), pattern);
+
+    // Pipes, devices and files that refuse to be mapped are read in full.
+    if (!success)
+        success = mapped_file->read(fd);
+
+    auto const saved_errno = errno;
+    ::close(fd);
+
+    if (!success)
+    {
+        delete mapped_file;
+        errno = saved_errno;
+        return nullptr;
+    }
+
+    return mapped_file;
+}
+
+bool Mapped_File::map(int fd, size_t size, Access_Pattern pattern)
+{
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    _mapping = mapping;
+    _mapping_size = size;
+    _contents = std::string_view(static_cast<char const*>(mapping), size);
+
+    Advise(pattern);
+
+    return true;
+}
+
+bool Mapped_File::read(int fd)
+{
+    char chunk[64 * 1024];
+
+    for (;;)
+    {
+        auto const bytes_read = ::read(fd, chunk, sizeof(chunk));
+
+        if (bytes_read == 0)
+            break;
+
+        if (bytes_read < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        _owned.append(chunk, size_t(bytes_read));
+    }
+
+    _contents = _owned;
+
+    return true;
+}
+
+Mapped_File::~Mapped_File()
+{
+    if (_mapping != nullptr)
+        ::munmap(_mapping, _mapping_size);
+}
+
+void Mapped_File::Advise(Access_Pattern pattern) const
+{
+    Advise(_contents, pattern);
+}
+
+void Mapped_File::Advise(std::string_view range, Access_Pattern pattern) const
+{
+    if ((_mapping == nullptr) || range.empty())
+        return;
+
+    //
+    //  madvise() wants a page-aligned start; widen the range down to the
+    //  page that holds its first byte.
+    //
+    static long const page_size = ::sysconf(_SC_PAGESIZE);
+
+    auto const begin = reinterpret_cast<uintptr_t>(range.data());
+    auto const aligned_begin = begin & ~uintptr_t(page_size - 1);
+    auto const length = range.size() + (begin - aligned_begin);
+
+    ::madvise(reinterpret_cast<void*>(aligned_begin), length, Get_Advice(pattern));
+}
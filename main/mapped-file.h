@@ -0,0 +1,57 @@
+#ifndef MAPPED_FILE_H__INCLUDED
+#define MAPPED_FILE_H__INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <include/interface.h>
+
+//
+//  Owns the bytes of an input file for as long as any Parsed_File built on
+//  top of it is alive.  Regular files are memory-mapped so that only the
+//  pages a dumper actually reads are brought in; pipes, character devices
+//  and anything else that cannot be mapped are read into an owned buffer.
+//
+class Mapped_File: public Base_Class
+{
+    public:
+        enum class Access_Pattern
+        {
+            Normal,
+            Random,
+            Sequential,
+            Will_Need
+        };
+
+    private:
+        void* _mapping;
+        size_t _mapping_size;
+        std::string _owned;
+        std::string_view _contents;
+
+        Mapped_File(): _mapping{nullptr}, _mapping_size{0} {}
+
+        bool map(int fd, size_t size, Access_Pattern pattern);
+        bool read(int fd);
+
+    public:
+        // Returns nullptr, with errno set, if the file cannot be read.
+        static Mapped_File* Open(std::string const& file_name, Access_Pattern pattern = Access_Pattern::Random);
+
+        Mapped_File(Mapped_File const&) = delete;
+        Mapped_File& operator=(Mapped_File const&) = delete;
+
+        ~Mapped_File() override;
+
+        bool Is_Mapped() const noexcept { return (_mapping != nullptr); }
+
+        void Advise(Access_Pattern pattern) const;
+        void Advise(std::string_view range, Access_Pattern pattern) const;
+
+        std::string_view contents() const noexcept { return _contents; }
+        size_t size() const noexcept { return _contents.size(); }
+        size_t length() const noexcept { return _contents.length(); }
+};
+
+#endif  // MAPPED_FILE_H__INCLUDED
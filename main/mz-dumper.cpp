@@ -7,28 +7,48 @@
 
 #include <mz/mz.h>
 
+#include "byte-statistics.h"
 #include "command-line-arguments.h"
+#include "digest-dumper.h"
+#include "fingerprint-dumper.h"
+#include "resource-dumper.h"
+#include "signature-dumper.h"
+#include "strings-dumper.h"
+#include "table-writer.h"
+#include "verification-dumper.h"
 
 using std::chrono::seconds;
 using std::chrono::system_clock;
 using std::chrono::time_point;
 using std::chrono::operator""y;
-using std::cout;
-using std::endl;
 
 using typeid_t = void const*;
 
 template<typename Optional_Header_Type>
-void Show_MZ_Optional_Header(Optional_Header_Type const& oh);
+void Show_MZ_Optional_Header(Optional_Header_Type const& oh, std::ostream& out);
 
-void Show_MZ_Image_Data_Directory_Summary(MZ::Image_Data_Directories const& idd);
-void Show_MZ_Section_Table(MZ const& mz, bool verbose);
-void Show_Imports(MZ const& mz, bool verbose);
+void Show_MZ_Image_Data_Directory_Summary(MZ::Image_Data_Directories const& idd, std::ostream& out);
+void Show_MZ_Section_Table(MZ const& mz, bool verbose, Command_Line_Arguments const& arguments, std::ostream& out);
+void Show_Imports(MZ const& mz, bool verbose, std::ostream& out);
+void Show_Exports(MZ const& mz, std::ostream& out);
+void Show_MZ_Symbol_Table(MZ::Symbol_Table const& symbols, std::ostream& out);
 
-void Show_MZ_File_Details(MZ const& mz, Command_Line_Arguments const& arguments)
+void Show_MZ_File_Details(MZ const& mz, Command_Line_Arguments const& arguments, std::ostream& out)
 {
     bool verbose = arguments.Get_Switch("-v");
 
+    auto const signature_offset = mz.Get_COFF_Header_Address();
+
+    if (mz.Get_File_Format() == File_Format::MZ_Object)
+    {
+        out << std::hex << "No PE signature.  This is a COFF object file." << '\n';
+    } else {
+        out << std::hex
+            << "Signature offset found at 3c: " << signature_offset << '\n'
+            << "Signature found at " << signature_offset << ": " << mz.Get_Header().Signature << '\n'
+            << "PE signature found.  This is a Portable Executable file." << '\n';
+    }
+
     auto const format_name = Get_File_Format_Name(mz.Get_File_Format());
 
     auto coff_header = mz.Get_Header();
@@ -38,7 +58,7 @@ void Show_MZ_File_Details(MZ const& mz, Command_Line_Arguments const& arguments)
     std::string timestamp_as_string = std::ctime(&time);
     timestamp_as_string = timestamp_as_string.substr(0, timestamp_as_string.length() - 1);
 
-    cout
+    out
         << "Portable Executable file details:"
         << "\n  Signature: " << coff_header.Signature
         << "\n  Machine: " << Get_Machine_Type_Name(coff_header.Machine)
@@ -52,9 +72,9 @@ void Show_MZ_File_Details(MZ const& mz, Command_Line_Arguments const& arguments)
     auto const characteristics = Get_Image_File_Characteristics_Names(coff_header.Characteristics);
 
     for (auto const ch: characteristics)
-        cout << "\n    " << ch;
+        out << "\n    " << ch;
 
-    cout << '\n';
+    out << '\n';
 
     if (verbose)
     {
@@ -62,24 +82,48 @@ void Show_MZ_File_Details(MZ const& mz, Command_Line_Arguments const& arguments)
                 optional_header.index())
         {
             case 0:
-                cout << "Optional Header not present." << endl;
+                out << "Optional Header not present." << '\n';
                 break;
 
             case 1:
-                Show_MZ_Optional_Header(std::get<MZ::Optional_Header>(optional_header));
+                Show_MZ_Optional_Header(std::get<MZ::Optional_Header>(optional_header), out);
                 break;
 
             case 2:
-                Show_MZ_Optional_Header(std::get<MZ::Optional_Header_Plus>(optional_header));
+                Show_MZ_Optional_Header(std::get<MZ::Optional_Header_Plus>(optional_header), out);
                 break;
         }
     }
 
-    if (arguments.Get_Switch("-s"))
-        Show_MZ_Section_Table(mz, verbose);
+    if (arguments.Get_Switch("-s") || arguments.Get_Switch("--entropy"))
+        Show_MZ_Section_Table(mz, verbose, arguments, out);
 
     if (arguments.Get_Switch("-i"))
-        Show_Imports(mz, verbose);
+        Show_Imports(mz, verbose, out);
+
+    if (arguments.Get_Switch("--exports"))
+        Show_Exports(mz, out);
+
+    if (arguments.Get_Switch("--symbols"))
+        if (auto const* symbols = mz.Get_Symbol_Table())
+            Show_MZ_Symbol_Table(*symbols, out);
+
+    if (arguments.Get_Switch("--hashes"))
+        Show_Digests(mz, arguments, out);
+
+    if (arguments.Get_Switch("--verify"))
+        Show_PE_Verification(mz, out);
+
+    if (arguments.Get_Switch("--imphash"))
+        Show_Import_Fingerprint(mz, out);
+
+    if (arguments.Get_Switch("--resources"))
+        Show_Resources(mz, out);
+
+    if (arguments.Get_Switch("--strings"))
+        Show_Strings(mz, out);
+
+    Show_Signature_Matches(mz, arguments, out);
 }
 
 template <typename T>
@@ -104,9 +148,9 @@ std::string Build_Version(Major major, Minor minor)
 }
 
 template<typename Optional_Header_Type>
-void Show_MZ_Optional_Header(Optional_Header_Type const& oh)
+void Show_MZ_Optional_Header(Optional_Header_Type const& oh, std::ostream& out)
 {
-    cout
+    out
         << "\n  OptionalHeader:"
         << "\n    Standard Fields:"
         << "\n      Magic: " << Get_Magic_Number_Name(oh.Magic)
@@ -118,9 +162,9 @@ void Show_MZ_Optional_Header(Optional_Header_Type const& oh)
         << "\n      Base_Of_Code: " << oh.Base_Of_Code;
 
     if constexpr(typeof<Optional_Header_Type>() == typeof<MZ::Optional_Header>())
-        cout << "\n    Base_Of_Data: " << oh.Base_Of_Data;
+        out << "\n    Base_Of_Data: " << oh.Base_Of_Data;
 
-    cout
+    out
         << "\n"
         << "\n    Windows-Specific fields:"
         << "\n      Image_Base: " << oh.Image_Base
@@ -139,17 +183,17 @@ void Show_MZ_Optional_Header(Optional_Header_Type const& oh)
     auto const characteristics = Get_Image_DLL_Characteristics_Names(oh.Dll_Characteristics);
 
     for (auto const ch: characteristics)
-        cout << "\n        " << ch;
+        out << "\n        " << ch;
 
-    cout
+    out
         << "\n      Size_Of_Stack_Reserve: " << oh.Size_Of_Stack_Reserve
         << "\n      Size_Of_Stack_Commit: " << oh.Size_Of_Stack_Commit
         << "\n      Size_Of_Heap_Reserve: " << oh.Size_Of_Heap_Reserve
         << "\n      Size_Of_Heap_Commit: " << oh.Size_Of_Heap_Commit
         << "\n      Loader_Flags: " << oh.Loader_Flags
-        << "\n      Number_Of_Rva_And_Sizes: " << oh.Number_Of_Rva_And_Sizes << std::endl;
+        << "\n      Number_Of_Rva_And_Sizes: " << oh.Number_Of_Rva_And_Sizes << '\n';
 
-    Show_MZ_Image_Data_Directory_Summary(oh.Image_Data_Directories);
+    Show_MZ_Image_Data_Directory_Summary(oh.Image_Data_Directories, out);
 }
 
 std::string Format_Range(uint32_t start, uint32_t size)
@@ -173,9 +217,9 @@ Stream& operator<<(Stream& stream, MZ::Image_Data_Directories::Entry const& idde
     return (stream << Format_Range(idde.Virtual_Address, idde.Size));
 }
 
-void Show_MZ_Image_Data_Directory_Summary(MZ::Image_Data_Directories const& idd)
+void Show_MZ_Image_Data_Directory_Summary(MZ::Image_Data_Directories const& idd, std::ostream& out)
 {
-    cout
+    out
         << "\n  Image Data Directories:"
         << "\n    Export_Table: " << idd.Export_Table
         << "\n    Import_Table: " << idd.Import_Table
@@ -192,16 +236,19 @@ void Show_MZ_Image_Data_Directory_Summary(MZ::Image_Data_Directories const& idd)
         << "\n    IAT: " << idd.IAT
         << "\n    Delay_Import_Descriptor: " << idd.Delay_Import_Descriptor
         << "\n    CLR_Runtime_Header: " << idd.CLR_Runtime_Header
-        << "\n    Reserved_MBZ: " << idd.Reserved_MBZ << std::endl;
+        << "\n    Reserved_MBZ: " << idd.Reserved_MBZ << '\n';
 }
 
-void Show_MZ_Section_Header(MZ const& mz, int i, MZ::Section_Header const& sh, bool verbose)
+void Show_MZ_Section_Header(
+        MZ const& mz, int i, MZ::Section_Header const& sh, bool verbose,
+        Command_Line_Arguments const& arguments,
+        std::ostream& out)
 {
     auto const Section_Name = mz.Get_Section_Name(sh);
 
     if (verbose)
     {
-        cout
+        out
             << "\n    Section " << i << ": " << Section_Name
             << "\n      Virtual: " << Format_Range(sh.Virtual_Address, sh.Virtual_Size)
             << "\n      Raw Data: " << Format_Range(sh.Pointer_To_Raw_Data, sh.Size_Of_Raw_Data)
@@ -211,7 +258,7 @@ void Show_MZ_Section_Header(MZ const& mz, int i, MZ::Section_Header const& sh, b
             << "\n      Number_Of_Linenumbers: " << sh.Number_Of_Linenumbers
             << "\n      Characteristics: " << (std::hex) << uint32_t(sh.Characteristics);
     } else {
-        cout
+        out
             << "\n    Section " << i << ": " << Section_Name
             << "\n      Virtual: " << Format_Range(sh.Virtual_Address, sh.Virtual_Size)
             << "\n      Raw Data: " << Format_Range(sh.Pointer_To_Raw_Data, sh.Size_Of_Raw_Data)
@@ -221,63 +268,151 @@ void Show_MZ_Section_Header(MZ const& mz, int i, MZ::Section_Header const& sh, b
     auto const characteristics = Get_Section_Characteristics_Names(sh.Characteristics);
 
     for (auto const ch: characteristics)
-        cout << "\n        " << ch;
+        out << "\n        " << ch;
+
+    if (arguments.Get_Switch("--entropy"))
+    {
+        // Sections without file contents (.bss) have nothing to count.
+        auto const contents =
+            MZ::Has_File_Data(sh)
+                ? mz.Get_Range(sh.Pointer_To_Raw_Data, sh.Size_Of_Raw_Data)
+                : std::string_view{};
+
+        auto const histogram = Get_Byte_Histogram(contents, arguments);
 
-    cout << std::endl;
+        out << "\n      Entropy: " << Format_Entropy(Get_Entropy(histogram)) << " bits/byte";
+    }
+
+    out << '\n';
 }
 
-void Show_MZ_Section_Table(MZ const& mz, bool verbose)
+void Show_MZ_Section_Table(MZ const& mz, bool verbose, Command_Line_Arguments const& arguments, std::ostream& out)
 {
     auto const Number_Of_Sections = mz.Get_Number_of_Sections();
 
-    cout << "\n  Image has " << Number_Of_Sections << " sections:";
+    out << "\n  Image has " << Number_Of_Sections << " sections:";
 
     for (int i = 0; i < Number_Of_Sections; ++i)
-        Show_MZ_Section_Header(mz, i, mz.Get_Section_Header(i), verbose);
+        Show_MZ_Section_Header(mz, i, mz.Get_Section_Header(i), verbose, arguments, out);
 }
 
-void Show_Imports(MZ const& mz, bool verbose)
+void Show_Imports(MZ const& mz, bool verbose, std::ostream& out)
 {
-    auto const* entry = mz.Get_Import_Table();
+    auto const libraries = mz.Get_Imports();
 
-    if (!entry)
+    if (libraries.empty())
     {
-        cout << "No import information available." << endl;
+        out << "No import information available." << '\n';
         return;
     }
 
-    for(;
-        entry->Import_Lookup_Table_RVA != 0;
-        ++entry)
+    for (auto const& library: libraries)
     {
-        std::cout
+        auto const& entry = library.Directory;
+
+        out
             << "\n  Import:"
-            << "\n    Import_Lookup_Table_RVA: " << entry->Import_Lookup_Table_RVA
-            << "\n    Time_Date_Stamp: " << entry->Time_Date_Stamp
-            << "\n    Forwarder_Chain: " << entry->Forwarder_Chain
-            << "\n    Name: (@" << entry->Name_RVA << ") " << mz.Get_String(entry->Name_RVA)
-            << "\n    Import_Address_Table_RVA: " << entry->Import_Address_Table_RVA;
+            << "\n    Import_Lookup_Table_RVA: " << entry.Import_Lookup_Table_RVA
+            << "\n    Time_Date_Stamp: " << entry.Time_Date_Stamp
+            << "\n    Forwarder_Chain: " << entry.Forwarder_Chain
+            << "\n    Name: (@" << entry.Name_RVA << ") " << library.Name
+            << "\n    Import_Address_Table_RVA: " << entry.Import_Address_Table_RVA;
 
         if (verbose)
         {
-            for(auto e = mz.Get_Import_Lookup_Table(entry->Import_Lookup_Table_RVA);
-                e->As_Uint64 != 0;
-                ++e)
+            for (auto const& function: library.Functions)
             {
-                if (e->Ordinal_Flag)
+                if (function.By_Ordinal)
                 {
-                    std::cout << "\n      Ordinal: " << e->Ordinal_Number;
+                    out << "\n      Ordinal: " << function.Ordinal;
                 } else {
-                    auto const entry = mz.Get_Hint_Name_Table_Entry(e->Hint_Or_Name_Table_RVA);
-
-                    std::cout << "\n      " << "Hint: " << entry->Hint << " Name: " << entry->Name;
+                    out << "\n      " << "Hint: " << function.Hint << " Name: " << function.Name;
                 }
             }
         }
 
-        std::cout << '\n';
+        out << '\n';
     }
 
     return;
 }
 
+void Show_Exports(MZ const& mz, std::ostream& out)
+{
+    auto const* exports = mz.Get_Export_Table();
+
+    if (!exports)
+    {
+        out << "No export information available." << '\n';
+        return;
+    }
+
+    auto const& directory = exports->Get_Directory();
+
+    out
+        << "\n  Exports:"
+        << "\n    Name: (@" << directory.Name_RVA << ") " << exports->Get_DLL_Name()
+        << "\n    Time_Date_Stamp: " << directory.Time_Date_Stamp
+        << "\n    Version: " << Build_Version(directory.Major_Version, directory.Minor_Version)
+        << "\n    Ordinal_Base: " << directory.Ordinal_Base
+        << "\n    Address_Table_Entries: " << directory.Address_Table_Entries
+        << "\n    Number_Of_Name_Pointers: " << directory.Number_Of_Name_Pointers
+        << '\n';
+
+    Table_Writer table {
+        "Ordinal",
+        "RVA",
+        "Name",
+        "Forwarder"
+    };
+
+    auto const names = exports->Get_Names_By_Address();
+
+    for (uint32_t i = 0; i < exports->size(); ++i)
+    {
+        auto const entry = exports->Get_Export(i);
+
+        if (entry.RVA == 0)
+            continue;
+
+        table
+            .Decimal(entry.Ordinal)
+            .Hexadecimal(entry.RVA)
+            .Text(names[i])
+            .Text(entry.Forwarder);
+    }
+
+    table.Print(out);
+}
+
+void Show_MZ_Symbol_Table(MZ::Symbol_Table const& symbols, std::ostream& out)
+{
+    out << "\n  COFF symbol table: " << std::dec << symbols.size() << " records" << std::hex << '\n';
+
+    Table_Writer table {
+        "Index",
+        "Value",
+        "Section_Number",
+        "Type",
+        "Storage_Class",
+        "Aux",
+        "Name"
+    };
+
+    for (uint32_t i = 0; i < symbols.size(); i = symbols.Next(i))
+    {
+        auto const& symbol = symbols[i];
+        bool const is_file = (symbol.Storage_Class == MZ::Symbol_Storage_Class::IMAGE_SYM_CLASS_FILE);
+
+        table
+            .Decimal(i)
+            .Hexadecimal(symbol.Value)
+            .Decimal(symbol.Section_Number)
+            .Hexadecimal(symbol.Type)
+            .Text(Get_Symbol_Storage_Class_Name(symbol.Storage_Class))
+            .Decimal(symbol.Number_Of_Aux_Symbols)
+            .Text(is_file ? symbols.Get_File_Name(i) : symbols.Get_Name(symbol));
+    }
+
+    table.Print(out);
+}
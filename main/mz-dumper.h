@@ -1,11 +1,13 @@
 #ifndef MZ_DUMPER_H__INCLUDED
 #define MZ_DUMPER_H__INCLUDED
 
+#include <ostream>
+
 #include <mz/mz.h>
 
 #include "command-line-arguments.h"
 
-void Show_MZ_File_Details(MZ const& mz, Command_Line_Arguments const& arguments);
+void Show_MZ_File_Details(MZ const& mz, Command_Line_Arguments const& arguments, std::ostream& out);
 
 #endif  // MZ_DUMPER_H__INCLUDED
 
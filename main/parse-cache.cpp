@@ -0,0 +1,488 @@
+#include "parse-cache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <hash/xxhash.h>
+
+#include "mapped-file.h"
+
+namespace fs = std::filesystem;
+
+using std::string;
+using std::string_view;
+
+static size_t Get_Index_Size(uint32_t slot_count)
+{
+    return sizeof(Parse_Cache::Index_Header) + (size_t(slot_count) * sizeof(Parse_Cache::Slot));
+}
+
+static bool Is_Valid_Slot_Count(uint32_t slot_count)
+{
+    return
+        (slot_count >= Parse_Cache::Initial_Slot_Count) &&
+        (slot_count <= Parse_Cache::Maximum_Slot_Count) &&
+        std::has_single_bit(slot_count);
+}
+
+//
+//  Holds the index for one update: the mutex keeps out the other threads of
+//  this process, which share its flock(), and the flock() keeps out other
+//  processes.
+//
+class Index_Lock
+{
+    private:
+        std::lock_guard<std::mutex> _guard;
+        int _fd;
+
+    public:
+        Index_Lock(Parse_Cache& cache): _guard{cache._mutex}, _fd{cache._index_fd}
+        {
+            while ((::flock(_fd, LOCK_EX) != 0) && (errno == EINTR))
+                ;
+        }
+
+        ~Index_Lock() { ::flock(_fd, LOCK_UN); }
+};
+
+// Identifies the build of the tool: any change to the code changes the binary.
+static uint64_t Get_Tool_Hash()
+{
+    auto const self = std::unique_ptr<Mapped_File>(Mapped_File::Open("/proc/self/exe", Mapped_File::Access_Pattern::Sequential));
+
+    return self ? XXH64(self->contents(), Parse_Cache::Version) : Parse_Cache::Version;
+}
+
+Parse_Cache::Parse_Cache(string directory, uint64_t size_limit, uint64_t tool_hash):
+    _directory{std::move(directory)},
+    _size_limit{size_limit},
+    _tool_hash{tool_hash},
+    _index_fd{-1},
+    _index{nullptr},
+    _slots{nullptr},
+    _slot_count{0}
+{}
+
+Parse_Cache* Parse_Cache::Open(string const& directory, uint64_t size_limit)
+{
+    std::error_code error;
+    fs::create_directories(directory, error);
+
+    if (error)
+    {
+        errno = error.value();
+        return nullptr;
+    }
+
+    auto cache = std::unique_ptr<Parse_Cache>(new Parse_Cache{directory, size_limit, Get_Tool_Hash()});
+
+    if (!cache->open_index())
+        return nullptr;
+
+    return cache.release();
+}
+
+//
+//  Writes an empty index under a temporary name and renames it over path.
+//  The old index is never truncated in place: a process that still has it
+//  mapped keeps a valid, if orphaned, mapping instead of taking SIGBUS.
+//
+static bool Replace_Index(string const& path)
+{
+    auto const temporary_path = path + '.' + std::to_string(::getpid()) + ".tmp";
+    int const fd = ::open(temporary_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd < 0)
+        return false;
+
+    Parse_Cache::Index_Header header {};
+    std::memcpy(header.Magic, Parse_Cache::Index_Magic.data(), sizeof(header.Magic));
+    header.Version = Parse_Cache::Version;
+    header.Slot_Count = Parse_Cache::Initial_Slot_Count;
+
+    bool const written =
+        (::ftruncate(fd, Get_Index_Size(Parse_Cache::Initial_Slot_Count)) == 0) &&
+        (::pwrite(fd, &header, sizeof(header), 0) == sizeof(header));
+
+    ::close(fd);
+
+    if (!written || (std::rename(temporary_path.c_str(), path.c_str()) != 0))
+    {
+        std::remove(temporary_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+//
+//  Opens and maps the index, replacing a missing, foreign or older one; its
+//  entries are orphaned.  The lock is taken on the open file, so after it is
+//  held the file has to be checked to still be the one named "index":
+//  another process may have replaced it meanwhile, and then it is opened
+//  again.
+//
+bool Parse_Cache::open_index()
+{
+    auto const index_path = _directory + "/index";
+
+    // Each retry means another process replaced the index; a few are plenty.
+    for (int attempt = 0; attempt < 8; ++attempt)
+    {
+        if (_index_fd >= 0)
+            ::close(_index_fd);
+
+        _index_fd = ::open(index_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+        if (_index_fd < 0)
+            return false;
+
+        Index_Lock lock(*this);
+
+        struct stat status;
+        struct stat named;
+
+        if ((::fstat(_index_fd, &status) != 0) || (::stat(index_path.c_str(), &named) != 0))
+            return false;
+
+        if ((status.st_dev != named.st_dev) || (status.st_ino != named.st_ino))
+            continue;
+
+        Index_Header header {};
+        bool const valid =
+            (size_t(status.st_size) >= sizeof(header)) &&
+            (::pread(_index_fd, &header, sizeof(header), 0) == sizeof(header)) &&
+            (string_view(header.Magic, sizeof(header.Magic)) == Index_Magic) &&
+            (header.Version == Version) &&
+            Is_Valid_Slot_Count(header.Slot_Count) &&
+            (size_t(status.st_size) == Get_Index_Size(header.Slot_Count));
+
+        if (valid)
+            return map_index();
+
+        if (!Replace_Index(index_path))
+            return false;
+    }
+
+    errno = EAGAIN;
+    return false;
+}
+
+bool Parse_Cache::map_index()
+{
+    unmap_index();
+
+    Index_Header header;
+
+    if (::pread(_index_fd, &header, sizeof(header), 0) != sizeof(header) || !Is_Valid_Slot_Count(header.Slot_Count))
+        return false;
+
+    void* mapping = ::mmap(nullptr, Get_Index_Size(header.Slot_Count), PROT_READ | PROT_WRITE, MAP_SHARED, _index_fd, 0);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    _index = static_cast<Index_Header*>(mapping);
+    _slots = reinterpret_cast<Slot*>(_index + 1);
+    _slot_count = header.Slot_Count;
+
+    return true;
+}
+
+void Parse_Cache::unmap_index()
+{
+    if (_index != nullptr)
+        ::munmap(_index, Get_Index_Size(_slot_count));
+
+    _index = nullptr;
+    _slots = nullptr;
+    _slot_count = 0;
+}
+
+bool Parse_Cache::refresh_mapping()
+{
+    if ((_index != nullptr) && (_index->Slot_Count == _slot_count))
+        return true;
+
+    return map_index();
+}
+
+Parse_Cache::~Parse_Cache()
+{
+    unmap_index();
+
+    if (_index_fd >= 0)
+        ::close(_index_fd);
+}
+
+uint64_t Parse_Cache::Make_Key(string_view contents, string_view variant) const
+{
+    auto const key = XXH64(contents, XXH64(variant, _tool_hash));
+
+    // 0 marks an empty slot.
+    return (key == 0) ? 1 : key;
+}
+
+string Parse_Cache::get_entry_path(uint64_t key) const
+{
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+
+    return _directory + '/' + name;
+}
+
+// Linear probing; the table is grown before it is more than three quarters full.
+Parse_Cache::Slot* Parse_Cache::find_slot(uint64_t key)
+{
+    auto const mask = _slot_count - 1;
+
+    for (uint32_t i = 0, slot = key & mask; i < _slot_count; ++i, slot = (slot + 1) & mask)
+    {
+        if ((_slots[slot].Key == key) || (_slots[slot].Key == 0))
+            return &_slots[slot];
+    }
+
+    return nullptr;
+}
+
+//
+//  Backward-shift deletion: entries later in the same probe run move into
+//  the hole unless that would put them before their home slot, so no
+//  lookup stops early at an empty slot and no tombstones build up.
+//
+void Parse_Cache::remove_slot(Slot* slot)
+{
+    auto const mask = _slot_count - 1;
+    uint32_t hole = uint32_t(slot - _slots);
+
+    for (uint32_t next = (hole + 1) & mask; _slots[next].Key != 0; next = (next + 1) & mask)
+    {
+        uint32_t const home = _slots[next].Key & mask;
+
+        // Whether home lies cyclically in (hole, next]; if so the entry has to stay.
+        bool const stays = (hole <= next) ? ((hole < home) && (home <= next)) : ((hole < home) || (home <= next));
+
+        if (!stays)
+        {
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+    }
+
+    _slots[hole] = Slot {};
+    --_index->Entry_Count;
+}
+
+bool Parse_Cache::Load(uint64_t key, uint64_t content_size, string& report, int& result)
+{
+    {
+        Index_Lock lock(*this);
+
+        if (!refresh_mapping())
+            return false;
+
+        auto* slot = find_slot(key);
+
+        if ((slot == nullptr) || (slot->Key != key))
+            return false;
+
+        slot->Last_Used = ++_index->Clock;
+    }
+
+    auto entry = std::unique_ptr<Mapped_File>(Mapped_File::Open(get_entry_path(key), Mapped_File::Access_Pattern::Sequential));
+
+    if (!entry || (entry->size() < sizeof(Entry_Header)))
+        return false;
+
+    Entry_Header header;
+    std::memcpy(&header, entry->contents().data(), sizeof(header));
+
+    if ((string_view(header.Magic, sizeof(header.Magic)) != Entry_Magic) ||
+        (header.Key != key) ||
+        (header.Content_Size != content_size) ||
+        (header.Report_Size != entry->size() - sizeof(Entry_Header)))
+        return false;
+
+    report = entry->contents().substr(sizeof(Entry_Header));
+    result = header.Result;
+
+    return true;
+}
+
+void Parse_Cache::Store(uint64_t key, uint64_t content_size, string_view report, int result)
+{
+    auto const path = get_entry_path(key);
+    auto const temporary_path =
+        path + '.' + std::to_string(::getpid()) + '.' +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    Entry_Header header {};
+    std::memcpy(header.Magic, Entry_Magic.data(), sizeof(header.Magic));
+    header.Key = key;
+    header.Content_Size = content_size;
+    header.Report_Size = report.size();
+    header.Result = result;
+
+    {
+        std::ofstream entry(temporary_path, std::ios::binary | std::ios::trunc);
+
+        entry.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        entry.write(report.data(), report.size());
+
+        if (!entry.flush())
+        {
+            std::remove(temporary_path.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary_path.c_str());
+        return;
+    }
+
+    Index_Lock lock(*this);
+
+    if (!refresh_mapping())
+        return;
+
+    if ((_index->Entry_Count >= (_slot_count / 4) * 3) && !grow())
+        evict();
+
+    auto* slot = find_slot(key);
+
+    if (slot == nullptr)
+        return;
+
+    auto const size = sizeof(Entry_Header) + report.size();
+
+    if (slot->Key == key)
+    {
+        _index->Total_Size -= slot->Size;
+    } else {
+        slot->Key = key;
+        ++_index->Entry_Count;
+    }
+
+    slot->Size = size;
+    slot->Last_Used = ++_index->Clock;
+    _index->Total_Size += size;
+
+    if (_index->Total_Size > _size_limit)
+        evict();
+}
+
+//
+//  Doubles the table and puts every entry back.  The header's slot count
+//  changes last, after the file has its new size, so another process that
+//  reads it can map the whole table.  Called with the index locked.
+//
+bool Parse_Cache::grow()
+{
+    if (_slot_count >= Maximum_Slot_Count)
+        return false;
+
+    auto const new_slot_count = _slot_count * 2;
+
+    std::vector<Slot> entries;
+    entries.reserve(_index->Entry_Count);
+
+    for (uint32_t i = 0; i < _slot_count; ++i)
+        if (_slots[i].Key != 0)
+            entries.push_back(_slots[i]);
+
+    if (::ftruncate(_index_fd, Get_Index_Size(new_slot_count)) != 0)
+        return false;
+
+    void* mapping = ::mmap(nullptr, Get_Index_Size(new_slot_count), PROT_READ | PROT_WRITE, MAP_SHARED, _index_fd, 0);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    ::munmap(_index, Get_Index_Size(_slot_count));
+
+    _index = static_cast<Index_Header*>(mapping);
+    _slots = reinterpret_cast<Slot*>(_index + 1);
+    _slot_count = new_slot_count;
+
+    std::fill(_slots, _slots + _slot_count, Slot {});
+
+    for (auto const& entry: entries)
+        *find_slot(entry.Key) = entry;
+
+    _index->Slot_Count = new_slot_count;
+
+    return true;
+}
+
+//
+//  Drops the least recently used entries, oldest first, until the cache is
+//  back to 90% of its size limit and the table is at most three quarters
+//  full, but never more than Eviction_Batch of them: one pass over the
+//  table picks the candidates, so a cache that is still too big sheds
+//  more on the next Store.  Called with the index locked.
+//
+void Parse_Cache::evict()
+{
+    auto const newer = [](Slot const& a, Slot const& b) { return a.Last_Used < b.Last_Used; };
+
+    // A max-heap of the oldest entries seen so far, newest on top.
+    std::vector<Slot> oldest;
+    oldest.reserve(Eviction_Batch);
+
+    for (uint32_t i = 0; i < _slot_count; ++i)
+    {
+        auto const& slot = _slots[i];
+
+        if (slot.Key == 0)
+            continue;
+
+        if (oldest.size() < Eviction_Batch)
+        {
+            oldest.push_back(slot);
+            std::push_heap(oldest.begin(), oldest.end(), newer);
+        }
+        else if (slot.Last_Used < oldest.front().Last_Used)
+        {
+            std::pop_heap(oldest.begin(), oldest.end(), newer);
+            oldest.back() = slot;
+            std::push_heap(oldest.begin(), oldest.end(), newer);
+        }
+    }
+
+    std::sort_heap(oldest.begin(), oldest.end(), newer);
+
+    auto const size_target = (_size_limit / 10) * 9;
+    auto const count_target = (_slot_count / 4) * 3;
+
+    for (auto const& entry: oldest)
+    {
+        if ((_index->Total_Size <= size_target) && (_index->Entry_Count < count_target))
+            break;
+
+        if (auto* slot = find_slot(entry.Key); slot && (slot->Key == entry.Key))
+        {
+            std::remove(get_entry_path(entry.Key).c_str());
+            _index->Total_Size -= slot->Size;
+            remove_slot(slot);
+        }
+    }
+}
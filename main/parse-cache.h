@@ -0,0 +1,135 @@
+#ifndef PARSE_CACHE_H__INCLUDED
+#define PARSE_CACHE_H__INCLUDED
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <include/interface.h>
+
+//
+//  A persistent, content-addressed cache of reports.  An entry is keyed by
+//  the XXH64 of the input bytes, seeded with a hash of the bintool binary
+//  itself and of everything else the report depends on (output format,
+//  switches), so a rebuilt tool or a different command line never sees a
+//  stale report.
+//
+//  Each report is one file in the cache directory.  The "index" file next
+//  to them is an open-addressed hash table that every process using the
+//  cache maps shared; it records the size and last use of each entry so
+//  that the least recently used ones can be evicted when the cache
+//  outgrows its size limit.  The table doubles when it fills up, so the
+//  number of entries is bounded only by the size limit; other processes
+//  notice the new slot count in the header and map the index again.  The
+//  index is guarded by flock() between processes and by a mutex between
+//  the threads of one process.  Reports are written to a temporary file and
+//  renamed into place, so a reader never sees half of one; an index from
+//  another version is replaced the same way, never truncated under a
+//  process that has it mapped.
+//
+//  Only whole text and JSON reports are cached, and a hit still costs
+//  hashing the input and reading the entry: the cache pays off when a
+//  report is costly to make (--hashes, --entropy, --strings, --signatures)
+//  and barely breaks even on the plain report of a small file.  The
+//  columnar format and --import-graph do not use it.
+//
+class Parse_Cache: public Base_Class
+{
+    public:
+        struct __attribute__((packed)) Index_Header
+        {
+            char Magic[8];
+            uint32_t Version;
+            uint32_t Slot_Count;
+            uint64_t Clock;
+            uint64_t Total_Size;
+            uint64_t Entry_Count;
+            uint8_t Reserved[24];
+        };
+
+        // Key 0 marks an empty slot.
+        struct __attribute__((packed)) Slot
+        {
+            uint64_t Key;
+            uint64_t Size;
+            uint64_t Last_Used;
+            uint64_t Reserved;
+        };
+
+        struct __attribute__((packed)) Entry_Header
+        {
+            char Magic[8];
+            uint64_t Key;
+            uint64_t Content_Size;
+            uint64_t Report_Size;
+            int32_t Result;
+            uint32_t Reserved;
+        };
+
+        static constexpr std::string_view Index_Magic = "BTCACHE1";
+        static constexpr std::string_view Entry_Magic = "BTENTRY1";
+        static constexpr uint32_t Version = 2;
+        static constexpr uint32_t Initial_Slot_Count = 1 << 16;
+        static constexpr uint32_t Maximum_Slot_Count = 1 << 24;
+
+        // At most this many entries are evicted per Store, so no update holds the index for long.
+        static constexpr size_t Eviction_Batch = 64;
+
+    private:
+        std::string _directory;
+        uint64_t _size_limit;
+        uint64_t _tool_hash;
+
+        int _index_fd;
+        Index_Header* _index;
+        Slot* _slots;
+        uint32_t _slot_count;
+
+        std::mutex _mutex;
+
+        Parse_Cache(std::string directory, uint64_t size_limit, uint64_t tool_hash);
+
+        bool open_index();
+
+        // Maps the index at the slot count in its header; called with the index locked.
+        bool map_index();
+        void unmap_index();
+
+        // Maps the index again if another process has grown it; called with the index locked.
+        bool refresh_mapping();
+
+        std::string get_entry_path(uint64_t key) const;
+
+        Slot* find_slot(uint64_t key);
+        void remove_slot(Slot* slot);
+
+        bool grow();
+        void evict();
+
+        friend class Index_Lock;
+
+    public:
+        // Returns nullptr, with errno set, if the directory or its index cannot be set up.
+        static Parse_Cache* Open(std::string const& directory, uint64_t size_limit);
+
+        Parse_Cache(Parse_Cache const&) = delete;
+        Parse_Cache& operator=(Parse_Cache const&) = delete;
+
+        ~Parse_Cache() override;
+
+        // The cache key of the contents for one configuration (variant) of the tool.
+        uint64_t Make_Key(std::string_view contents, std::string_view variant) const;
+
+        //
+        //  Fetches the report stored under the key into report and its
+        //  result code into result.  Returns false on a miss, including an
+        //  entry that was evicted or damaged since the index was updated.
+        //
+        bool Load(uint64_t key, uint64_t content_size, std::string& report, int& result);
+
+        // Stores a report; failures only mean the next run misses.
+        void Store(uint64_t key, uint64_t content_size, std::string_view report, int result);
+};
+
+#endif  // PARSE_CACHE_H__INCLUDED
@@ -0,0 +1,421 @@
+#include "resource-dumper.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <mz/mz.h>
+
+#include "json-writer.h"
+#include "table-writer.h"
+
+using std::string_view;
+
+static constexpr uint32_t Fixed_File_Info_Signature = 0xfeef04bd;
+
+// VS_FIXEDFILEINFO, the value of the root VS_VERSIONINFO block.
+struct __attribute__((packed)) Fixed_File_Info
+{
+    uint32_t Signature;
+    uint32_t Structure_Version;
+    uint32_t File_Version_MS;
+    uint32_t File_Version_LS;
+    uint32_t Product_Version_MS;
+    uint32_t Product_Version_LS;
+    uint32_t File_Flags_Mask;
+    uint32_t File_Flags;
+    uint32_t File_OS;
+    uint32_t File_Type;
+    uint32_t File_Subtype;
+    uint32_t File_Date_MS;
+    uint32_t File_Date_LS;
+};
+
+//
+//  One block of a version resource: a length, a value length and a type,
+//  a NUL-terminated UTF-16LE key, then the value and the child blocks,
+//  each aligned to 4 bytes from the start of the resource.
+//
+struct Version_Block
+{
+    string_view Key;            // UTF-16LE bytes, without the NUL.
+    string_view Value;
+    string_view Children;
+};
+
+static uint16_t Read_UTF16_Unit(string_view bytes, size_t offset)
+{
+    uint16_t unit;
+    std::memcpy(&unit, bytes.data() + offset, sizeof(unit));
+
+    return unit;
+}
+
+static size_t Align_4(size_t offset)
+{
+    return (offset + 3) & ~size_t(3);
+}
+
+//
+//  Reads the block at offset within resource; block_end is set to the
+//  offset of the next sibling.  Nothing when the block does not fit.
+//
+static std::optional<Version_Block> Read_Version_Block(string_view resource, size_t offset, size_t& block_end)
+{
+    if (offset + 6 > resource.size())
+        return std::nullopt;
+
+    auto const length = Read_UTF16_Unit(resource, offset);
+    auto const value_length = Read_UTF16_Unit(resource, offset + 2);
+    auto const is_text = Read_UTF16_Unit(resource, offset + 4) == 1;
+
+    if ((length < 6) || (offset + length > resource.size()))
+        return std::nullopt;
+
+    auto const end = offset + length;
+    auto key_end = offset + 6;
+
+    while ((key_end + 2 <= end) && (Read_UTF16_Unit(resource, key_end) != 0))
+        key_end += 2;
+
+    if (key_end + 2 > end)
+        return std::nullopt;
+
+    Version_Block block;
+    block.Key = resource.substr(offset + 6, key_end - (offset + 6));
+
+    auto const value_start = std::min(Align_4(key_end + 2), end);
+    auto const value_size = std::min<size_t>(is_text ? value_length * 2 : value_length, end - value_start);
+
+    block.Value = resource.substr(value_start, value_size);
+
+    auto const children_start = std::min(Align_4(value_start + value_size), end);
+    block.Children = resource.substr(children_start, end - children_start);
+
+    block_end = Align_4(end);
+
+    return block;
+}
+
+// Calls visit for each block in children, which lies within resource.
+template<typename Visitor>
+static void For_Each_Version_Block(string_view resource, string_view children, Visitor&& visit)
+{
+    auto offset = size_t(children.data() - resource.data());
+    auto const end = offset + children.size();
+
+    while (offset < end)
+    {
+        size_t next;
+        auto const block = Read_Version_Block(resource.substr(0, end), offset, next);
+
+        if (!block)
+            break;
+
+        visit(*block);
+        offset = next;
+    }
+}
+
+// UTF-16LE bytes -> UTF-8, stopping at a NUL; unpaired surrogates become U+FFFD.
+static std::string To_UTF8(string_view utf16)
+{
+    std::string result;
+    result.reserve(utf16.size() / 2);
+
+    for (size_t i = 0; i + 2 <= utf16.size(); i += 2)
+    {
+        uint32_t c = Read_UTF16_Unit(utf16, i);
+
+        if (c == 0)
+            break;
+
+        if ((c >= 0xd800) && (c < 0xdc00) && (i + 4 <= utf16.size()))
+        {
+            auto const low = Read_UTF16_Unit(utf16, i + 2);
+
+            if ((low >= 0xdc00) && (low < 0xe000))
+            {
+                c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+                i += 2;
+            }
+        }
+
+        if ((c >= 0xd800) && (c < 0xe000))
+            c = 0xfffd;
+
+        if (c < 0x80)
+        {
+            result += char(c);
+        }
+        else if (c < 0x800)
+        {
+            result += char(0xc0 | (c >> 6));
+            result += char(0x80 | (c & 0x3f));
+        }
+        else if (c < 0x10000)
+        {
+            result += char(0xe0 | (c >> 12));
+            result += char(0x80 | ((c >> 6) & 0x3f));
+            result += char(0x80 | (c & 0x3f));
+        } else {
+            result += char(0xf0 | (c >> 18));
+            result += char(0x80 | ((c >> 12) & 0x3f));
+            result += char(0x80 | ((c >> 6) & 0x3f));
+            result += char(0x80 | (c & 0x3f));
+        }
+    }
+
+    return result;
+}
+
+static bool Is_Key(Version_Block const& block, std::u16string_view key)
+{
+    if (block.Key.size() != key.size() * 2)
+        return false;
+
+    for (size_t i = 0; i < key.size(); ++i)
+        if (Read_UTF16_Unit(block.Key, i * 2) != key[i])
+            return false;
+
+    return true;
+}
+
+struct Version_Information
+{
+    std::string File_Version;
+    std::string Product_Version;
+
+    // StringFileInfo keys and values, from every string table.
+    std::vector<std::pair<std::string, std::string>> Strings;
+};
+
+static std::string Build_Four_Part_Version(uint32_t most_significant, uint32_t least_significant)
+{
+    return
+        std::to_string(most_significant >> 16) + '.' + std::to_string(most_significant & 0xffff) + '.' +
+        std::to_string(least_significant >> 16) + '.' + std::to_string(least_significant & 0xffff);
+}
+
+// Only the path to the first RT_VERSION resource is read.
+static std::optional<Version_Information> Get_Version_Information(MZ const& mz)
+{
+    auto const resource = mz.Find_Resource(uint32_t(MZ::Resource_Type::Version));
+
+    if (!resource)
+        return std::nullopt;
+
+    size_t end;
+    auto const root = Read_Version_Block(*resource, 0, end);
+
+    if (!root || !Is_Key(*root, u"VS_VERSION_INFO"))
+        return std::nullopt;
+
+    Version_Information information;
+
+    if (root->Value.size() >= sizeof(Fixed_File_Info))
+    {
+        Fixed_File_Info info;
+        std::memcpy(&info, root->Value.data(), sizeof(info));
+
+        if (info.Signature == Fixed_File_Info_Signature)
+        {
+            information.File_Version = Build_Four_Part_Version(info.File_Version_MS, info.File_Version_LS);
+            information.Product_Version = Build_Four_Part_Version(info.Product_Version_MS, info.Product_Version_LS);
+        }
+    }
+
+    For_Each_Version_Block(*resource, root->Children, [&](Version_Block const& file_info) {
+        if (!Is_Key(file_info, u"StringFileInfo"))
+            return;
+
+        For_Each_Version_Block(*resource, file_info.Children, [&](Version_Block const& string_table) {
+            For_Each_Version_Block(*resource, string_table.Children, [&](Version_Block const& string) {
+                information.Strings.emplace_back(To_UTF8(string.Key), To_UTF8(string.Value));
+            });
+        });
+    });
+
+    return information;
+}
+
+//
+//  One data entry with the entries on the path to it.  Trees with fewer
+//  levels than usual leave the missing ones empty; deeper ones show the
+//  first three.
+//
+struct Resource_Leaf
+{
+    MZ::Resource_Directory::Entry const* Path[3];
+    MZ::Resource_Directory::Data const& Data;
+};
+
+//
+//  Each directory is walked once, at the first entry that leads to it:
+//  entries of a crafted tree may point back at the root or share
+//  subdirectories, and Maximum_Depth alone still lets that cost
+//  entries^depth visits.  visited holds the offsets of directories seen.
+//
+static void For_Each_Resource(
+        MZ::Resource_Directory const& directory,
+        MZ::Resource_Directory::Entry const* (&path)[3],
+        std::unordered_set<uint32_t>& visited,
+        std::function<void(Resource_Leaf const&)> const& visit)
+{
+    for (size_t i = 0; i < directory.size(); ++i)
+    {
+        auto const entry = directory.Get_Entry(i);
+        auto const depth = directory.Get_Depth();
+
+        if (depth < std::size(path))
+            path[depth] = &entry;
+
+        if (entry.Is_Directory)
+        {
+            if (!visited.insert(entry.Offset).second)
+                continue;
+
+            if (auto const subdirectory = directory.Get_Directory(entry))
+                For_Each_Resource(*subdirectory, path, visited, visit);
+        }
+        else if (auto const data = directory.Get_Data(entry))
+        {
+            Resource_Leaf leaf { { nullptr, nullptr, nullptr }, *data };
+
+            for (size_t level = 0; (level <= depth) && (level < std::size(path)); ++level)
+                leaf.Path[level] = path[level];
+
+            visit(leaf);
+        }
+    }
+}
+
+static void For_Each_Resource(MZ const& mz, std::function<void(Resource_Leaf const&)> const& visit)
+{
+    auto const root = mz.Get_Resource_Directory();
+
+    if (!root)
+        return;
+
+    MZ::Resource_Directory::Entry const* path[3] = { nullptr, nullptr, nullptr };
+    std::unordered_set<uint32_t> visited { 0 };
+
+    For_Each_Resource(*root, path, visited, visit);
+}
+
+static std::string Get_Entry_Label(MZ::Resource_Directory::Entry const* entry, bool is_type)
+{
+    if (entry == nullptr)
+        return {};
+
+    if (!entry->Name.empty())
+        return To_UTF8(entry->Name);
+
+    if (is_type)
+        if (auto const name = Get_Resource_Type_Name(MZ::Resource_Type(entry->ID)); !name.empty())
+            return std::string(name);
+
+    return std::to_string(entry->ID);
+}
+
+void Show_Resources(MZ const& mz, std::ostream& out)
+{
+    Table_Writer table {
+        "Type",
+        "Name",
+        "Language",
+        "RVA",
+        "Size",
+        "Codepage"
+    };
+
+    For_Each_Resource(mz, [&](Resource_Leaf const& leaf) {
+        table
+            .Text(Get_Entry_Label(leaf.Path[0], true))
+            .Text(Get_Entry_Label(leaf.Path[1], false))
+            .Text(Get_Entry_Label(leaf.Path[2], false))
+            .Hexadecimal(leaf.Data.Entry.Data_RVA)
+            .Hexadecimal(leaf.Data.Entry.Size)
+            .Decimal(leaf.Data.Entry.Codepage);
+    });
+
+    if (table.Row_Count() == 0)
+    {
+        out << "No resources." << '\n';
+        return;
+    }
+
+    out << "\n  Resources:" << '\n';
+    table.Print(out);
+
+    auto const version = Get_Version_Information(mz);
+
+    if (!version)
+        return;
+
+    out << "  Version information:";
+
+    if (!version->File_Version.empty())
+    {
+        out
+            << "\n    File_Version: " << version->File_Version
+            << "\n    Product_Version: " << version->Product_Version;
+    }
+
+    for (auto const& [key, value]: version->Strings)
+        out << "\n    " << key << ": " << value;
+
+    out << '\n';
+}
+
+void Write_Resources_JSON(MZ const& mz, JSON_Writer& json)
+{
+    json.Key("resources").Begin_Array();
+
+    For_Each_Resource(mz, [&](Resource_Leaf const& leaf) {
+        json
+            .Begin_Object()
+            .Field("type", Get_Entry_Label(leaf.Path[0], true))
+            .Field("name", Get_Entry_Label(leaf.Path[1], false))
+            .Field("language", Get_Entry_Label(leaf.Path[2], false))
+            .Field("rva", leaf.Data.Entry.Data_RVA)
+            .Field("size", leaf.Data.Entry.Size)
+            .Field("codepage", leaf.Data.Entry.Codepage)
+            .End_Object();
+    });
+
+    json.End_Array();
+    json.Key("version_info");
+
+    auto const version = Get_Version_Information(mz);
+
+    if (!version)
+    {
+        json.Null();
+        return;
+    }
+
+    json.Begin_Object();
+
+    if (!version->File_Version.empty())
+    {
+        json
+            .Field("file_version", version->File_Version)
+            .Field("product_version", version->Product_Version);
+    }
+
+    json.Key("strings").Begin_Object();
+
+    for (auto const& [key, value]: version->Strings)
+        json.Field(key, value);
+
+    json.End_Object();
+    json.End_Object();
+}
@@ -0,0 +1,19 @@
+#ifndef RESOURCE_DUMPER_H__INCLUDED
+#define RESOURCE_DUMPER_H__INCLUDED
+
+#include <ostream>
+
+#include <mz/mz.h>
+
+#include "json-writer.h"
+
+//
+//  --resources: one row (or JSON record) per data entry of the resource
+//  tree, with its type, name or ID, language, RVA, size and codepage, and
+//  the fixed file and product versions and the StringFileInfo strings of
+//  the first RT_VERSION resource.
+//
+void Show_Resources(MZ const& mz, std::ostream& out);
+void Write_Resources_JSON(MZ const& mz, JSON_Writer& json);
+
+#endif  // RESOURCE_DUMPER_H__INCLUDED
@@ -0,0 +1,130 @@
+#include "signature-dumper.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <hash/xxhash.h>
+
+#include "mapped-file.h"
+#include "strings-dumper.h"
+#include "table-writer.h"
+
+using std::string;
+using std::unique_ptr;
+
+struct Loaded_Signatures
+{
+    unique_ptr<Signature_Set> Set;
+    uint64_t Rules_Hash;
+};
+
+static Loaded_Signatures const& Load_Signatures(Command_Line_Arguments const& arguments)
+{
+    static Loaded_Signatures const loaded = [&]() -> Loaded_Signatures
+    {
+        auto const file_name = arguments.Get_Parameter("--signatures");
+
+        if (file_name.empty())
+            return { nullptr, 0 };
+
+        auto const rules = unique_ptr<Mapped_File>(Mapped_File::Open(file_name, Mapped_File::Access_Pattern::Sequential));
+
+        if (!rules)
+        {
+            std::cerr << "Could not open signatures " << file_name << ": " << std::strerror(errno) << '\n';
+            return { nullptr, 0 };
+        }
+
+        string error;
+        auto set = unique_ptr<Signature_Set>(Signature_Set::Compile(rules->contents(), error));
+
+        if (!set)
+        {
+            std::cerr << "Could not load signatures " << file_name << ": " << error << '\n';
+            return { nullptr, 0 };
+        }
+
+        return { std::move(set), XXH64(rules->contents()) };
+    }();
+
+    return loaded;
+}
+
+Signature_Set const* Get_Signature_Set(Command_Line_Arguments const& arguments)
+{
+    return Load_Signatures(arguments).Set.get();
+}
+
+uint64_t Get_Signature_Rules_Hash(Command_Line_Arguments const& arguments)
+{
+    return Load_Signatures(arguments).Rules_Hash;
+}
+
+template<typename Report>
+static void For_Each_Match(Parsed_File const& parsed_file, Signature_Set const& signatures, Report&& report)
+{
+    for (auto const& region: Get_String_Regions(parsed_file))
+    {
+        signatures.Scan(
+            region.Contents,
+            [&](size_t signature, uint64_t offset) { report(signatures[signature], region, offset); });
+    }
+}
+
+void Show_Signature_Matches(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, std::ostream& out)
+{
+    auto const* signatures = Get_Signature_Set(arguments);
+
+    if (signatures == nullptr)
+        return;
+
+    out << "Signature matches:" << '\n';
+
+    Table_Writer table {
+        "Signature",
+        "Region",
+        "Offset",
+        "Address"
+    };
+
+    For_Each_Match(
+        parsed_file, *signatures,
+        [&](Signature_Set::Signature const& signature, String_Region const& region, uint64_t offset)
+        {
+            table
+                .Text(signature.Name)
+                .Text(region.Name)
+                .Hexadecimal(region.Offset + offset)
+                .Hexadecimal(region.Address + offset);
+        });
+
+    table.Print(out);
+}
+
+void Write_Signature_Matches_JSON(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, JSON_Writer& json)
+{
+    auto const* signatures = Get_Signature_Set(arguments);
+
+    if (signatures == nullptr)
+        return;
+
+    json.Key("signatures").Begin_Array();
+
+    For_Each_Match(
+        parsed_file, *signatures,
+        [&](Signature_Set::Signature const& signature, String_Region const& region, uint64_t offset)
+        {
+            json
+                .Begin_Object()
+                .Field("name", signature.Name)
+                .Field("region", region.Name)
+                .Field("offset", region.Offset + offset)
+                .Field("address", region.Address + offset)
+                .End_Object();
+        });
+
+    json.End_Array();
+}
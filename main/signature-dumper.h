@@ -0,0 +1,30 @@
+#ifndef SIGNATURE_DUMPER_H__INCLUDED
+#define SIGNATURE_DUMPER_H__INCLUDED
+
+#include <cstdint>
+#include <ostream>
+
+#include <analysis/signatures.h>
+#include <include/file-format.h>
+
+#include "command-line-arguments.h"
+#include "json-writer.h"
+
+//
+//  The rules named by --signatures, compiled once per process and shared
+//  read-only by all batch workers.  nullptr when there are none or they do
+//  not load; the reason is reported on std::cerr once.
+//
+Signature_Set const* Get_Signature_Set(Command_Line_Arguments const& arguments);
+
+// The XXH64 of the rules text, so that cached reports go stale when the rules change.
+uint64_t Get_Signature_Rules_Hash(Command_Line_Arguments const& arguments);
+
+//
+//  --signatures: every match of every rule in the same regions --strings
+//  searches, with the region, file offset and address of its first byte.
+//
+void Show_Signature_Matches(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, std::ostream& out);
+void Write_Signature_Matches_JSON(Parsed_File const& parsed_file, Command_Line_Arguments const& arguments, JSON_Writer& json);
+
+#endif  // SIGNATURE_DUMPER_H__INCLUDED
@@ -0,0 +1,173 @@
+#include "strings-dumper.h"
+
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <analysis/strings.h>
+#include <elf/elf.h>
+#include <include/file-format.h>
+#include <mz/mz.h>
+
+#include "json-writer.h"
+
+using std::string_view;
+
+using namespace ELF_Format;
+
+// The shortest run reported, as in strings(1).
+static size_t const Minimum_String_Length = 4;
+
+template<typename Layout>
+static void Add_ELF_String_Regions(ELF_File<Layout> const& elf, std::vector<String_Region>& regions)
+{
+    for (auto const& entry: elf.Get_Section_Header_Table())
+    {
+        auto const type = Section_Type(uint32_t(entry.Type));
+
+        if ((type == Section_Type::Null) || (type == Section_Type::No_Bits) || (entry.Size == 0))
+            continue;
+
+        regions.push_back(
+            String_Region {
+                elf.Get_Section_Name(entry), entry.Segment_Offset, entry.Virtual_Address,
+                elf.Get_Range(entry.Segment_Offset, entry.Size) });
+    }
+
+    if (!regions.empty())
+        return;
+
+    // Stripped of its section table: fall back to what the loader maps.
+    for (auto const& entry: elf.Get_Program_Header_Table())
+    {
+        if (Segment_Type(uint32_t(entry.Type)) != Segment_Type::Load)
+            continue;
+
+        regions.push_back(
+            String_Region {
+                Get_Segment_Type_Name(entry.Type), entry.Segment_Offset, entry.Virtual_Address,
+                elf.Get_Range(entry.Segment_Offset, entry.Size_In_File) });
+    }
+}
+
+static void Add_MZ_String_Regions(MZ const& mz, std::vector<String_Region>& regions)
+{
+    for (uint16_t i = 0; i < mz.Get_Number_of_Sections(); ++i)
+    {
+        auto const& sh = mz.Get_Section_Header(i);
+
+        if (!MZ::Has_File_Data(sh))
+            continue;
+
+        regions.push_back(
+            String_Region {
+                mz.Get_Section_Name(sh), sh.Pointer_To_Raw_Data, sh.Virtual_Address,
+                mz.Get_Range(sh.Pointer_To_Raw_Data, sh.Size_Of_Raw_Data) });
+    }
+}
+
+std::vector<String_Region> Get_String_Regions(Parsed_File const& parsed_file)
+{
+    std::vector<String_Region> regions;
+
+    switch (parsed_file.Get_File_Format())
+    {
+        case File_Format::ELF_Executable:
+        case File_Format::ELF_Object:
+        case File_Format::ELF_Shared_Object:
+        case File_Format::ELF_Core_Dump:
+        case File_Format::ELF64_Executable:
+        case File_Format::ELF64_Object:
+        case File_Format::ELF64_Shared_Object:
+        case File_Format::ELF64_Core_Dump:
+            Visit(
+                static_cast<ELF const&>(parsed_file),
+                [&](auto const& elf) { Add_ELF_String_Regions(elf, regions); });
+            break;
+
+        case File_Format::MZ_Executable:
+        case File_Format::MZ_Object:
+        case File_Format::MZ_DLL:
+        case File_Format::MZ_Library:
+            Add_MZ_String_Regions(static_cast<MZ const&>(parsed_file), regions);
+            break;
+
+        default:
+            break;
+    }
+
+    return regions;
+}
+
+static string_view Get_Encoding_Name(String_Encoding encoding)
+{
+    return (encoding == String_Encoding::ASCII) ? "ascii" : "utf-16le";
+}
+
+template<typename T>
+static void Append_Hexadecimal(std::string& line, T value)
+{
+    char digits[24];
+    auto const result = std::to_chars(std::begin(digits), std::end(digits), value, 16);
+
+    line.append(digits, result.ptr);
+}
+
+void Show_Strings(Parsed_File const& parsed_file, std::ostream& out)
+{
+    out << "Strings (region, file offset, address, a: ASCII or u: UTF-16LE, text):" << '\n';
+
+    std::string line;
+
+    for (auto const& region: Get_String_Regions(parsed_file))
+    {
+        Find_Strings(
+            region.Contents, Minimum_String_Length,
+            [&](Found_String const& found)
+            {
+                line.assign("  ");
+                line.append(region.Name).push_back(' ');
+                Append_Hexadecimal(line, region.Offset + found.Offset);
+                line.push_back(' ');
+                Append_Hexadecimal(line, region.Address + found.Offset);
+                line.append((found.Encoding == String_Encoding::ASCII) ? " a " : " u ");
+                Append_String_Text(found, line);
+                line.push_back('\n');
+
+                out.write(line.data(), line.size());
+            });
+    }
+
+    out << '\n';
+}
+
+void Write_Strings_JSON(string_view label, Parsed_File const& parsed_file, std::ostream& out)
+{
+    JSON_Writer json;
+    std::string text;
+
+    for (auto const& region: Get_String_Regions(parsed_file))
+    {
+        Find_Strings(
+            region.Contents, Minimum_String_Length,
+            [&](Found_String const& found)
+            {
+                text.clear();
+                Append_String_Text(found, text);
+
+                json
+                    .Begin_Object()
+                    .Field("file", label)
+                    .Field("string", text)
+                    .Field("encoding", Get_Encoding_Name(found.Encoding))
+                    .Field("region", region.Name)
+                    .Field("offset", region.Offset + found.Offset)
+                    .Field("address", region.Address + found.Offset)
+                    .End_Object()
+                    .End_Record()
+                    .Write_To(out);
+            });
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef STRINGS_DUMPER_H__INCLUDED
+#define STRINGS_DUMPER_H__INCLUDED
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <include/file-format.h>
+
+#include "command-line-arguments.h"
+
+//
+//  A range that is searched for strings, with the address its first byte
+//  is loaded at: ELF sections (or loadable segments when there is no
+//  section table) with their virtual addresses, and PE sections with their
+//  RVAs.
+//
+struct String_Region
+{
+    std::string_view Name;
+    uint64_t Offset;
+    uint64_t Address;
+    std::string_view Contents;
+};
+
+std::vector<String_Region> Get_String_Regions(Parsed_File const& parsed_file);
+
+//
+//  --strings: every ASCII and UTF-16LE string of four or more characters,
+//  one line (or JSON record) each with its region, file offset and
+//  address.  Lines are written as the strings are found.
+//
+void Show_Strings(Parsed_File const& parsed_file, std::ostream& out);
+void Write_Strings_JSON(std::string_view label, Parsed_File const& parsed_file, std::ostream& out);
+
+#endif  // STRINGS_DUMPER_H__INCLUDED
@@ -0,0 +1,74 @@
+#include "table-writer.h"
+
+#include <algorithm>
+#include <cstring>
+
+Table_Writer::Table_Writer(std::initializer_list<std::string_view> field_names):
+    _field_names{field_names},
+    _widths(field_names.size(), 0)
+{
+    for (size_t i = 0; i < _field_names.size(); ++i)
+        _widths[i] = _field_names[i].length() + 1;
+}
+
+void Table_Writer::Print(std::ostream& out)
+{
+    auto const column_count = _widths.size();
+    auto const row_count = Row_Count();
+
+    size_t line_length = 1;
+
+    for (auto const width: _widths)
+        line_length += width;
+
+    _output.assign(((row_count + 2) * line_length) + 1, ' ');
+
+    char* cursor = _output.data();
+
+    auto place = [&](size_t column, std::string_view text)
+    {
+        cursor += _widths[column];
+        std::memcpy(cursor - text.length(), text.data(), text.length());
+    };
+
+    for (size_t i = 0; i < column_count; ++i)
+        place(i, _field_names[i]);
+
+    *cursor++ = '\n';
+
+    for (size_t i = 0; i < column_count; ++i)
+    {
+        cursor += _widths[i];
+        std::memset(cursor - _field_names[i].length(), '-', _field_names[i].length());
+    }
+
+    *cursor++ = '\n';
+
+    uint32_t cell_begin = 0;
+
+    for (size_t row = 0; row < row_count; ++row)
+    {
+        for (size_t i = 0; i < column_count; ++i)
+        {
+            auto const cell_end = _cell_ends[(row * column_count) + i];
+
+            place(i, std::string_view(&_arena[cell_begin], cell_end - cell_begin));
+            cell_begin = cell_end;
+        }
+
+        *cursor++ = '\n';
+    }
+
+    *cursor++ = '\n';
+
+    out.write(_output.data(), cursor - _output.data());
+}
+
+void Table_Writer::clear()
+{
+    _arena.clear();
+    _cell_ends.clear();
+
+    for (size_t i = 0; i < _field_names.size(); ++i)
+        _widths[i] = _field_names[i].length() + 1;
+}
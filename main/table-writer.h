@@ -0,0 +1,87 @@
+#ifndef TABLE_WRITER_H__INCLUDED
+#define TABLE_WRITER_H__INCLUDED
+
+#include <charconv>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <include/endian.h>
+
+//
+//  Collects the cells of a right-aligned text table.  Cells are formatted
+//  straight into one character arena as they are added and column widths are
+//  tracked on the way, so Print() only has to lay the arena out once and
+//  hand the result to the stream in a single write.
+//
+class Table_Writer
+{
+    private:
+        std::vector<std::string_view> _field_names;
+        std::vector<size_t> _widths;
+
+        std::string _arena;
+        std::vector<uint32_t> _cell_ends;
+
+        std::string _output;
+
+        void end_cell()
+        {
+            auto const begin = _cell_ends.empty() ? 0 : _cell_ends.back();
+            auto const column = _cell_ends.size() % _widths.size();
+
+            _cell_ends.push_back(uint32_t(_arena.size()));
+            _widths[column] = std::max(_widths[column], _arena.size() - begin + 1);
+        }
+
+        template<typename T>
+        Table_Writer& integer(T value, int base)
+        {
+            char digits[24];
+            auto const result = std::to_chars(std::begin(digits), std::end(digits), Integer_Value(value), base);
+
+            _arena.append(digits, result.ptr);
+            end_cell();
+
+            return *this;
+        }
+
+    public:
+        Table_Writer(std::initializer_list<std::string_view> field_names);
+
+        // Adds a column after the others, for columns that depend on options; only before the first row.
+        Table_Writer& Add_Field(std::string_view field_name)
+        {
+            _field_names.push_back(field_name);
+            _widths.push_back(field_name.length() + 1);
+
+            return *this;
+        }
+
+        template<typename T>
+        Table_Writer& Decimal(T value) { return integer(value, 10); }
+
+        template<typename T>
+        Table_Writer& Hexadecimal(T value) { return integer(value, 16); }
+
+        Table_Writer& Text(std::string_view text)
+        {
+            _arena.append(text);
+            end_cell();
+
+            return *this;
+        }
+
+        size_t Row_Count() const noexcept { return _cell_ends.size() / _widths.size(); }
+
+        // Writes the header, a dashed rule, every row and a blank line.
+        void Print(std::ostream& out);
+
+        // Forgets all rows but keeps the buffers for the next table.
+        void clear();
+};
+
+#endif  // TABLE_WRITER_H__INCLUDED
@@ -0,0 +1,317 @@
+#include "verification-dumper.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include <hash/checksum.h>
+#include <hash/digests.h>
+#include <hash/sha256.h>
+#include <mz/mz.h>
+
+#include "json-writer.h"
+
+using std::string_view;
+
+// Small enough to stay in L2 between the word sum and SHA-256.
+static size_t const Chunk_Size = 64 * 1024;
+
+// WIN_CERTIFICATE, the header of each entry of the certificate table; entries are 8-byte aligned.
+struct __attribute__((packed)) Certificate_Header
+{
+    uint32_t Length;                // Including the header.
+    uint16_t Revision;
+    uint16_t Certificate_Type;
+};
+
+static uint16_t const PKCS_Signed_Data = 2;
+
+struct Byte_Range
+{
+    uint64_t Offset;
+    uint64_t Size;
+};
+
+// The DER encodings of the OIDs a signature can name its digest algorithm with.
+struct Digest_Algorithm
+{
+    string_view Name;
+    string_view Encoded_OID;
+    size_t Digest_Size;
+};
+
+static constexpr Digest_Algorithm Digest_Algorithms[] = {
+    { "sha256", "\x06\x09\x60\x86\x48\x01\x65\x03\x04\x02\x01"sv, 32 },
+    { "sha384", "\x06\x09\x60\x86\x48\x01\x65\x03\x04\x02\x02"sv, 48 },
+    { "sha512", "\x06\x09\x60\x86\x48\x01\x65\x03\x04\x02\x03"sv, 64 },
+    { "sha1", "\x06\x05\x2b\x0e\x03\x02\x1a"sv, 20 },
+    { "md5", "\x06\x08\x2a\x86\x48\x86\xf7\x0d\x02\x05"sv, 16 }
+};
+
+// SPC_INDIRECT_DATA_OBJID (1.3.6.1.4.1.311.2.1.4), the content type of the signed Authenticode data.
+static constexpr string_view SPC_Indirect_Data_OID = "\x06\x0a\x2b\x06\x01\x04\x01\x82\x37\x02\x01\x04"sv;
+
+//
+//  The digest in the SpcIndirectDataContent of a PKCS#7 signature: the
+//  first digest algorithm OID after the content type, optionally followed
+//  by a NULL parameter, and then an OCTET STRING of the algorithm's size.
+//  The algorithm lists of SignedData come before the content type, and
+//  the signer's own come after the digest, so neither is picked up.
+//
+static std::optional<std::pair<string_view, string_view>> Find_Signed_Digest(string_view pkcs7)
+{
+    auto const content_type = pkcs7.find(SPC_Indirect_Data_OID);
+
+    if (content_type == string_view::npos)
+        return std::nullopt;
+
+    auto const content = pkcs7.substr(content_type + SPC_Indirect_Data_OID.size());
+
+    for (size_t i = 0; i < content.size(); ++i)
+    {
+        if (content[i] != '\x06')
+            continue;
+
+        for (auto const& algorithm: Digest_Algorithms)
+        {
+            if (content.substr(i, algorithm.Encoded_OID.size()) != algorithm.Encoded_OID)
+                continue;
+
+            auto digest = content.substr(i + algorithm.Encoded_OID.size());
+
+            if (digest.substr(0, 2) == "\x05\x00"sv)
+                digest.remove_prefix(2);
+
+            if ((digest.size() < 2 + algorithm.Digest_Size) ||
+                (digest[0] != '\x04') || (uint8_t(digest[1]) != algorithm.Digest_Size))
+                continue;
+
+            return std::pair { algorithm.Name, digest.substr(2, algorithm.Digest_Size) };
+        }
+    }
+
+    return std::nullopt;
+}
+
+static std::optional<std::pair<string_view, string_view>> Find_Signed_Digest(MZ const& mz, Byte_Range certificates)
+{
+    auto const table = mz.Get_Range(certificates.Offset, certificates.Size);
+
+    for (size_t offset = 0; offset + sizeof(Certificate_Header) <= table.size(); )
+    {
+        Certificate_Header header;
+        std::memcpy(&header, table.data() + offset, sizeof(header));
+
+        if (header.Length < sizeof(header))
+            break;
+
+        if (header.Certificate_Type == PKCS_Signed_Data)
+        {
+            auto const pkcs7 = table.substr(offset + sizeof(header), header.Length - sizeof(header));
+
+            if (auto const digest = Find_Signed_Digest(pkcs7))
+                return digest;
+        }
+
+        offset += (uint64_t(header.Length) + 7) & ~uint64_t(7);
+    }
+
+    return std::nullopt;
+}
+
+template<typename Optional_Header_Type>
+static std::optional<PE_Verification> Verify_PE(MZ const& mz, Optional_Header_Type const& oh)
+{
+    auto const contents = mz.buffer();
+    auto const header_offset = mz.Get_Optional_Header_Address();
+
+    auto const check_sum_offset = header_offset + offsetof(Optional_Header_Type, Check_Sum);
+    auto const certificate_entry_offset =
+        header_offset + offsetof(Optional_Header_Type, Image_Data_Directories) +
+        offsetof(MZ::Image_Data_Directories, Certificate_Table);
+
+    // The certificate table entry holds a file offset, not an RVA.
+    Byte_Range const certificates { oh.Image_Data_Directories.Certificate_Table.Virtual_Address, oh.Image_Data_Directories.Certificate_Table.Size };
+
+    Byte_Range excluded[] = {
+        { check_sum_offset, sizeof(uint32_t) },
+        { certificate_entry_offset, sizeof(MZ::Image_Data_Directories::Entry) },
+        certificates
+    };
+
+    std::sort(
+        std::begin(excluded), std::end(excluded),
+        [](Byte_Range const& a, Byte_Range const& b) { return a.Offset < b.Offset; });
+
+    uint64_t sum = 0;
+    SHA256_State sha256;
+    size_t next_excluded = 0;
+
+    for (uint64_t offset = 0; offset < contents.size(); offset += Chunk_Size)
+    {
+        auto const chunk = contents.substr(offset, Chunk_Size);
+        auto const chunk_end = offset + chunk.size();
+
+        sum += Sum_Words(chunk);
+
+        for (auto position = offset; position < chunk_end; )
+        {
+            while ((next_excluded < std::size(excluded)) &&
+                   (excluded[next_excluded].Offset + excluded[next_excluded].Size <= position))
+                ++next_excluded;
+
+            if ((next_excluded < std::size(excluded)) && (excluded[next_excluded].Offset <= position))
+            {
+                position = std::min(excluded[next_excluded].Offset + excluded[next_excluded].Size, chunk_end);
+                continue;
+            }
+
+            auto const piece_end =
+                (next_excluded < std::size(excluded)) ? std::min(excluded[next_excluded].Offset, chunk_end) : chunk_end;
+
+            sha256.Update(contents.substr(position, piece_end - position));
+            position = piece_end;
+        }
+    }
+
+    // Take the Check_Sum field back out of the sum, as if it had read as zero.
+    for (uint64_t i = check_sum_offset; (i < check_sum_offset + sizeof(uint32_t)) && (i < contents.size()); ++i)
+        sum -= uint64_t(uint8_t(contents[i])) << ((i % 2) * 8);
+
+    PE_Verification verification {
+        oh.Check_Sum,
+        uint32_t(Fold_Word_Sum(sum) + contents.size()),
+        sha256.Digest(),
+        {},
+        {}
+    };
+
+    if (certificates.Size != 0)
+    {
+        if (auto const digest = Find_Signed_Digest(mz, certificates))
+        {
+            verification.Signed_Digest_Algorithm = digest->first;
+            verification.Signed_Digest = digest->second;
+        }
+    }
+
+    return verification;
+}
+
+std::optional<PE_Verification> Verify_PE(MZ const& mz)
+{
+    switch (auto optional_header = mz.Get_Optional_Header();
+            optional_header.index())
+    {
+        case 1:
+            return Verify_PE(mz, std::get<MZ::Optional_Header>(optional_header));
+
+        case 2:
+            return Verify_PE(mz, std::get<MZ::Optional_Header_Plus>(optional_header));
+
+        default:
+            return std::nullopt;
+    }
+}
+
+// Whether the signed digest is a SHA-256 that matches; other algorithms are not computed here.
+static std::optional<bool> Get_Signed_Digest_Match(PE_Verification const& verification)
+{
+    if (verification.Signed_Digest_Algorithm != "sha256")
+        return std::nullopt;
+
+    auto const& computed = verification.Authenticode_SHA256;
+
+    return verification.Signed_Digest == string_view(reinterpret_cast<char const*>(computed.data()), computed.size());
+}
+
+void Show_PE_Verification(MZ const& mz, std::ostream& out)
+{
+    auto const verification = Verify_PE(mz);
+
+    if (!verification)
+    {
+        out << "No optional header to verify." << '\n';
+        return;
+    }
+
+    out
+        << "\n  Verification:"
+        << "\n    Check_Sum: " << verification->Stored_Check_Sum << ", computed " << verification->Computed_Check_Sum;
+
+    if (verification->Stored_Check_Sum == 0)
+        out << " (not set)";
+    else if (verification->Stored_Check_Sum != verification->Computed_Check_Sum)
+        out << " (MISMATCH)";
+
+    out << "\n    Authenticode SHA-256: " << To_Hex(verification->Authenticode_SHA256);
+
+    if (verification->Signed_Digest_Algorithm.empty())
+    {
+        out << "\n    Not signed." << '\n';
+        return;
+    }
+
+    out
+        << "\n    Signed digest (" << verification->Signed_Digest_Algorithm << "): "
+        << To_Hex(verification->Signed_Digest);
+
+    if (auto const match = Get_Signed_Digest_Match(*verification); !match)
+        out << " (not compared)";
+    else if (!*match)
+        out << " (MISMATCH)";
+
+    out << '\n';
+}
+
+void Write_PE_Verification_JSON(MZ const& mz, JSON_Writer& json)
+{
+    json.Key("verification");
+
+    auto const verification = Verify_PE(mz);
+
+    if (!verification)
+    {
+        json.Null();
+        return;
+    }
+
+    json
+        .Begin_Object()
+        .Field("stored_check_sum", verification->Stored_Check_Sum)
+        .Field("computed_check_sum", verification->Computed_Check_Sum)
+        .Key("check_sum_matches");
+
+    if (verification->Stored_Check_Sum == 0)
+        json.Null();
+    else
+        json.Boolean(verification->Stored_Check_Sum == verification->Computed_Check_Sum);
+
+    json
+        .Field("authenticode_sha256", To_Hex(verification->Authenticode_SHA256))
+        .Key("signed_digest");
+
+    if (verification->Signed_Digest_Algorithm.empty())
+    {
+        json.Null();
+    } else {
+        json
+            .Begin_Object()
+            .Field("algorithm", verification->Signed_Digest_Algorithm)
+            .Field("digest", To_Hex(verification->Signed_Digest))
+            .Key("matches");
+
+        if (auto const match = Get_Signed_Digest_Match(*verification))
+            json.Boolean(*match);
+        else
+            json.Null();
+
+        json.End_Object();
+    }
+
+    json.End_Object();
+}
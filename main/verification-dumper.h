@@ -0,0 +1,44 @@
+#ifndef VERIFICATION_DUMPER_H__INCLUDED
+#define VERIFICATION_DUMPER_H__INCLUDED
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+#include <hash/sha256.h>
+#include <mz/mz.h>
+
+#include "json-writer.h"
+
+//
+//  The PE image checksum and the Authenticode digest, computed together
+//  in one pass over the file.
+//
+//  The checksum is the ones'-complement sum of the file's 16-bit words,
+//  with the Check_Sum field read as zero, plus the file size.  The
+//  Authenticode digest is the SHA-256 of the file without the Check_Sum
+//  field, the certificate table directory entry, or the certificate data
+//  it points at; the digest the signer computed is picked out of the
+//  first PKCS#7 certificate.
+//
+struct PE_Verification
+{
+    uint32_t Stored_Check_Sum;      // 0 when the linker did not set one.
+    uint32_t Computed_Check_Sum;
+
+    SHA256_Digest Authenticode_SHA256;
+
+    // Empty for unsigned images, and when no digest can be found in the signature.
+    std::string_view Signed_Digest_Algorithm;
+    std::string_view Signed_Digest;
+};
+
+// Nothing for files without an optional header, such as object files.
+std::optional<PE_Verification> Verify_PE(MZ const& mz);
+
+// --verify
+void Show_PE_Verification(MZ const& mz, std::ostream& out);
+void Write_PE_Verification_JSON(MZ const& mz, JSON_Writer& json);
+
+#endif  // VERIFICATION_DUMPER_H__INCLUDED
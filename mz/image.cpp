@@ -0,0 +1,422 @@
+#include "image.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Bigger images than this are taken to be damaged headers rather than allocated.
+static uint64_t const Largest_Image_Size = uint64_t(4) << 30;
+
+static uint32_t const Page_Offset_Mask = 0xfff;
+
+//
+//  A relocation entry: the type in the top 4 bits and the offset into the
+//  block's 4 KiB page in the low 12.
+//
+static MZ_Image::Relocation_Type Get_Type(uint16_t entry)
+{
+    return MZ_Image::Relocation_Type(entry >> 12);
+}
+
+//
+//  Whether every entry of a block has the given type or is Absolute
+//  padding.  Linkers emit blocks of a single type (Dir64 for PE32+,
+//  High_Low for PE32) padded to 4 bytes, which can then be applied
+//  without looking at each entry's type.
+//
+using Uniform_Check_Function = bool (*)(uint16_t const* entries, size_t count, MZ_Image::Relocation_Type type);
+
+static bool Is_Uniform_Portable(uint16_t const* entries, size_t count, MZ_Image::Relocation_Type type)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto const entry_type = Get_Type(entries[i]);
+
+        if ((entry_type != type) && (entry_type != MZ_Image::Relocation_Type::Absolute))
+            return false;
+    }
+
+    return true;
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+static bool Is_Uniform_AVX2(uint16_t const* entries, size_t count, MZ_Image::Relocation_Type type)
+{
+    auto const wanted = _mm256_set1_epi16(int16_t(uint16_t(type) << 12));
+    auto const type_mask = _mm256_set1_epi16(int16_t(0xf000));
+    auto const zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        auto const types = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(entries + i)), type_mask);
+        auto const allowed = _mm256_or_si256(_mm256_cmpeq_epi16(types, wanted), _mm256_cmpeq_epi16(types, zero));
+
+        if (uint32_t(_mm256_movemask_epi8(allowed)) != 0xffffffff)
+            return false;
+    }
+
+    return Is_Uniform_Portable(entries + i, count - i, type);
+}
+
+#endif
+
+static Uniform_Check_Function Get_Uniform_Check_Function()
+{
+    static Uniform_Check_Function const check = []() -> Uniform_Check_Function
+    {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return Is_Uniform_AVX2;
+#endif
+
+        return Is_Uniform_Portable;
+    }();
+
+    return check;
+}
+
+//
+//  Applies a uniform block whose page lies wholly inside the image: no
+//  per-entry type dispatch or bounds check, and Absolute padding adds 0
+//  (masked rather than branched on) to the word at the start of the page.
+//
+template<typename Word>
+static void Apply_Uniform_Block(uint8_t* page, uint16_t const* entries, size_t count, uint64_t delta)
+{
+    auto const word_delta = Word(delta);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto const entry = entries[i];
+        auto* target = page + (entry & Page_Offset_Mask);
+
+        Word value;
+        std::memcpy(&value, target, sizeof(value));
+
+        value += word_delta & -Word((entry >> 12) != 0);
+        std::memcpy(target, &value, sizeof(value));
+    }
+}
+
+template<typename T>
+static bool Add_At(uint8_t* contents, size_t size, uint64_t offset, T addend)
+{
+    if ((offset > size) || (size - offset < sizeof(T)))
+        return false;
+
+    T value;
+    std::memcpy(&value, contents + offset, sizeof(value));
+
+    value += addend;
+    std::memcpy(contents + offset, &value, sizeof(value));
+
+    return true;
+}
+
+MZ_Image::MZ_Image():
+    _contents{nullptr},
+    _size{0},
+    _mapping_size{0},
+    _preferred_base{0},
+    _image_base{0},
+    _mapped_section_count{0},
+    _copied_section_count{0},
+    _relocation_count{0},
+    _unsupported_relocation_count{0}
+{}
+
+MZ_Image::~MZ_Image()
+{
+    if (_contents != nullptr)
+        ::munmap(_contents, _mapping_size);
+}
+
+MZ_Image* MZ_Image::Load(MZ const& mz, int fd)
+{
+    auto const preferred_base = std::visit(
+        [](auto const& header) -> uint64_t
+        {
+            if constexpr (std::is_same_v<std::decay_t<decltype(header)>, std::nullptr_t>)
+                return 0;
+            else
+                return header.Image_Base;
+        },
+        mz.Get_Optional_Header());
+
+    return Load(mz, preferred_base, fd);
+}
+
+MZ_Image* MZ_Image::Load(MZ const& mz, uint64_t image_base, int fd)
+{
+    struct Layout
+    {
+        uint64_t Preferred_Base;
+        uint32_t Size_Of_Image;
+        uint32_t Size_Of_Headers;
+        uint32_t Number_Of_Rva_And_Sizes;
+        MZ::Image_Data_Directories::Entry Relocations;
+    };
+
+    auto const layout = std::visit(
+        [](auto const& header) -> Layout
+        {
+            if constexpr (std::is_same_v<std::decay_t<decltype(header)>, std::nullptr_t>)
+                return Layout {};
+            else
+            {
+                return Layout {
+                    header.Image_Base, header.Size_Of_Image, header.Size_Of_Headers,
+                    header.Number_Of_Rva_And_Sizes, header.Image_Data_Directories.Base_Relocation_Table };
+            }
+        },
+        mz.Get_Optional_Header());
+
+    if ((layout.Size_Of_Image == 0) || (layout.Size_Of_Image > Largest_Image_Size))
+    {
+        errno = ENOEXEC;
+        return nullptr;
+    }
+
+    if (std::holds_alternative<MZ::Optional_Header>(mz.Get_Optional_Header()) && (image_base > UINT32_MAX))
+    {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    auto image = std::unique_ptr<MZ_Image>(new MZ_Image);
+
+    image->_preferred_base = layout.Preferred_Base;
+    image->_image_base = image_base;
+    image->_size = layout.Size_Of_Image;
+
+    auto const page_size = size_t(::sysconf(_SC_PAGESIZE));
+    image->_mapping_size = (image->_size + page_size - 1) & ~(page_size - 1);
+
+    void* mapping = ::mmap(
+        nullptr, image->_mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    image->_contents = static_cast<uint8_t*>(mapping);
+
+    if (!image->lay_out(mz, layout.Size_Of_Headers, fd))
+        return nullptr;
+
+    if (image_base == layout.Preferred_Base)
+        return image.release();
+
+    bool const has_relocations =
+        (layout.Number_Of_Rva_And_Sizes > 5) && (layout.Relocations.Virtual_Address != 0) && (layout.Relocations.Size != 0);
+
+    // An image without relocations can only run where it was linked.
+    if (!has_relocations)
+    {
+        if (uint16_t(mz.Get_Header().Characteristics) & uint16_t(MZ::Image_File_Characteristics::RELOCS_STRIPPED))
+        {
+            errno = ENOEXEC;
+            return nullptr;
+        }
+
+        return image.release();
+    }
+
+    if (!image->relocate(mz, layout.Relocations.Virtual_Address, layout.Relocations.Size))
+        return nullptr;
+
+    return image.release();
+}
+
+bool MZ_Image::lay_out(MZ const& mz, uint32_t size_of_headers, int fd)
+{
+    auto const file = mz.buffer();
+    auto const page_size = uint64_t(::sysconf(_SC_PAGESIZE));
+
+    auto const header_size = std::min<uint64_t>({ size_of_headers, file.size(), _size });
+    std::memcpy(_contents, file.data(), header_size);
+
+    for (uint16_t i = 0; i < mz.Get_Number_of_Sections(); ++i)
+    {
+        auto const& sh = mz.Get_Section_Header(i);
+
+        uint64_t const virtual_size = (sh.Virtual_Size != 0) ? sh.Virtual_Size : sh.Size_Of_Raw_Data;
+        uint64_t const offset = sh.Pointer_To_Raw_Data;
+        uint64_t data_size = std::min<uint64_t>(sh.Size_Of_Raw_Data, virtual_size);
+
+        data_size = (offset >= file.size()) ? 0 : std::min(data_size, file.size() - offset);
+
+        if (data_size == 0)
+            continue;
+
+        if ((sh.Virtual_Address > _size) || (_size - sh.Virtual_Address < data_size))
+        {
+            errno = ENOEXEC;
+            return false;
+        }
+
+        auto* target = _contents + sh.Virtual_Address;
+        uint64_t mapped_size = 0;
+
+        // Whole pages come straight from the file; the partial last page must not bring in what follows it.
+        if ((fd >= 0) && ((offset % page_size) == 0) && ((sh.Virtual_Address % page_size) == 0))
+        {
+            mapped_size = data_size & ~(page_size - 1);
+
+            if ((mapped_size > 0) &&
+                (::mmap(target, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, off_t(offset)) == MAP_FAILED))
+                mapped_size = 0;
+        }
+
+        std::memcpy(target + mapped_size, file.data() + offset + mapped_size, data_size - mapped_size);
+
+        if (mapped_size > 0)
+            ++_mapped_section_count;
+        else
+            ++_copied_section_count;
+    }
+
+    return true;
+}
+
+//
+//  Walks the relocation blocks in the laid-out image.  A block of one type
+//  whose page lies inside the image takes the batched path; anything else
+//  is applied an entry at a time with a bounds check on each fixup.
+//
+bool MZ_Image::relocate(MZ const& mz, uint32_t table_RVA, uint32_t table_size)
+{
+    if ((table_RVA > _size) || (_size - table_RVA < table_size))
+    {
+        errno = ENOEXEC;
+        return false;
+    }
+
+    auto const is_uniform = Get_Uniform_Check_Function();
+    auto const delta = _image_base - _preferred_base;
+
+    bool const is_pe32_plus = std::holds_alternative<MZ::Optional_Header_Plus>(mz.Get_Optional_Header());
+    auto const word_type = is_pe32_plus ? Relocation_Type::Dir64 : Relocation_Type::High_Low;
+
+    uint64_t position = table_RVA;
+    uint64_t const table_end = uint64_t(table_RVA) + table_size;
+
+    //
+    //  The entries of each block are copied out, since a fixup may land
+    //  inside the relocation table itself.  Block_Size comes from the file
+    //  and is only bounded by the table, so the copy is sized from it.
+    //
+    std::vector<uint16_t> block_entries;
+
+    // The 4-byte rounding of the last block may step past the end of the table.
+    while ((position < table_end) && (table_end - position >= sizeof(Relocation_Block_Header)))
+    {
+        Relocation_Block_Header header;
+        std::memcpy(&header, _contents + position, sizeof(header));
+
+        if ((header.Block_Size < sizeof(header)) || (header.Block_Size > table_end - position))
+        {
+            errno = ENOEXEC;
+            return false;
+        }
+
+        auto const count = (header.Block_Size - sizeof(header)) / 2;
+
+        block_entries.resize(count + 1);    // The spare entry keeps data() non-null for an empty block.
+        std::memcpy(block_entries.data(), _contents + position + sizeof(header), count * 2);
+
+        auto const* entries = block_entries.data();
+        position += (uint64_t(header.Block_Size) + 3) & ~uint64_t(3);
+
+        uint64_t const page = header.Page_RVA;
+
+        if ((page <= _size) && (_size - page >= Page_Offset_Mask + 1 + sizeof(uint64_t)) && is_uniform(entries, count, word_type))
+        {
+            if (is_pe32_plus)
+                Apply_Uniform_Block<uint64_t>(_contents + page, entries, count, delta);
+            else
+                Apply_Uniform_Block<uint32_t>(_contents + page, entries, count, delta);
+
+            _relocation_count += std::count_if(
+                entries, entries + count, [](uint16_t entry) { return Get_Type(entry) != Relocation_Type::Absolute; });
+            continue;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto const offset = page + (entries[i] & Page_Offset_Mask);
+            bool applied = true;
+
+            switch (Get_Type(entries[i]))
+            {
+                case Relocation_Type::Absolute:
+                    continue;
+
+                case Relocation_Type::High:
+                    applied = Add_At(_contents, _size, offset, uint16_t(delta >> 16));
+                    break;
+
+                case Relocation_Type::Low:
+                    applied = Add_At(_contents, _size, offset, uint16_t(delta));
+                    break;
+
+                case Relocation_Type::High_Low:
+                    applied = Add_At(_contents, _size, offset, uint32_t(delta));
+                    break;
+
+                case Relocation_Type::Dir64:
+                    applied = Add_At(_contents, _size, offset, delta);
+                    break;
+
+                // The next entry holds the low half of the 32-bit value whose rounded high half is stored here.
+                case Relocation_Type::High_Adjust:
+                {
+                    if ((i + 1 >= count) || (offset > _size) || (_size - offset < sizeof(uint16_t)))
+                    {
+                        applied = false;
+                        break;
+                    }
+
+                    uint16_t high;
+                    std::memcpy(&high, _contents + offset, sizeof(high));
+
+                    auto const value = (uint32_t(high) << 16) + uint32_t(int32_t(int16_t(entries[++i]))) + uint32_t(delta);
+
+                    high = uint16_t((value + 0x8000) >> 16);
+                    std::memcpy(_contents + offset, &high, sizeof(high));
+                    break;
+                }
+
+                default:
+                    ++_unsupported_relocation_count;
+                    continue;
+            }
+
+            if (!applied)
+            {
+                errno = ENOEXEC;
+                return false;
+            }
+
+            ++_relocation_count;
+        }
+    }
+
+    return true;
+}
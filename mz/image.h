@@ -0,0 +1,93 @@
+#ifndef MZ_IMAGE_H__INCLUDED
+#define MZ_IMAGE_H__INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "include/interface.h"
+#include "mz.h"
+
+//
+//  A PE image laid out the way the Windows loader maps it: the headers at
+//  offset 0, each section at its Virtual_Address, the rest of
+//  Size_Of_Image zero-filled, and the base relocations applied for the
+//  chosen base address.
+//
+//  The image lives in one anonymous mapping, so untouched zero pages cost
+//  nothing.  Given the descriptor of the file the MZ was parsed from, a
+//  section whose raw data starts on a page boundary in the file is mapped
+//  over it privately (copy-on-write) instead of copied; only the pages the
+//  relocations then write to are ever duplicated.  Other sections, and all
+//  sections when there is no descriptor, are copied.
+//
+class MZ_Image: public Base_Class
+{
+    public:
+        enum class Relocation_Type: uint8_t
+        {
+            Absolute = 0,
+            High = 1,
+            Low = 2,
+            High_Low = 3,
+            High_Adjust = 4,
+            Dir64 = 10
+        };
+
+        struct __attribute__((packed)) Relocation_Block_Header
+        {
+            uint32_t Page_RVA;
+            uint32_t Block_Size;
+        };
+
+    private:
+        uint8_t* _contents;
+        size_t _size;
+        size_t _mapping_size;
+
+        uint64_t _preferred_base;
+        uint64_t _image_base;
+
+        uint32_t _mapped_section_count;
+        uint32_t _copied_section_count;
+
+        uint64_t _relocation_count;
+        uint64_t _unsupported_relocation_count;
+
+        MZ_Image();
+
+        bool lay_out(MZ const& mz, uint32_t size_of_headers, int fd);
+        bool relocate(MZ const& mz, uint32_t table_RVA, uint32_t table_size);
+
+    public:
+        //
+        //  Returns nullptr, with errno set, when the headers or section table
+        //  do not describe an image that fits in Size_Of_Image (ENOEXEC), a
+        //  PE32 image is asked to load above 4 GiB (EINVAL), or the memory
+        //  cannot be mapped.  fd may be -1.
+        //
+        static MZ_Image* Load(MZ const& mz, uint64_t image_base, int fd = -1);
+
+        // Loads the image at the base it was linked for: nothing is relocated.
+        static MZ_Image* Load(MZ const& mz, int fd = -1);
+
+        MZ_Image(MZ_Image const&) = delete;
+        MZ_Image& operator=(MZ_Image const&) = delete;
+
+        ~MZ_Image() override;
+
+        std::string_view contents() const noexcept { return { reinterpret_cast<char const*>(_contents), _size }; }
+        size_t size() const noexcept { return _size; }
+
+        uint64_t Get_Preferred_Base() const noexcept { return _preferred_base; }
+        uint64_t Get_Image_Base() const noexcept { return _image_base; }
+
+        uint32_t Get_Mapped_Section_Count() const noexcept { return _mapped_section_count; }
+        uint32_t Get_Copied_Section_Count() const noexcept { return _copied_section_count; }
+
+        // Fixups written, and fixups skipped for types this loader does not apply (ARM, MIPS, RISC-V).
+        uint64_t Get_Relocation_Count() const noexcept { return _relocation_count; }
+        uint64_t Get_Unsupported_Relocation_Count() const noexcept { return _unsupported_relocation_count; }
+};
+
+#endif  // MZ_IMAGE_H__INCLUDED
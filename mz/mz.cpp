@@ -1,26 +1,76 @@
 #include "mz.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <string_view>
 
+//
+//  Object files start straight with the COFF header, so there is no magic
+//  number to go by: the header has to name a known machine, have no
+//  optional header, not claim to be an image, and describe a section and
+//  symbol table that fit in the file.
+//
+static bool Is_COFF_Object(std::string_view buffer)
+{
+    auto constexpr header_size = sizeof(MZ::COFF_Header) - sizeof(uint32_t);
+
+    if (buffer.size() < header_size)
+        return false;
+
+    auto const machine = Parse_As<MZ::Machine_Type>(&buffer[0]);
+    auto const number_of_sections = Parse_As<uint16_t>(&buffer[2]);
+    auto const pointer_to_symbol_table = Parse_As<uint32_t>(&buffer[8]);
+    auto const number_of_symbols = Parse_As<uint32_t>(&buffer[12]);
+    auto const size_of_optional_header = Parse_As<uint16_t>(&buffer[16]);
+    auto const characteristics = Parse_As<uint16_t>(&buffer[18]);
+
+    if ((machine == MZ::Machine_Type::UNKNOWN) || Get_Machine_Type_Name(machine).empty())
+        return false;
+
+    if ((size_of_optional_header != 0) ||
+        (characteristics & uint16_t(MZ::Image_File_Characteristics::EXECUTABLE_IMAGE | MZ::Image_File_Characteristics::DLL)))
+        return false;
+
+    if (header_size + uint64_t(number_of_sections) * sizeof(MZ::Section_Header) > buffer.size())
+        return false;
+
+    if ((pointer_to_symbol_table != 0) &&
+        (pointer_to_symbol_table + uint64_t(number_of_symbols) * sizeof(MZ::Symbol_Table_Entry) > buffer.size()))
+        return false;
+
+    return true;
+}
+
 MZ* MZ::Parse(std::string_view buffer)
 {
+    if (Is_COFF_Object(buffer))
+    {
+        auto mz = new MZ{buffer};
+        mz->_is_object = true;
+
+        return mz;
+    }
+
+    if (buffer.size() < 0x40)
+        return nullptr;
+
     auto const& mz_signature = Parse_As<uint16_t>(&buffer[0]);
 
     if (mz_signature != 0x5a4d)
         return nullptr;
 
     auto signature_offset = Parse_As<uint32_t>(&buffer[0x3c]);
-    std::cout << std::hex << "Signature offset found at 3c: " << signature_offset << std::endl;
+
+    if (uint64_t(signature_offset) + sizeof(COFF_Header) > buffer.size())
+        return nullptr;
 
     auto signature = Parse_As<uint32_t>(&buffer[signature_offset]);
-    std::cout << std::hex
-	<< "Signature found at " << signature_offset
-        << ": " << signature << std::endl;
 
-    if (signature == 0x4550)  // "PE"
-        std::cout << "PE signature found.  This is a Portable Executable file." << std::endl;
-    else
+    if (signature != 0x4550)  // "PE"
         return nullptr;
 
     // This comment is wrong.  Some places assume this to be 64-bit PE+.  Need to fix.
@@ -30,9 +80,17 @@ MZ* MZ::Parse(std::string_view buffer)
     return mz;
 }
 
-MZ::COFF_Header const& MZ::Get_Header() const
+MZ::~MZ() {}
+
+MZ::COFF_Header MZ::Get_Header() const
 {
-    return get_header<COFF_Header>(Get_COFF_Header_Address());
+    if (!_is_object)
+        return get_header<COFF_Header>(Get_COFF_Header_Address());
+
+    COFF_Header header {};
+    std::memcpy(&header.Machine, buffer().data(), sizeof(COFF_Header) - offsetof(COFF_Header, Machine));
+
+    return header;
 }
 
 MZ::Optional_Header MZ::get_optional_header() const
@@ -47,6 +105,9 @@ MZ::Optional_Header_Plus MZ::get_optional_header_plus() const
 
 std::variant<std::nullptr_t, MZ::Optional_Header, MZ::Optional_Header_Plus> MZ::Get_Optional_Header() const
 {
+    if (Get_Optional_Header_Size() < sizeof(Magic_Number))
+        return nullptr;
+
     switch (get_field<Magic_Number>(Get_Optional_Header_Address()))
     {
         case Magic_Number::PE32:
@@ -62,12 +123,12 @@ std::variant<std::nullptr_t, MZ::Optional_Header, MZ::Optional_Header_Plus> MZ::
 
 uint32_t MZ::Get_COFF_Header_Address() const
 {
-    return get_field<uint32_t>(0x3c);
+    return _is_object ? 0 : get_field<uint32_t>(0x3c);
 }
 
 uint32_t MZ::Get_COFF_Header_Size() const
 {
-    return sizeof(COFF_Header);
+    return _is_object ? sizeof(COFF_Header) - sizeof(uint32_t) : sizeof(COFF_Header);
 }
 
 uint64_t MZ::Get_Optional_Header_Address() const
@@ -82,11 +143,9 @@ uint32_t MZ::Get_Optional_Header_Size() const
 
 File_Format MZ::Get_File_Format() const
 {
-    // File_Format::MZ_Executable
-    // File_Format::MZ_Object
     // File_Format::MZ_DLL
     // File_Format::MZ_Library
-    return File_Format::MZ_Executable;
+    return _is_object ? File_Format::MZ_Object : File_Format::MZ_Executable;
 }
 
 uint16_t MZ::Get_Number_of_Sections() const
@@ -105,6 +164,15 @@ MZ::Section_Header const& MZ::Get_Section_Header(uint16_t i) const
     return (&First_Section_Header)[i];
 }
 
+bool MZ::Has_File_Data(MZ::Section_Header const& sh)
+{
+    auto const uninitialized = uint32_t(Section_Characteristics::IMAGE_SCN_CNT_UNINITIALIZED_DATA);
+
+    return
+        (sh.Size_Of_Raw_Data != 0) && (sh.Pointer_To_Raw_Data != 0) &&
+        ((uint32_t(sh.Characteristics) & uninitialized) == 0);
+}
+
 std::string_view MZ::Get_Section_Name(MZ::Section_Header const& sh) const
 {
     std::string_view Name_Field(&sh.Name[0], 8);
@@ -114,36 +182,76 @@ std::string_view MZ::Get_Section_Name(MZ::Section_Header const& sh) const
         Name_Field = Name_Field.substr(0, nul_terminator);
 
     //
-    // TODO: For longer names, this field contains a slash (/) that is followed
-    //       by an ASCII representation of a decimal number that is an offset
-    //       into the string table.
+    //  Longer names are in the string table: the field holds a slash and
+    //  the offset in decimal, or, for offsets too large for that, two
+    //  slashes and the offset in base 64.
     //
+    if ((Name_Field.size() < 2) || (Name_Field[0] != '/'))
+        return Name_Field;
+
+    auto const* symbols = Get_Symbol_Table();
+
+    if (symbols == nullptr)
+        return Name_Field;
+
+    uint64_t offset = 0;
 
-    return Name_Field;
+    if (Name_Field[1] == '/')
+    {
+        static constexpr std::string_view digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        for (auto const c: Name_Field.substr(2))
+        {
+            auto const digit = digits.find(c);
+
+            if (digit == std::string_view::npos)
+                return Name_Field;
+
+            offset = (offset * 64) + digit;
+        }
+    } else {
+        for (auto const c: Name_Field.substr(1))
+        {
+            if ((c < '0') || (c > '9'))
+                return Name_Field;
+
+            offset = (offset * 10) + (c - '0');
+        }
+    }
+
+    auto const name = symbols->Get_String(uint32_t(std::min<uint64_t>(offset, std::numeric_limits<uint32_t>::max())));
+
+    return name.empty() ? Name_Field : name;
 }
 
-MZ::Import_Directory_Table_Entry const* MZ::Get_Import_Table() const
+bool MZ::get_data_directories(Image_Data_Directories& directories) const
 {
-    Image_Data_Directories const* idd = nullptr;
-
     switch (auto optional_header = Get_Optional_Header();
             optional_header.index())
     {
         case 1:
-            idd = &std::get<MZ::Optional_Header>(optional_header).Image_Data_Directories;
-            break;
+            directories = std::get<MZ::Optional_Header>(optional_header).Image_Data_Directories;
+            return true;
 
         case 2:
-            idd = &std::get<MZ::Optional_Header_Plus>(optional_header).Image_Data_Directories;
-            break;
+            directories = std::get<MZ::Optional_Header_Plus>(optional_header).Image_Data_Directories;
+            return true;
+
+        default:
+            return false;
     }
+}
 
-    if (!idd)
+MZ::Import_Directory_Table_Entry const* MZ::Get_Import_Table() const
+{
+    Image_Data_Directories idd;
+
+    if (!get_data_directories(idd))
     {
         return nullptr;
     }
 
-    return &get_field<Import_Directory_Table_Entry>(Resolve_RVA(idd->Import_Table.Virtual_Address));
+    return &get_field<Import_Directory_Table_Entry>(Resolve_RVA(idd.Import_Table.Virtual_Address));
 }
 
 MZ::Import_Lookup_Table_Entry const* MZ::Get_Import_Lookup_Table(uint32_t RVA) const
@@ -151,27 +259,52 @@ MZ::Import_Lookup_Table_Entry const* MZ::Get_Import_Lookup_Table(uint32_t RVA) c
     return &get_field<Import_Lookup_Table_Entry>(Resolve_RVA(RVA));
 }
 
-uint64_t MZ::Resolve_RVA(uint64_t RVA) const
+void MZ::build_section_index() const
 {
     auto const Number_Of_Sections = Get_Number_of_Sections();
 
-    Section_Header const* sh = nullptr;
+    _section_index.reserve(Number_Of_Sections + 1);
 
-    for (int i = 0; i < Number_Of_Sections; ++i)
+    //
+    //  The loader maps the headers at RVA 0, so RVAs below Size_Of_Headers
+    //  are file offsets already.
+    //
+    switch (auto optional_header = Get_Optional_Header();
+            optional_header.index())
     {
-        sh = &Get_Section_Header(i);
+        case 1:
+            _section_index.Add(0, std::get<Optional_Header>(optional_header).Size_Of_Headers, 0);
+            break;
 
-        if ((RVA > sh->Virtual_Address) && (RVA < (sh->Virtual_Address + sh->Virtual_Size)))
+        case 2:
+            _section_index.Add(0, std::get<Optional_Header_Plus>(optional_header).Size_Of_Headers, 0);
             break;
+    }
 
-        sh = nullptr;
+    for (int i = 0; i < Number_Of_Sections; ++i)
+    {
+        auto const& sh = Get_Section_Header(i);
+
+        // Object files leave Virtual_Size at zero.
+        uint64_t const size = sh.Virtual_Size ? sh.Virtual_Size : sh.Size_Of_Raw_Data;
+
+        _section_index.Add(sh.Virtual_Address, uint64_t(sh.Virtual_Address) + size, sh.Pointer_To_Raw_Data);
     }
 
-    if (sh == nullptr)
+    _section_index.Build();
+}
+
+uint64_t MZ::Resolve_RVA(uint64_t RVA) const
+{
+    std::call_once(_section_index_built, [this] { build_section_index(); });
+
+    auto const* section = _section_index.Find(RVA);
+
+    if (section == nullptr)
         return std::numeric_limits<uint64_t>::max();
 
-    uint64_t offset = RVA - sh->Virtual_Address;
-    return sh->Pointer_To_Raw_Data + offset;
+    uint64_t offset = RVA - section->Start;
+    return section->Value + offset;
 }
 
 MZ::Hint_Name_Table_Entry const* MZ::Get_Hint_Name_Table_Entry(uint32_t RVA) const
@@ -184,3 +317,589 @@ std::string_view MZ::Get_String(uint32_t RVA) const
     return Parsed_File::Get_String(Resolve_RVA(RVA));
 }
 
+
+template<typename T>
+array_view<T const> MZ::get_rva_table(uint32_t RVA, size_t count) const
+{
+    auto const offset = Resolve_RVA(RVA);
+    auto const size = buffer().size();
+
+    if ((offset > size) || (count > (size - offset) / sizeof(T)))
+        return { static_cast<T const*>(nullptr), size_t(0) };
+
+    return { As<T>(offset), count };
+}
+
+std::string_view MZ::get_rva_string(uint32_t RVA) const
+{
+    auto const offset = Resolve_RVA(RVA);
+    auto const contents = buffer();
+
+    if (offset >= contents.size())
+        return {};
+
+    auto const text = contents.substr(offset);
+
+    return text.substr(0, text.find('\0'));
+}
+
+std::vector<MZ::Imported_Library> MZ::Get_Imports() const
+{
+    std::vector<Imported_Library> libraries;
+    Image_Data_Directories idd;
+
+    if (!get_data_directories(idd) || (idd.Import_Table.Virtual_Address == 0))
+        return libraries;
+
+    bool const is_pe32_plus = (get_field<Magic_Number>(Get_Optional_Header_Address()) == Magic_Number::PE32_PLUS);
+    size_t const entry_size = is_pe32_plus ? sizeof(uint64_t) : sizeof(uint32_t);
+    uint64_t const ordinal_flag = is_pe32_plus ? (uint64_t(1) << 63) : (uint64_t(1) << 31);
+
+    for (uint32_t RVA = idd.Import_Table.Virtual_Address; ; RVA += sizeof(Import_Directory_Table_Entry))
+    {
+        auto const entry = get_rva_table<Import_Directory_Table_Entry>(RVA, 1);
+
+        if (entry.empty() || (entry[0].Import_Lookup_Table_RVA == 0))
+            break;
+
+        Imported_Library library { get_rva_string(entry[0].Name_RVA), entry[0], {} };
+
+        for (uint32_t lookup_RVA = entry[0].Import_Lookup_Table_RVA; ; lookup_RVA += entry_size)
+        {
+            uint64_t value = 0;
+
+            if (is_pe32_plus)
+            {
+                auto const lookup = get_rva_table<uint64_t>(lookup_RVA, 1);
+                value = lookup.empty() ? 0 : lookup[0];
+            } else {
+                auto const lookup = get_rva_table<uint32_t>(lookup_RVA, 1);
+                value = lookup.empty() ? 0 : lookup[0];
+            }
+
+            if (value == 0)
+                break;
+
+            if (value & ordinal_flag)
+            {
+                library.Functions.push_back(Imported_Function { {}, 0, uint16_t(value), true });
+                continue;
+            }
+
+            auto const hint_name_RVA = uint32_t(value & 0x7fffffff);
+            auto const hint = get_rva_table<uint16_t>(hint_name_RVA, 1);
+
+            library.Functions.push_back(
+                Imported_Function { get_rva_string(hint_name_RVA + 2), hint.empty() ? uint16_t(0) : hint[0], 0, false });
+        }
+
+        libraries.push_back(std::move(library));
+    }
+
+    return libraries;
+}
+
+MZ::Export_Table const* MZ::Get_Export_Table() const
+{
+    std::call_once(_export_table_found, [this] { find_export_table(); });
+
+    return _export_table.get();
+}
+
+void MZ::find_export_table() const
+{
+    Image_Data_Directories idd;
+
+    if (!get_data_directories(idd) || (idd.Export_Table.Virtual_Address == 0))
+        return;
+
+    auto const directory = get_rva_table<Export_Directory_Table>(idd.Export_Table.Virtual_Address, 1);
+
+    if (directory.empty())
+        return;
+
+    auto const addresses = get_rva_table<uint32_t>(directory[0].Export_Address_Table_RVA, directory[0].Address_Table_Entries);
+    auto const name_pointers = get_rva_table<uint32_t>(directory[0].Name_Pointer_RVA, directory[0].Number_Of_Name_Pointers);
+    auto const name_ordinals = get_rva_table<uint16_t>(directory[0].Ordinal_Table_RVA, directory[0].Number_Of_Name_Pointers);
+
+    if ((addresses.size() != directory[0].Address_Table_Entries) ||
+        (name_pointers.size() != directory[0].Number_Of_Name_Pointers) ||
+        (name_ordinals.size() != directory[0].Number_Of_Name_Pointers))
+        return;
+
+    _export_table.reset(
+        new Export_Table {
+            *this, directory[0],
+            uint32_t(idd.Export_Table.Virtual_Address), uint32_t(idd.Export_Table.Virtual_Address + idd.Export_Table.Size),
+            addresses, name_pointers, name_ordinals });
+}
+
+MZ::Export_Table::Export_Table(
+        MZ const& mz, Export_Directory_Table const& directory, uint32_t directory_start, uint32_t directory_end,
+        array_view<uint32_t const> addresses, array_view<uint32_t const> name_pointers, array_view<uint16_t const> name_ordinals):
+    _mz{mz},
+    _directory{directory},
+    _directory_start{directory_start},
+    _directory_end{directory_end},
+    _addresses{addresses},
+    _name_pointers{name_pointers},
+    _name_ordinals{name_ordinals},
+    _names_start{0},
+    _names_end{0},
+    _names_offset{0}
+{
+    if (_name_pointers.empty())
+        return;
+
+    std::call_once(mz._section_index_built, [&mz] { mz.build_section_index(); });
+
+    if (auto const* section = mz._section_index.Find(_name_pointers[0]))
+    {
+        _names_start = section->Start;
+        _names_end = section->End;
+        _names_offset = section->Value;
+    }
+}
+
+int MZ::Export_Table::compare_name(uint32_t name_index, std::string_view name) const
+{
+    auto const RVA = _name_pointers[name_index];
+    auto const offset = ((RVA >= _names_start) && (RVA < _names_end)) ? (RVA - _names_start) + _names_offset : _mz.Resolve_RVA(RVA);
+    auto const contents = _mz.buffer();
+
+    if (offset >= contents.size())
+        return name.empty() ? 0 : -1;
+
+    auto const* text = reinterpret_cast<unsigned char const*>(contents.data() + offset);
+    auto const available = contents.size() - offset;
+
+    for (size_t i = 0; ; ++i)
+    {
+        // The end of the buffer ends the name as a NUL would.
+        int const left = (i < available) ? text[i] : 0;
+
+        if (i == name.size())
+            return left;
+
+        if ((left != uint8_t(name[i])) || (left == 0))
+            return left - int(uint8_t(name[i])) - (left == 0);
+    }
+}
+
+std::string_view MZ::Export_Table::Get_DLL_Name() const
+{
+    return _mz.get_rva_string(_directory.Name_RVA);
+}
+
+MZ::Export_Table::Export MZ::Export_Table::Get_Export(uint32_t address_index) const
+{
+    auto const RVA = _addresses[address_index];
+
+    Export result { _directory.Ordinal_Base + address_index, RVA, {} };
+
+    if ((RVA >= _directory_start) && (RVA < _directory_end))
+        result.Forwarder = _mz.get_rva_string(RVA);
+
+    return result;
+}
+
+std::string_view MZ::Export_Table::Get_Name(uint32_t name_index) const
+{
+    return _mz.get_rva_string(_name_pointers[name_index]);
+}
+
+std::vector<std::string_view> MZ::Export_Table::Get_Names_By_Address() const
+{
+    std::vector<std::string_view> names(size());
+
+    for (uint32_t i = 0; i < Get_Name_Count(); ++i)
+        if ((Get_Name_Target(i) < names.size()) && names[Get_Name_Target(i)].empty())
+            names[Get_Name_Target(i)] = Get_Name(i);
+
+    return names;
+}
+
+uint32_t MZ::Export_Table::Find_By_Ordinal(uint32_t ordinal) const
+{
+    if ((ordinal < _directory.Ordinal_Base) || (ordinal - _directory.Ordinal_Base >= _addresses.size()))
+        return npos;
+
+    return ordinal - _directory.Ordinal_Base;
+}
+
+uint32_t MZ::Export_Table::lower_bound(std::string_view name, uint32_t from, uint32_t to) const
+{
+    while (from < to)
+    {
+        auto const middle = from + ((to - from) / 2);
+
+        if (compare_name(middle, name) < 0)
+            from = middle + 1;
+        else
+            to = middle;
+    }
+
+    return from;
+}
+
+uint32_t MZ::Export_Table::Find(std::string_view name, uint32_t hint) const
+{
+    auto const count = uint32_t(Get_Name_Count());
+
+    if ((hint >= count) || (compare_name(hint, name) != 0))
+        hint = lower_bound(name, 0, count);
+
+    if ((hint == count) || (compare_name(hint, name) != 0) || (Get_Name_Target(hint) >= _addresses.size()))
+        return npos;
+
+    return Get_Name_Target(hint);
+}
+
+std::vector<uint32_t> MZ::Export_Table::Find_All(std::span<std::string_view const> names) const
+{
+    std::vector<uint32_t> order(names.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    if (!std::is_sorted(names.begin(), names.end()))
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+
+    std::vector<uint32_t> results(names.size(), npos);
+
+    auto const count = uint32_t(Get_Name_Count());
+    uint32_t from = 0;
+
+    for (auto const i: order)
+    {
+        auto const& name = names[i];
+
+        // Gallop to a window that ends past the name, then search inside it.
+        uint32_t step = 1;
+        uint32_t to = from;
+
+        while ((to < count) && (compare_name(to, name) < 0))
+        {
+            from = to + 1;
+            to = (count - to > step) ? to + step : count;
+            step *= 2;
+        }
+
+        from = lower_bound(name, from, to);
+
+        if ((from < count) && (compare_name(from, name) == 0) && (Get_Name_Target(from) < _addresses.size()))
+            results[i] = Get_Name_Target(from);
+    }
+
+    return results;
+}
+
+std::pair<std::string_view, std::string_view> MZ::Export_Table::Split_Forwarder(std::string_view forwarder)
+{
+    auto const dot = forwarder.rfind('.');
+
+    if (dot == std::string_view::npos)
+        return { {}, forwarder };
+
+    return { forwarder.substr(0, dot), forwarder.substr(dot + 1) };
+}
+
+std::optional<MZ::Resource_Directory> MZ::Get_Resource_Directory() const
+{
+    Image_Data_Directories idd;
+
+    if (!get_data_directories(idd) || (idd.Resource_Table.Virtual_Address == 0))
+        return std::nullopt;
+
+    return get_resource_directory(idd.Resource_Table.Virtual_Address, 0, 0);
+}
+
+std::optional<MZ::Resource_Directory> MZ::get_resource_directory(uint32_t root_RVA, uint32_t offset, uint32_t depth) const
+{
+    auto const table = get_rva_table<Resource_Directory_Table>(root_RVA + offset, 1);
+
+    if (table.empty())
+        return std::nullopt;
+
+    auto const count = size_t(table[0].Number_Of_Name_Entries) + table[0].Number_Of_ID_Entries;
+    auto const entries = get_rva_table<Resource_Directory_Entry>(root_RVA + offset + sizeof(Resource_Directory_Table), count);
+
+    if (entries.size() != count)
+        return std::nullopt;
+
+    return Resource_Directory(*this, root_RVA, depth, table[0], entries);
+}
+
+std::optional<std::string_view> MZ::Find_Resource(uint32_t type, uint32_t id, uint32_t language) const
+{
+    uint32_t const path[] = { type, id, language };
+    auto directory = Get_Resource_Directory();
+
+    for (size_t level = 0; directory; ++level)
+    {
+        auto const index =
+            (path[level] != Any_Resource) ? directory->Find(path[level]) :
+            (directory->size() > 0) ? 0 : Resource_Directory::npos;
+
+        if (index == Resource_Directory::npos)
+            return std::nullopt;
+
+        auto const entry = directory->Get_Entry(index);
+
+        if (level == std::size(path) - 1)
+        {
+            auto const data = directory->Get_Data(entry);
+
+            if (!data)
+                return std::nullopt;
+
+            return data->Contents;
+        }
+
+        directory = directory->Get_Directory(entry);
+    }
+
+    return std::nullopt;
+}
+
+MZ::Resource_Directory::Resource_Directory(
+        MZ const& mz, uint32_t root_RVA, uint32_t depth,
+        Resource_Directory_Table const& table, array_view<Resource_Directory_Entry const> entries):
+    _mz{&mz},
+    _root_RVA{root_RVA},
+    _depth{depth},
+    _table{table},
+    _entries{entries}
+{}
+
+MZ::Resource_Directory::Entry MZ::Resource_Directory::Get_Entry(size_t i) const
+{
+    auto const& entry = _entries[i];
+    Entry result { 0, {}, (entry.Offset & 0x80000000) != 0, entry.Offset & 0x7fffffff };
+
+    if ((entry.Name_Offset_Or_ID & 0x80000000) == 0)
+    {
+        result.ID = entry.Name_Offset_Or_ID;
+        return result;
+    }
+
+    auto const name_RVA = _root_RVA + (entry.Name_Offset_Or_ID & 0x7fffffff);
+    auto const length = _mz->get_rva_table<uint16_t>(name_RVA, 1);
+
+    if (length.empty())
+        return result;
+
+    auto const units = _mz->get_rva_table<uint16_t>(name_RVA + sizeof(uint16_t), length[0]);
+
+    if (units.size() == length[0])
+        result.Name = std::string_view(reinterpret_cast<char const*>(units.begin()), units.size() * sizeof(uint16_t));
+
+    return result;
+}
+
+int MZ::Resource_Directory::compare_name(size_t i, std::u16string_view name) const
+{
+    auto const fold = [](uint16_t c) { return ((c >= 'a') && (c <= 'z')) ? uint16_t(c - ('a' - 'A')) : c; };
+
+    auto const bytes = Get_Entry(i).Name;
+    auto const length = bytes.size() / sizeof(uint16_t);
+
+    for (size_t k = 0; (k < length) && (k < name.size()); ++k)
+    {
+        uint16_t unit;
+        std::memcpy(&unit, bytes.data() + (k * sizeof(uint16_t)), sizeof(unit));
+
+        auto const a = fold(unit);
+        auto const b = fold(uint16_t(name[k]));
+
+        if (a != b)
+            return (a < b) ? -1 : 1;
+    }
+
+    return (length < name.size()) ? -1 : (length > name.size()) ? 1 : 0;
+}
+
+size_t MZ::Resource_Directory::Find(uint32_t id) const
+{
+    auto const first = std::min<size_t>(_table.Number_Of_Name_Entries, _entries.size());
+
+    auto const* entry = std::lower_bound(
+        _entries.begin() + first, _entries.end(), id,
+        [](Resource_Directory_Entry const& entry, uint32_t id) { return entry.Name_Offset_Or_ID < id; });
+
+    if ((entry == _entries.end()) || (entry->Name_Offset_Or_ID != id))
+        return npos;
+
+    return size_t(entry - _entries.begin());
+}
+
+size_t MZ::Resource_Directory::Find(std::u16string_view name) const
+{
+    size_t low = 0;
+    size_t high = std::min<size_t>(_table.Number_Of_Name_Entries, _entries.size());
+
+    while (low < high)
+    {
+        auto const middle = low + (high - low) / 2;
+
+        if (compare_name(middle, name) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if ((low == std::min<size_t>(_table.Number_Of_Name_Entries, _entries.size())) || (compare_name(low, name) != 0))
+        return npos;
+
+    return low;
+}
+
+std::optional<MZ::Resource_Directory> MZ::Resource_Directory::Get_Directory(Entry const& entry) const
+{
+    if (!entry.Is_Directory || (_depth + 1 >= Maximum_Depth))
+        return std::nullopt;
+
+    return _mz->get_resource_directory(_root_RVA, entry.Offset, _depth + 1);
+}
+
+std::optional<MZ::Resource_Directory::Data> MZ::Resource_Directory::Get_Data(Entry const& entry) const
+{
+    if (entry.Is_Directory)
+        return std::nullopt;
+
+    auto const data_entry = _mz->get_rva_table<Resource_Data_Entry>(_root_RVA + entry.Offset, 1);
+
+    if (data_entry.empty())
+        return std::nullopt;
+
+    Data data { data_entry[0], {} };
+    auto const contents = _mz->get_rva_table<char>(data_entry[0].Data_RVA, data_entry[0].Size);
+
+    if (contents.size() == data_entry[0].Size)
+        data.Contents = std::string_view(contents.begin(), contents.size());
+
+    return data;
+}
+
+MZ::Symbol_Table const* MZ::Get_Symbol_Table() const
+{
+    std::call_once(_symbol_table_found, [this] { find_symbol_table(); });
+
+    return _symbol_table.get();
+}
+
+void MZ::find_symbol_table() const
+{
+    auto const header = Get_Header();
+    auto const contents = buffer();
+
+    if ((header.Pointer_to_Symbol_Table == 0) || (header.Pointer_to_Symbol_Table > contents.size()))
+        return;
+
+    auto const records_size = uint64_t(header.Number_Of_Symbols) * sizeof(Symbol_Table_Entry);
+
+    if (records_size > contents.size() - header.Pointer_to_Symbol_Table)
+        return;
+
+    //
+    //  The string table's size includes its own four bytes; one that is
+    //  missing, or claims more than the file holds, is taken to be as long
+    //  as the rest of the file.
+    //
+    auto const strings_offset = header.Pointer_to_Symbol_Table + records_size;
+    auto strings = contents.substr(strings_offset);
+
+    if (strings.size() >= sizeof(uint32_t))
+    {
+        uint32_t strings_size;
+        std::memcpy(&strings_size, strings.data(), sizeof(strings_size));
+
+        if (strings_size >= sizeof(uint32_t))
+            strings = strings.substr(0, strings_size);
+    }
+
+    _symbol_table.reset(
+        new Symbol_Table {
+            { As<Symbol_Table_Entry>(header.Pointer_to_Symbol_Table), size_t(header.Number_Of_Symbols) },
+            strings });
+}
+
+MZ::Symbol_Table::Symbol_Table(array_view<Symbol_Table_Entry const> records, std::string_view strings):
+    _records{records},
+    _strings{strings}
+{}
+
+uint32_t MZ::Symbol_Table::Next(uint32_t index) const
+{
+    return uint32_t(std::min<uint64_t>(uint64_t(index) + 1 + _records[index].Number_Of_Aux_Symbols, _records.size()));
+}
+
+std::string_view MZ::Symbol_Table::Get_Name(Symbol_Table_Entry const& symbol) const
+{
+    uint32_t zeroes;
+    std::memcpy(&zeroes, &symbol.Name[0], sizeof(zeroes));
+
+    if (zeroes != 0)
+    {
+        std::string_view name(&symbol.Name[0], sizeof(symbol.Name));
+        return name.substr(0, name.find('\0'));
+    }
+
+    uint32_t offset;
+    std::memcpy(&offset, &symbol.Name[4], sizeof(offset));
+
+    return Get_String(offset);
+}
+
+array_view<MZ::Auxiliary_Symbol_Record const> MZ::Symbol_Table::Get_Auxiliary_Records(uint32_t index) const
+{
+    auto const count = Next(index) - (index + 1);
+
+    return { reinterpret_cast<Auxiliary_Symbol_Record const*>(&_records[index]) + 1, size_t(count) };
+}
+
+std::string_view MZ::Symbol_Table::Get_File_Name(uint32_t index) const
+{
+    auto const records = Get_Auxiliary_Records(index);
+
+    if (records.empty())
+        return {};
+
+    std::string_view name(records[0].File_Name, records.size() * sizeof(Auxiliary_Symbol_Record));
+
+    return name.substr(0, name.find('\0'));
+}
+
+std::string_view MZ::Symbol_Table::Get_String(uint32_t offset) const
+{
+    // Offsets below 4 would land in the size field.
+    if ((offset < sizeof(uint32_t)) || (offset >= _strings.size()))
+        return {};
+
+    auto const text = _strings.substr(offset);
+
+    return text.substr(0, text.find('\0'));
+}
+
+void MZ::Symbol_Table::build_name_index() const
+{
+    for (uint32_t i = 0; i < _records.size(); i = Next(i))
+        if (!Get_Name(_records[i]).empty())
+            _name_index.push_back(i);
+
+    std::stable_sort(
+        _name_index.begin(), _name_index.end(),
+        [this](uint32_t a, uint32_t b) { return Get_Name(_records[a]) < Get_Name(_records[b]); });
+}
+
+uint32_t MZ::Symbol_Table::Find(std::string_view name) const
+{
+    std::call_once(_name_index_built, [this] { build_name_index(); });
+
+    auto const entry = std::lower_bound(
+        _name_index.begin(), _name_index.end(), name,
+        [this](uint32_t index, std::string_view name) { return Get_Name(_records[index]) < name; });
+
+    if ((entry == _name_index.end()) || (Get_Name(_records[*entry]) != name))
+        return npos;
+
+    return *entry;
+}
@@ -3,9 +3,14 @@
 
 #include "include/enum.h"
 #include "include/file-format.h"
+#include "include/interval-index.h"
 
-#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -22,6 +27,16 @@ class MZ: public Parsed_File
         struct Import_Directory_Table_Entry;
         struct Import_Lookup_Table_Entry;
         struct Hint_Name_Table_Entry;
+        struct Export_Directory_Table;
+        struct Resource_Directory_Table;
+        struct Resource_Directory_Entry;
+        struct Resource_Data_Entry;
+        struct Symbol_Table_Entry;
+        union Auxiliary_Symbol_Record;
+
+        class Export_Table;
+        class Resource_Directory;
+        class Symbol_Table;
 
         enum class Machine_Type: uint16_t;
         enum class Image_Subsystem: uint16_t;
@@ -32,24 +47,75 @@ class MZ: public Parsed_File
 
         enum class Section_Characteristics: uint32_t;
 
+        enum class Resource_Type: uint32_t;
+
+        enum class Special_Section_Number: int16_t;
+        enum class Symbol_Storage_Class: uint8_t;
+
+        struct Imported_Function;
+        struct Imported_Library;
+
+    private:
+        // Bare COFF object files have no MZ stub or PE signature: the COFF header is at offset 0.
+        bool _is_object = false;
+
+        //
+        //  Section VA ranges -> raw data offset, built on the first RVA that
+        //  needs resolving.
+        //
+        mutable std::once_flag _section_index_built;
+        mutable Interval_Index<uint64_t, uint64_t> _section_index;
+
+        void build_section_index() const;
+
+        mutable std::once_flag _export_table_found;
+        mutable std::unique_ptr<Export_Table> _export_table;
+
+        void find_export_table() const;
+
+        mutable std::once_flag _symbol_table_found;
+        mutable std::unique_ptr<Symbol_Table> _symbol_table;
+
+        void find_symbol_table() const;
+
+        // The directory at offset from the start of the resource directory at root_RVA.
+        std::optional<Resource_Directory> get_resource_directory(uint32_t root_RVA, uint32_t offset, uint32_t depth) const;
+
     protected:
         using Parsed_File::Parsed_File;
 
         Optional_Header get_optional_header() const;
         Optional_Header_Plus get_optional_header_plus() const;
 
+        // A copy: the directories sit unaligned inside either optional header.
+        bool get_data_directories(Image_Data_Directories& directories) const;
+
+        //
+        //  Views of file data by RVA that come back empty when the RVA does
+        //  not map into the file or the data would run past its end.
+        //
+        template<typename T>
+        array_view<T const> get_rva_table(uint32_t RVA, size_t count) const;
+
+        std::string_view get_rva_string(uint32_t RVA) const;
+
     public:
         static MZ* Parse(std::string_view buffer);
 
-        virtual ~MZ() {}
-
         virtual File_Format Get_File_Format() const;
 
         std::string_view Get_String(uint32_t RVA) const;
 
-        COFF_Header const& Get_Header() const;
+        //
+        //  A copy, so that object files can report theirs too: they have no
+        //  PE signature, and their Signature reads as 0.
+        //
+        COFF_Header Get_Header() const;
+
+        // nullptr when there is no optional header, as in object files.
         std::variant<std::nullptr_t, Optional_Header, Optional_Header_Plus> Get_Optional_Header() const;
 
+        // The offset of the PE signature, which the COFF header fields follow; 0 for object files.
         uint32_t Get_COFF_Header_Address() const;
         uint32_t Get_COFF_Header_Size() const;
 
@@ -61,11 +127,46 @@ class MZ: public Parsed_File
         Section_Header const& Get_Section_Header(uint16_t i) const;
         std::string_view Get_Section_Name(Section_Header const& sh) const;
 
+        //
+        //  Whether the section has contents in the file.  Uninitialized data
+        //  (.bss) has none, though objects give its size in Size_Of_Raw_Data
+        //  with a zero Pointer_To_Raw_Data.
+        //
+        static bool Has_File_Data(Section_Header const& sh);
+
         Import_Directory_Table_Entry const* Get_Import_Table() const;
         Import_Lookup_Table_Entry const* Get_Import_Lookup_Table(uint32_t RVA) const;
         Hint_Name_Table_Entry const* Get_Hint_Name_Table_Entry(uint32_t RVA) const;
 
+        //
+        //  The import directory, read with bounds checks.  Lookup table
+        //  entries are 32 bits wide in PE32 images and 64 in PE32+; a table
+        //  that runs off the file ends early instead of being read past it.
+        //
+        std::vector<Imported_Library> Get_Imports() const;
+
+        // nullptr when the image exports nothing or its export directory is damaged.
+        Export_Table const* Get_Export_Table() const;
+
+        // nullptr when the file has no COFF symbol table or it runs past the end of the file.
+        Symbol_Table const* Get_Symbol_Table() const;
+
+        // The root of the resource tree; nothing when there is none or it lies outside the file.
+        std::optional<Resource_Directory> Get_Resource_Directory() const;
+
+        //
+        //  The contents of one resource, found by following the path to it
+        //  and nothing else: type, then ID, then language.  Any_Resource
+        //  for the ID or the language takes the first entry at that level.
+        //
+        static constexpr uint32_t Any_Resource = ~uint32_t(0);
+
+        std::optional<std::string_view> Find_Resource(
+            uint32_t type, uint32_t id = Any_Resource, uint32_t language = Any_Resource) const;
+
         uint64_t Resolve_RVA(uint64_t rva) const;
+
+        ~MZ() override;
 };
 
 struct __attribute__((packed)) MZ::COFF_Header
@@ -113,7 +214,7 @@ enum class MZ::Machine_Type: uint16_t
 
 static inline string_view Get_Machine_Type_Name(MZ::Machine_Type mt)
 {
-    static std::map<MZ::Machine_Type, string_view> enum_map = {
+    static constexpr auto enum_map = Make_Enum_Name_Table<MZ::Machine_Type>({
         {MZ::Machine_Type::UNKNOWN, "The content of this field is assumed to be applicable to any machine type"sv},
         {MZ::Machine_Type::AM33, "Matsushita AM33"sv},
         {MZ::Machine_Type::AMD64, "x64"sv},
@@ -141,7 +242,7 @@ static inline string_view Get_Machine_Type_Name(MZ::Machine_Type mt)
         {MZ::Machine_Type::SH5, "Hitachi SH5"sv},
         {MZ::Machine_Type::THUMB, "Thumb"sv},
         {MZ::Machine_Type::WCEMIPSV2, "MIPS little-endian WCE v2"sv}
-    };
+    });
 
     return enum_map[MZ::Machine_Type{mt}];
 }
@@ -170,7 +271,7 @@ ENABLE_BITWISE_OPERATIONS(MZ::Image_File_Characteristics);
 
 static inline string_view Get_Image_File_Characteristics_Name(MZ::Image_File_Characteristics ifc)
 {
-    static std::map<MZ::Image_File_Characteristics, string_view> enum_map = {
+    static constexpr auto enum_map = Make_Enum_Name_Table<MZ::Image_File_Characteristics>({
         {MZ::Image_File_Characteristics::RELOCS_STRIPPED, "Image only, Windows CE, and Microsoft Windows NT and later. This indicates that the file does not contain base relocations and must therefore be loaded at its preferred base address. If the base address is not available, the loader reports an error. The default behavior of the linker is to strip base relocations from executable (EXE) files."},
         {MZ::Image_File_Characteristics::EXECUTABLE_IMAGE, "Image only. This indicates that the image file is valid and can be run. If this flag is not set, it indicates a linker error."},
         {MZ::Image_File_Characteristics::LINE_NUMS_STRIPPED, "COFF line numbers have been removed. This flag is deprecated and should be zero."},
@@ -187,14 +288,14 @@ static inline string_view Get_Image_File_Characteristics_Name(MZ::Image_File_Cha
         {MZ::Image_File_Characteristics::DLL, "The image file is a dynamic-link library (DLL). Such files are considered executable files for almost all purposes, although they cannot be directly run."},
         {MZ::Image_File_Characteristics::UP_SYSTEM_ONLY, "The file should be run only on a uniprocessor machine."},
         {MZ::Image_File_Characteristics::BYTES_REVERSED_HI, "Big endian: the MSB precedes the LSB in memory. This flag is deprecated and should be zero."},
-    };
+    });
 
     return enum_map[MZ::Image_File_Characteristics{ifc}];
 }
 
 static inline constexpr auto Get_Image_File_Characteristics_Names = [](MZ::Image_File_Characteristics ifc)
 {
-    return Get_Enum_Names<MZ::Image_File_Characteristics>(ifc, &Get_Image_File_Characteristics_Name);
+    return Get_Enum_Names<&Get_Image_File_Characteristics_Name>(ifc);
 };
 
 enum class MZ::Magic_Number: uint16_t
@@ -207,10 +308,10 @@ static inline string_view Get_Magic_Number_Name(MZ::Magic_Number mn)
 {
     using Magic_Number = MZ::Magic_Number;
 
-    static std::map<Magic_Number, string_view> enum_map = {
+    static constexpr auto enum_map = Make_Enum_Name_Table<Magic_Number>({
         {Magic_Number::PE32, "PE32"sv},
         {Magic_Number::PE32_PLUS, "PE32+"sv}
-    };
+    });
 
     return enum_map[Magic_Number{mn}];
 }
@@ -235,7 +336,7 @@ enum class MZ::Image_Subsystem: uint16_t
 
 static inline string_view Get_Subsystem_Name(MZ::Image_Subsystem s)
 {
-    static std::map<MZ::Image_Subsystem, string_view> enum_map = {
+    static constexpr auto enum_map = Make_Enum_Name_Table<MZ::Image_Subsystem>({
         {MZ::Image_Subsystem::UNKNOWN, "An unknown subsystem"},
         {MZ::Image_Subsystem::NATIVE, "Device drivers and native Windows processes"},
         {MZ::Image_Subsystem::WINDOWS_GUI, "The Windows graphical user interface (GUI) subsystem"},
@@ -250,7 +351,7 @@ static inline string_view Get_Subsystem_Name(MZ::Image_Subsystem s)
         {MZ::Image_Subsystem::EFI_ROM, "An EFI ROM image"},
         {MZ::Image_Subsystem::XBOX, "XBOX"},
         {MZ::Image_Subsystem::WINDOWS_BOOT_APPLICATION, "Windows boot application."}
-    };
+    });
 
     return enum_map[MZ::Image_Subsystem{s}];
 }
@@ -278,7 +379,7 @@ ENABLE_BITWISE_OPERATIONS(MZ::Image_DLL_Characteristics);
 
 static inline string_view Get_Image_DLL_Characteristics_Name(MZ::Image_DLL_Characteristics idc)
 {
-    static std::map<MZ::Image_DLL_Characteristics, string_view> enum_map = {
+    static constexpr auto enum_map = Make_Enum_Name_Table<MZ::Image_DLL_Characteristics>({
         {MZ::Image_DLL_Characteristics::MBZ_1, "Reserved, must be zero."},
         {MZ::Image_DLL_Characteristics::MBZ_2, "Reserved, must be zero."},
         {MZ::Image_DLL_Characteristics::MBZ_4, "Reserved, must be zero."},
@@ -294,14 +395,14 @@ static inline string_view Get_Image_DLL_Characteristics_Name(MZ::Image_DLL_Chara
         {MZ::Image_DLL_Characteristics::WDM_DRIVER, "A WDM driver."},
         {MZ::Image_DLL_Characteristics::GUARD_CF, "Image supports Control Flow Guard."},
         {MZ::Image_DLL_Characteristics::TERMINAL_SERVER_AWARE, "Terminal Server aware."}
-    };
+    });
 
     return enum_map[MZ::Image_DLL_Characteristics{idc}];
 }
 
 static inline constexpr auto Get_Image_DLL_Characteristics_Names = [](MZ::Image_DLL_Characteristics ifc)
 {
-    return Get_Enum_Names<MZ::Image_DLL_Characteristics>(ifc, &Get_Image_DLL_Characteristics_Name);
+    return Get_Enum_Names<&Get_Image_DLL_Characteristics_Name>(ifc);
 };
 
 //
@@ -466,7 +567,7 @@ ENABLE_BITWISE_OPERATIONS(MZ::Section_Characteristics);
 
 static inline string_view Get_Section_Characteristics_Name(MZ::Section_Characteristics sc)
 {
-    static std::map<MZ::Section_Characteristics, string_view> enum_map = {
+    static constexpr auto enum_map = Make_Enum_Name_Table<MZ::Section_Characteristics>({
         {MZ::Section_Characteristics::RESERVED_0, "Reserved for future use."},
         {MZ::Section_Characteristics::RESERVED_1, "Reserved for future use."},
         {MZ::Section_Characteristics::RESERVED_2, "Reserved for future use."},
@@ -508,16 +609,161 @@ static inline string_view Get_Section_Characteristics_Name(MZ::Section_Character
         {MZ::Section_Characteristics::IMAGE_SCN_MEM_EXECUTE, "The section can be executed as code."},
         {MZ::Section_Characteristics::IMAGE_SCN_MEM_READ, "The section can be read."},
         {MZ::Section_Characteristics::IMAGE_SCN_MEM_WRITE, "The section can be written to."}
-    };
+    });
 
     return enum_map[MZ::Section_Characteristics{sc}];
 }
 
 static inline constexpr auto Get_Section_Characteristics_Names = [](MZ::Section_Characteristics sc)
 {
-    return Get_Enum_Names<MZ::Section_Characteristics>(sc, &Get_Section_Characteristics_Name);
+    return Get_Enum_Names<&Get_Section_Characteristics_Name>(sc);
 };
 
+struct __attribute__((packed)) MZ::Symbol_Table_Entry
+{
+    //
+    //  The name itself, NUL-padded, when it fits in 8 bytes; otherwise four
+    //  zero bytes and then the name's offset in the string table.
+    //
+    char Name[8];
+    uint32_t Value;
+    int16_t Section_Number;     // 1-based, or one of Special_Section_Number.
+    uint16_t Type;
+    Symbol_Storage_Class Storage_Class;
+
+    // Records that follow this one and belong to it; symbol indexes count them too.
+    uint8_t Number_Of_Aux_Symbols;
+};
+
+//
+//  The auxiliary formats the specification defines; which one applies
+//  depends on the storage class (and, for .bf/.ef, the name) of the symbol
+//  it follows.
+//
+union __attribute__((packed)) MZ::Auxiliary_Symbol_Record
+{
+    // EXTERNAL symbols of function type with a section number above 0.
+    struct __attribute__((packed))
+    {
+        uint32_t Tag_Index;
+        uint32_t Total_Size;
+        uint32_t Pointer_To_Linenumber;
+        uint32_t Pointer_To_Next_Function;
+        uint16_t Unused;
+    } Function_Definition;
+
+    // FUNCTION symbols named .bf or .ef.
+    struct __attribute__((packed))
+    {
+        uint32_t Unused_1;
+        uint16_t Linenumber;
+        uint8_t Unused_2[6];
+        uint32_t Pointer_To_Next_Function;  // .bf only.
+        uint16_t Unused_3;
+    } Begin_End_Function;
+
+    // WEAK_EXTERNAL symbols: the symbol to use when this one is not defined.
+    struct __attribute__((packed))
+    {
+        uint32_t Tag_Index;
+        uint32_t Characteristics;
+        uint8_t Unused[10];
+    } Weak_External;
+
+    // FILE symbols: the source file name, NUL-padded and spread over as many records as it needs.
+    char File_Name[18];
+
+    // STATIC symbols naming a section.
+    struct __attribute__((packed))
+    {
+        uint32_t Length;
+        uint16_t Number_Of_Relocations;
+        uint16_t Number_Of_Linenumbers;
+        uint32_t CheckSum;
+        uint16_t Number;            // The associated section, for IMAGE_COMDAT_SELECT_ASSOCIATIVE.
+        uint8_t Selection;
+        uint8_t Unused[3];
+    } Section_Definition;
+};
+
+static_assert(sizeof(MZ::Symbol_Table_Entry) == 18);
+static_assert(sizeof(MZ::Auxiliary_Symbol_Record) == sizeof(MZ::Symbol_Table_Entry));
+
+enum class MZ::Special_Section_Number: int16_t
+{
+    IMAGE_SYM_UNDEFINED = 0,
+    IMAGE_SYM_ABSOLUTE = -1,
+    IMAGE_SYM_DEBUG = -2
+};
+
+enum class MZ::Symbol_Storage_Class: uint8_t
+{
+    IMAGE_SYM_CLASS_NULL = 0,
+    IMAGE_SYM_CLASS_AUTOMATIC = 1,
+    IMAGE_SYM_CLASS_EXTERNAL = 2,
+    IMAGE_SYM_CLASS_STATIC = 3,
+    IMAGE_SYM_CLASS_REGISTER = 4,
+    IMAGE_SYM_CLASS_EXTERNAL_DEF = 5,
+    IMAGE_SYM_CLASS_LABEL = 6,
+    IMAGE_SYM_CLASS_UNDEFINED_LABEL = 7,
+    IMAGE_SYM_CLASS_MEMBER_OF_STRUCT = 8,
+    IMAGE_SYM_CLASS_ARGUMENT = 9,
+    IMAGE_SYM_CLASS_STRUCT_TAG = 10,
+    IMAGE_SYM_CLASS_MEMBER_OF_UNION = 11,
+    IMAGE_SYM_CLASS_UNION_TAG = 12,
+    IMAGE_SYM_CLASS_TYPE_DEFINITION = 13,
+    IMAGE_SYM_CLASS_UNDEFINED_STATIC = 14,
+    IMAGE_SYM_CLASS_ENUM_TAG = 15,
+    IMAGE_SYM_CLASS_MEMBER_OF_ENUM = 16,
+    IMAGE_SYM_CLASS_REGISTER_PARAM = 17,
+    IMAGE_SYM_CLASS_BIT_FIELD = 18,
+    IMAGE_SYM_CLASS_BLOCK = 100,
+    IMAGE_SYM_CLASS_FUNCTION = 101,
+    IMAGE_SYM_CLASS_END_OF_STRUCT = 102,
+    IMAGE_SYM_CLASS_FILE = 103,
+    IMAGE_SYM_CLASS_SECTION = 104,
+    IMAGE_SYM_CLASS_WEAK_EXTERNAL = 105,
+    IMAGE_SYM_CLASS_CLR_TOKEN = 107,
+    IMAGE_SYM_CLASS_END_OF_FUNCTION = 0xff
+};
+
+static inline string_view Get_Symbol_Storage_Class_Name(MZ::Symbol_Storage_Class sc)
+{
+    using Symbol_Storage_Class = MZ::Symbol_Storage_Class;
+
+    static constexpr auto enum_map = Make_Enum_Name_Table<Symbol_Storage_Class>({
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_NULL, "NULL"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_AUTOMATIC, "AUTOMATIC"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_EXTERNAL, "EXTERNAL"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_STATIC, "STATIC"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_REGISTER, "REGISTER"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_EXTERNAL_DEF, "EXTERNAL_DEF"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_LABEL, "LABEL"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_UNDEFINED_LABEL, "UNDEFINED_LABEL"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_MEMBER_OF_STRUCT, "MEMBER_OF_STRUCT"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_ARGUMENT, "ARGUMENT"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_STRUCT_TAG, "STRUCT_TAG"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_MEMBER_OF_UNION, "MEMBER_OF_UNION"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_UNION_TAG, "UNION_TAG"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_TYPE_DEFINITION, "TYPE_DEFINITION"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_UNDEFINED_STATIC, "UNDEFINED_STATIC"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_ENUM_TAG, "ENUM_TAG"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_MEMBER_OF_ENUM, "MEMBER_OF_ENUM"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_REGISTER_PARAM, "REGISTER_PARAM"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_BIT_FIELD, "BIT_FIELD"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_BLOCK, "BLOCK"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_FUNCTION, "FUNCTION"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_END_OF_STRUCT, "END_OF_STRUCT"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_FILE, "FILE"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_SECTION, "SECTION"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_WEAK_EXTERNAL, "WEAK_EXTERNAL"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_CLR_TOKEN, "CLR_TOKEN"sv},
+        {Symbol_Storage_Class::IMAGE_SYM_CLASS_END_OF_FUNCTION, "END_OF_FUNCTION"sv}
+    });
+
+    return enum_map[sc];
+}
+
 struct __attribute__((packed)) MZ::Import_Directory_Table_Entry
 {
     //
@@ -550,6 +796,21 @@ struct __attribute__((packed)) MZ::Import_Directory_Table_Entry
     uint32_t Import_Address_Table_RVA;
 };
 
+struct MZ::Imported_Function
+{
+    std::string_view Name;  // Empty for imports by ordinal.
+    uint16_t Hint;
+    uint16_t Ordinal;
+    bool By_Ordinal;
+};
+
+struct MZ::Imported_Library
+{
+    std::string_view Name;
+    Import_Directory_Table_Entry Directory;
+    std::vector<Imported_Function> Functions;
+};
+
 struct __attribute((packed)) MZ::Import_Lookup_Table_Entry
 {
     union {
@@ -601,5 +862,331 @@ struct __attribute((packed)) MZ::Hint_Name_Table_Entry
     // to align the next entry on an even boundary.
 };
 
-#endif  // MZ_H__INCLUDED
+struct __attribute__((packed)) MZ::Export_Directory_Table
+{
+    uint32_t Export_Flags;  // Reserved, must be 0.
+    uint32_t Time_Date_Stamp;
+    uint16_t Major_Version;
+    uint16_t Minor_Version;
+
+    // The RVA of the ASCII name of the DLL.
+    uint32_t Name_RVA;
+
+    // The ordinal of the first entry of the export address table, usually 1.
+    uint32_t Ordinal_Base;
+
+    uint32_t Address_Table_Entries;
+    uint32_t Number_Of_Name_Pointers;
+
+    uint32_t Export_Address_Table_RVA;
+
+    // RVAs of the export names, in lexical order so that they can be binary searched.
+    uint32_t Name_Pointer_RVA;
+
+    // For each name, the index of its entry in the export address table.
+    uint32_t Ordinal_Table_RVA;
+};
+
+//
+//  The export directory, read in place: the address table, and the name
+//  pointer and ordinal tables that map names onto it.  The name pointer
+//  table is sorted, so a name is found by binary search and a batch of
+//  names in one merged pass.  An export whose address lies inside the
+//  export directory is a forwarder: the address is that of a string naming
+//  the export it stands for, "DLL.Name" or "DLL.#Ordinal".
+//
+class MZ::Export_Table
+{
+    public:
+        static constexpr uint32_t npos = ~uint32_t(0);
+
+        struct Export
+        {
+            uint32_t Ordinal;   // Biased by the ordinal base.
+            uint32_t RVA;       // 0 for an unused slot.
+            std::string_view Forwarder;
+        };
+
+    private:
+        MZ const& _mz;
+        Export_Directory_Table _directory;
+        uint32_t _directory_start;
+        uint32_t _directory_end;
+
+        array_view<uint32_t const> _addresses;
+        array_view<uint32_t const> _name_pointers;
+        array_view<uint16_t const> _name_ordinals;
+
+        //
+        //  The RVA range, and its file offset, of the section holding the
+        //  first name: names are normally all in one section, so searches
+        //  can map them without going through Resolve_RVA.
+        //
+        uint64_t _names_start;
+        uint64_t _names_end;
+        uint64_t _names_offset;
 
+        // Compares the name at name_index with name like strcmp(), without measuring it first.
+        int compare_name(uint32_t name_index, std::string_view name) const;
+
+        Export_Table(
+            MZ const& mz, Export_Directory_Table const& directory, uint32_t directory_start, uint32_t directory_end,
+            array_view<uint32_t const> addresses, array_view<uint32_t const> name_pointers, array_view<uint16_t const> name_ordinals);
+
+        // The first name index at or after from whose name is not less than name.
+        uint32_t lower_bound(std::string_view name, uint32_t from, uint32_t to) const;
+
+        friend class MZ;
+
+    public:
+        Export_Directory_Table const& Get_Directory() const { return _directory; }
+        std::string_view Get_DLL_Name() const;
+
+        // Entries of the export address table.
+        size_t size() const { return _addresses.size(); }
+        Export Get_Export(uint32_t address_index) const;
+
+        size_t Get_Name_Count() const { return _name_ordinals.size(); }
+        std::string_view Get_Name(uint32_t name_index) const;
+
+        // The export address table index that the name at name_index refers to.
+        uint32_t Get_Name_Target(uint32_t name_index) const { return _name_ordinals[name_index]; }
+
+        // The name of each export address table entry; empty for those exported by ordinal only.
+        std::vector<std::string_view> Get_Names_By_Address() const;
+
+        // Export address table indexes, or npos.
+        uint32_t Find_By_Ordinal(uint32_t ordinal) const;
+
+        //
+        //  Tries the hint (an index into the name pointer table, as stored
+        //  with each import) first, then a binary search.
+        //
+        uint32_t Find(std::string_view name, uint32_t hint = npos) const;
+
+        //
+        //  Resolves a batch of names at once: they are looked up in sorted
+        //  order, each search galloping forward from where the previous one
+        //  ended, and the results come back in the order of names.
+        //
+        std::vector<uint32_t> Find_All(std::span<std::string_view const> names) const;
+
+        // "DLL.Name" -> { "DLL", "Name" }; the DLL name has no extension.
+        static std::pair<std::string_view, std::string_view> Split_Forwarder(std::string_view forwarder);
+};
+
+struct __attribute__((packed)) MZ::Resource_Directory_Table
+{
+    uint32_t Characteristics;   // Reserved, must be 0.
+    uint32_t Time_Date_Stamp;
+    uint16_t Major_Version;
+    uint16_t Minor_Version;
+
+    // The entries follow the table: those named by string first, then those named by ID.
+    uint16_t Number_Of_Name_Entries;
+    uint16_t Number_Of_ID_Entries;
+};
+
+struct __attribute__((packed)) MZ::Resource_Directory_Entry
+{
+    //
+    //  With the high bit set, the offset (from the start of the resource
+    //  directory) of the entry's name: a 16-bit length, then that many
+    //  UTF-16LE code units.  Otherwise the entry's integer ID.
+    //
+    uint32_t Name_Offset_Or_ID;
+
+    //
+    //  With the high bit set, the offset of a subdirectory; otherwise the
+    //  offset of a Resource_Data_Entry.
+    //
+    uint32_t Offset;
+};
+
+struct __attribute__((packed)) MZ::Resource_Data_Entry
+{
+    uint32_t Data_RVA;
+    uint32_t Size;
+    uint32_t Codepage;
+    uint32_t Reserved;          // Must be 0.
+};
+
+enum class MZ::Resource_Type: uint32_t
+{
+    Cursor = 1,
+    Bitmap = 2,
+    Icon = 3,
+    Menu = 4,
+    Dialog = 5,
+    String = 6,
+    Font_Directory = 7,
+    Font = 8,
+    Accelerator = 9,
+    RC_Data = 10,
+    Message_Table = 11,
+    Group_Cursor = 12,
+    Group_Icon = 14,
+    Version = 16,
+    Dialog_Include = 17,
+    Plug_And_Play = 19,
+    VxD = 20,
+    Animated_Cursor = 21,
+    Animated_Icon = 22,
+    HTML = 23,
+    Manifest = 24
+};
+
+// Empty for types that are not predefined.
+static inline string_view Get_Resource_Type_Name(MZ::Resource_Type type)
+{
+    using Resource_Type = MZ::Resource_Type;
+
+    static constexpr auto enum_map = Make_Enum_Name_Table<Resource_Type>({
+        {Resource_Type::Cursor, "CURSOR"sv},
+        {Resource_Type::Bitmap, "BITMAP"sv},
+        {Resource_Type::Icon, "ICON"sv},
+        {Resource_Type::Menu, "MENU"sv},
+        {Resource_Type::Dialog, "DIALOG"sv},
+        {Resource_Type::String, "STRING"sv},
+        {Resource_Type::Font_Directory, "FONTDIR"sv},
+        {Resource_Type::Font, "FONT"sv},
+        {Resource_Type::Accelerator, "ACCELERATOR"sv},
+        {Resource_Type::RC_Data, "RCDATA"sv},
+        {Resource_Type::Message_Table, "MESSAGETABLE"sv},
+        {Resource_Type::Group_Cursor, "GROUP_CURSOR"sv},
+        {Resource_Type::Group_Icon, "GROUP_ICON"sv},
+        {Resource_Type::Version, "VERSION"sv},
+        {Resource_Type::Dialog_Include, "DLGINCLUDE"sv},
+        {Resource_Type::Plug_And_Play, "PLUGPLAY"sv},
+        {Resource_Type::VxD, "VXD"sv},
+        {Resource_Type::Animated_Cursor, "ANICURSOR"sv},
+        {Resource_Type::Animated_Icon, "ANIICON"sv},
+        {Resource_Type::HTML, "HTML"sv},
+        {Resource_Type::Manifest, "MANIFEST"sv}
+    });
+
+    return enum_map[type];
+}
+
+//
+//  One directory of the resource tree, read in place.  The tree normally
+//  has three levels (type, then name or ID, then language) above the data
+//  entries, but nothing below a directory is read until it is asked for:
+//  finding one resource costs a binary search per level, however many
+//  others the image holds.  Entries named by string come before those named
+//  by ID, and each group is sorted, strings case-insensitively.  Trees
+//  deeper than Maximum_Depth are taken to loop back on themselves.
+//
+class MZ::Resource_Directory
+{
+    public:
+        static constexpr size_t npos = ~size_t(0);
+        static constexpr uint32_t Maximum_Depth = 8;
+
+        struct Entry
+        {
+            uint32_t ID;                // 0 for entries named by string.
+            std::string_view Name;      // The UTF-16LE bytes of the name; empty for entries named by ID.
+            bool Is_Directory;
+            uint32_t Offset;            // From the start of the resource directory.
+        };
+
+        struct Data
+        {
+            Resource_Data_Entry Entry;
+            std::string_view Contents;  // Empty when the data lies outside the file.
+        };
+
+    private:
+        MZ const* _mz;
+        uint32_t _root_RVA;
+        uint32_t _depth;
+
+        Resource_Directory_Table _table;
+        array_view<Resource_Directory_Entry const> _entries;
+
+        Resource_Directory(
+            MZ const& mz, uint32_t root_RVA, uint32_t depth,
+            Resource_Directory_Table const& table, array_view<Resource_Directory_Entry const> entries);
+
+        // Compares the name of entry i with name (UTF-16 code units) ignoring ASCII case.
+        int compare_name(size_t i, std::u16string_view name) const;
+
+        friend class MZ;
+
+    public:
+        Resource_Directory_Table const& Get_Table() const { return _table; }
+
+        // 0 for the root.
+        uint32_t Get_Depth() const { return _depth; }
+
+        size_t size() const { return _entries.size(); }
+        Entry Get_Entry(size_t i) const;
+
+        // Binary searches; indexes of entries, or npos.
+        size_t Find(uint32_t id) const;
+        size_t Find(std::u16string_view name) const;
+
+        // Nothing for a data entry, a directory outside the file, or one too deep.
+        std::optional<Resource_Directory> Get_Directory(Entry const& entry) const;
+
+        // Nothing for a subdirectory entry or a data entry outside the file.
+        std::optional<Data> Get_Data(Entry const& entry) const;
+};
+
+//
+//  The COFF symbol table, and the string table right after it, read in
+//  place.  Auxiliary records sit in the table between the symbols they
+//  belong to and count towards symbol indexes, as relocations use them;
+//  Next() steps over them.
+//
+class MZ::Symbol_Table
+{
+    public:
+        static constexpr uint32_t npos = ~uint32_t(0);
+
+    private:
+        array_view<Symbol_Table_Entry const> _records;
+
+        // Starts with its own 4-byte size, which string table offsets count.
+        std::string_view _strings;
+
+        //
+        //  Indexes of named symbols (auxiliary records skipped), sorted by
+        //  name and then index; built on the first Find().
+        //
+        mutable std::once_flag _name_index_built;
+        mutable std::vector<uint32_t> _name_index;
+
+        void build_name_index() const;
+
+        Symbol_Table(array_view<Symbol_Table_Entry const> records, std::string_view strings);
+
+        friend class MZ;
+
+    public:
+        // Records, auxiliary ones included.
+        size_t size() const { return _records.size(); }
+
+        Symbol_Table_Entry const& operator[](uint32_t index) const { return _records[index]; }
+
+        // The index of the next symbol after the one at index, past its auxiliary records.
+        uint32_t Next(uint32_t index) const;
+
+        // Empty for names that point outside the string table.
+        std::string_view Get_Name(Symbol_Table_Entry const& symbol) const;
+
+        // Fewer than Number_Of_Aux_Symbols when the table ends first.
+        array_view<Auxiliary_Symbol_Record const> Get_Auxiliary_Records(uint32_t index) const;
+
+        // For FILE symbols: the name in their auxiliary records, without the padding.
+        std::string_view Get_File_Name(uint32_t index) const;
+
+        // The NUL-terminated string at offset in the string table; empty when out of range.
+        std::string_view Get_String(uint32_t offset) const;
+
+        // The index of the first symbol with the name, or npos.
+        uint32_t Find(std::string_view name) const;
+};
+
+#endif  // MZ_H__INCLUDED
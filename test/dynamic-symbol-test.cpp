@@ -0,0 +1,62 @@
+#include "test.h"
+
+#include <memory>
+
+#include <elf/elf.h>
+
+#include "elf-builder.h"
+
+using namespace ELF_Format;
+
+//
+//  Parses the built file and looks name up through its dynamic symbol
+//  index; has_gnu_hash is set to whether the index kept DT_GNU_HASH.
+//
+static bool Find_Dynamic_Symbol(ELF_Builder const& builder, std::string_view name, bool& has_gnu_hash)
+{
+    auto const file = builder.Build();
+    auto const elf = std::unique_ptr<ELF>(ELF::Parse(file));
+
+    has_gnu_hash = false;
+
+    if (!elf)
+        return false;
+
+    return Visit(*elf, [&](auto const& elf_file) {
+        auto const* index = elf_file.Get_Dynamic_Symbol_Index();
+
+        if (index == nullptr)
+            return false;
+
+        has_gnu_hash = index->Has_GNU_Hash();
+
+        auto const* symbol = index->Find(name);
+        return (symbol != nullptr) && (index->Get_Name(*symbol) == name);
+    });
+}
+
+TEST(Dynamic_Symbol_Index_Uses_GNU_Hash)
+{
+    ELF_Builder builder;
+    builder.Import("imported").Define("first", 0x100).Define("second", 0x200);
+
+    bool has_gnu_hash;
+
+    CHECK(Find_Dynamic_Symbol(builder, "second", has_gnu_hash));
+    CHECK(has_gnu_hash);
+    CHECK(!Find_Dynamic_Symbol(builder, "missing", has_gnu_hash));
+}
+
+TEST(Dynamic_Symbol_Index_Ignores_GNU_Hash_With_Oversized_Bloom_Shift)
+{
+    // A shift of 32 or more is undefined on the 32-bit hash; lookups fall back to DT_HASH.
+    ELF_Builder builder;
+    builder.Bloom_Shift = 32;
+    builder.Import("imported").Define("first", 0x100).Define("second", 0x200);
+
+    bool has_gnu_hash;
+
+    CHECK(Find_Dynamic_Symbol(builder, "second", has_gnu_hash));
+    CHECK(!has_gnu_hash);
+    CHECK(!Find_Dynamic_Symbol(builder, "missing", has_gnu_hash));
+}
@@ -0,0 +1,268 @@
+#include "elf-builder.h"
+
+#include <algorithm>
+#include <cstring>
+
+using std::string;
+using std::string_view;
+
+template<typename T>
+static void Append(string& out, T value)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+template<typename T>
+static void Put(string& out, size_t offset, T value)
+{
+    std::memcpy(&out[offset], &value, sizeof(T));
+}
+
+static void Align(string& out, size_t alignment)
+{
+    out.resize((out.size() + alignment - 1) / alignment * alignment, '\0');
+}
+
+static uint32_t Add_String(string& strings, string_view text)
+{
+    auto const offset = uint32_t(strings.size());
+
+    strings.append(text).push_back('\0');
+    return offset;
+}
+
+static uint32_t GNU_Hash(string_view name)
+{
+    uint32_t hash = 5381;
+
+    for (auto const c: name)
+        hash = hash * 33 + uint8_t(c);
+
+    return hash;
+}
+
+static uint32_t SysV_Hash(string_view name)
+{
+    uint32_t hash = 0;
+
+    for (auto const c: name)
+    {
+        hash = (hash << 4) + uint8_t(c);
+        hash ^= (hash >> 24) & 0xf0;
+        hash &= 0x0fffffff;
+    }
+
+    return hash;
+}
+
+namespace
+{
+    enum Section: uint32_t
+    {
+        Null_Section, Dynamic_Strings, Dynamic_Symbols, Hash, GNU_Hash_Section, Dynamic, Section_Names, Section_Count
+    };
+
+    struct Section_Layout
+    {
+        uint32_t Name;
+        uint32_t Type;
+        uint64_t Offset;
+        uint64_t Size;
+        uint32_t Link;
+        uint32_t Info;
+        uint64_t Alignment;
+        uint64_t Entry_Size;
+    };
+}
+
+string ELF_Builder::Build() const
+{
+    size_t const header_size = 64;
+    size_t const program_header_size = 56;
+
+    auto symbols = Symbols;
+    std::stable_partition(symbols.begin(), symbols.end(), [](Symbol const& symbol) { return !symbol.Defined; });
+
+    auto const undefined_count = uint32_t(std::count_if(symbols.begin(), symbols.end(), [](Symbol const& s) { return !s.Defined; }));
+    auto const symbol_count = uint32_t(symbols.size() + 1);
+
+    // .dynstr
+    string strings(1, '\0');
+    std::vector<uint32_t> needed_names;
+
+    for (auto const& library: Needed)
+        needed_names.push_back(Add_String(strings, library));
+
+    uint32_t const soname = SONAME.empty() ? 0 : Add_String(strings, SONAME);
+
+    // .dynsym
+    string symbol_table(24, '\0');
+
+    for (auto const& symbol: symbols)
+    {
+        Append<uint32_t>(symbol_table, Add_String(strings, symbol.Name));
+        Append<uint8_t>(symbol_table, uint8_t((symbol.Binding << 4) | symbol.Type));
+        Append<uint8_t>(symbol_table, 0);
+        Append<uint16_t>(symbol_table, symbol.Defined ? uint16_t(Dynamic_Symbols) : uint16_t(0));
+        Append<uint64_t>(symbol_table, symbol.Value);
+        Append<uint64_t>(symbol_table, 8);
+    }
+
+    // .hash, three buckets.
+    uint32_t const bucket_count = 3;
+    std::vector<uint32_t> buckets(bucket_count, 0), chains(symbol_count, 0);
+
+    for (uint32_t i = 1; i < symbol_count; ++i)
+    {
+        auto& bucket = buckets[SysV_Hash(symbols[i - 1].Name) % bucket_count];
+
+        chains[i] = bucket;
+        bucket = i;
+    }
+
+    string hash;
+    Append<uint32_t>(hash, bucket_count);
+    Append<uint32_t>(hash, symbol_count);
+
+    for (auto const bucket: buckets)
+        Append<uint32_t>(hash, bucket);
+
+    for (auto const chain: chains)
+        Append<uint32_t>(hash, chain);
+
+    // .gnu.hash, one bucket and one bloom word.
+    uint32_t const symbol_offset = 1 + undefined_count;
+    uint64_t bloom = 0;
+    string gnu_chains;
+
+    for (uint32_t i = symbol_offset; i < symbol_count; ++i)
+    {
+        auto const h = GNU_Hash(symbols[i - 1].Name);
+
+        bloom |= uint64_t(1) << (h % 64);
+        bloom |= uint64_t(1) << ((uint64_t(h) >> (Bloom_Shift % 64)) % 64);
+
+        Append<uint32_t>(gnu_chains, (h & ~1u) | ((i + 1 == symbol_count) ? 1 : 0));
+    }
+
+    string gnu_hash;
+    Append<uint32_t>(gnu_hash, 1);
+    Append<uint32_t>(gnu_hash, symbol_offset);
+    Append<uint32_t>(gnu_hash, 1);
+    Append<uint32_t>(gnu_hash, Bloom_Shift);
+    Append<uint64_t>(gnu_hash, bloom);
+    Append<uint32_t>(gnu_hash, (symbol_offset < symbol_count) ? symbol_offset : 0);
+    gnu_hash += gnu_chains;
+
+    // .shstrtab
+    string section_names(1, '\0');
+    uint32_t const names[Section_Count] = {
+        0,
+        Add_String(section_names, ".dynstr"),
+        Add_String(section_names, ".dynsym"),
+        Add_String(section_names, ".hash"),
+        Add_String(section_names, ".gnu.hash"),
+        Add_String(section_names, ".dynamic"),
+        Add_String(section_names, ".shstrtab")
+    };
+
+    // The file: headers, then the sections in order.  Addresses equal file offsets.
+    string file(header_size + 2 * program_header_size, '\0');
+    Section_Layout sections[Section_Count] {};
+
+    auto const place = [&](Section index, uint32_t type, string const& contents, uint64_t alignment, uint64_t entry_size)
+    {
+        Align(file, alignment);
+        sections[index] = { names[index], type, file.size(), contents.size(), 0, 0, alignment, entry_size };
+        file += contents;
+    };
+
+    place(Dynamic_Strings, 3, strings, 1, 0);
+    place(Dynamic_Symbols, 11, symbol_table, 8, 24);
+    place(Hash, 5, hash, 8, 4);
+    place(GNU_Hash_Section, 0x6ffffff6, gnu_hash, 8, 0);
+
+    string dynamic;
+
+    auto const entry = [&](int64_t tag, uint64_t value)
+    {
+        Append<int64_t>(dynamic, tag);
+        Append<uint64_t>(dynamic, value);
+    };
+
+    for (auto const name: needed_names)
+        entry(1, name);
+
+    if (soname != 0)
+        entry(14, soname);
+
+    entry(5, sections[Dynamic_Strings].Offset);
+    entry(10, strings.size());
+    entry(6, sections[Dynamic_Symbols].Offset);
+    entry(11, 24);
+    entry(4, sections[Hash].Offset);
+    entry(0x6ffffef5, sections[GNU_Hash_Section].Offset);
+    entry(0, 0);
+
+    place(Dynamic, 6, dynamic, 8, 16);
+    place(Section_Names, 3, section_names, 1, 0);
+
+    sections[Dynamic_Symbols].Link = Dynamic_Strings;
+    sections[Dynamic_Symbols].Info = 1;
+    sections[Hash].Link = Dynamic_Symbols;
+    sections[GNU_Hash_Section].Link = Dynamic_Symbols;
+    sections[Dynamic].Link = Dynamic_Strings;
+
+    Align(file, 8);
+    auto const section_headers = file.size();
+
+    for (auto const& section: sections)
+    {
+        Append<uint32_t>(file, section.Name);
+        Append<uint32_t>(file, section.Type);
+        Append<uint64_t>(file, (section.Type == 0) || (&section == &sections[Section_Names]) ? 0 : 2);    // SHF_ALLOC
+        Append<uint64_t>(file, section.Offset);
+        Append<uint64_t>(file, section.Offset);
+        Append<uint64_t>(file, section.Size);
+        Append<uint32_t>(file, section.Link);
+        Append<uint32_t>(file, section.Info);
+        Append<uint64_t>(file, section.Alignment);
+        Append<uint64_t>(file, section.Entry_Size);
+    }
+
+    // ELF header: ELFCLASS64, ELFDATA2LSB, ELFOSABI_GNU (for STB_GNU_UNIQUE), ET_DYN, EM_X86_64.
+    std::memcpy(&file[0], "\x7f" "ELF\x02\x01\x01\x03", 8);
+    Put<uint16_t>(file, 16, 3);
+    Put<uint16_t>(file, 18, 62);
+    Put<uint32_t>(file, 20, 1);
+    Put<uint64_t>(file, 32, header_size);
+    Put<uint64_t>(file, 40, section_headers);
+    Put<uint16_t>(file, 52, uint16_t(header_size));
+    Put<uint16_t>(file, 54, uint16_t(program_header_size));
+    Put<uint16_t>(file, 56, 2);
+    Put<uint16_t>(file, 58, 64);
+    Put<uint16_t>(file, 60, Section_Count);
+    Put<uint16_t>(file, 62, Section_Names);
+
+    // PT_LOAD over the whole file, then PT_DYNAMIC.
+    auto const program_header = [&](size_t index, uint32_t type, uint64_t offset, uint64_t size, uint64_t alignment)
+    {
+        auto const at = header_size + index * program_header_size;
+
+        Put<uint32_t>(file, at, type);
+        Put<uint32_t>(file, at + 4, 6);
+        Put<uint64_t>(file, at + 8, offset);
+        Put<uint64_t>(file, at + 16, offset);
+        Put<uint64_t>(file, at + 24, offset);
+        Put<uint64_t>(file, at + 32, size);
+        Put<uint64_t>(file, at + 40, size);
+        Put<uint64_t>(file, at + 48, alignment);
+    };
+
+    program_header(0, 1, 0, file.size(), 0x1000);
+    program_header(1, 2, sections[Dynamic].Offset, sections[Dynamic].Size, 8);
+
+    return file;
+}
@@ -0,0 +1,57 @@
+#ifndef ELF_BUILDER_H__INCLUDED
+#define ELF_BUILDER_H__INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+//  Builds a small little-endian ELF64 shared object in memory: one PT_LOAD
+//  that maps the whole file at address 0, PT_DYNAMIC, and the .dynstr,
+//  .dynsym, .hash, .gnu.hash and .dynamic sections with their headers.
+//  Undefined symbols come first in .dynsym, so the GNU hash table (one
+//  bucket) covers exactly the defined ones.  Fields that tests corrupt are
+//  left public.
+//
+class ELF_Builder
+{
+    public:
+        static constexpr uint8_t Global = 1;
+        static constexpr uint8_t Weak = 2;
+        static constexpr uint8_t GNU_Unique = 10;
+
+        static constexpr uint8_t Object = 1;
+        static constexpr uint8_t Function = 2;
+
+        struct Symbol
+        {
+            std::string Name;
+            uint8_t Binding;
+            uint8_t Type;
+            bool Defined;
+            uint64_t Value;
+        };
+
+        std::string SONAME;
+        std::vector<std::string> Needed;
+        std::vector<Symbol> Symbols;
+
+        uint32_t Bloom_Shift = 6;
+
+        ELF_Builder& Define(std::string_view name, uint64_t value, uint8_t binding = Global, uint8_t type = Function)
+        {
+            Symbols.push_back({ std::string(name), binding, type, true, value });
+            return *this;
+        }
+
+        ELF_Builder& Import(std::string_view name)
+        {
+            Symbols.push_back({ std::string(name), Global, Function, false, 0 });
+            return *this;
+        }
+
+        std::string Build() const;
+};
+
+#endif  // ELF_BUILDER_H__INCLUDED
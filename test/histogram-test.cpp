@@ -0,0 +1,36 @@
+#include "test.h"
+
+#include <string>
+
+#include <analysis/histogram.h>
+
+static Byte_Histogram Count_Naively(string_view data)
+{
+    Byte_Histogram histogram {};
+
+    for (auto const c: data)
+        ++histogram[uint8_t(c)];
+
+    return histogram;
+}
+
+TEST(Byte_Histogram_Counts_Runs_And_Mixed_Blocks)
+{
+    // Uniform blocks, blocks that differ only in their last byte, noise and an odd tail.
+    std::string data(4096, '\0');
+    data.append(32, '\x90');
+    data.append(31, 'A').push_back('B');
+
+    for (unsigned i = 0; i < 1000; ++i)
+        data.push_back(char(i * 2654435761u >> 13));
+
+    data.append(7, '\xff');
+
+    for (size_t offset: { size_t(0), size_t(1), size_t(31) })
+    {
+        auto const view = string_view(data).substr(offset);
+        CHECK(Compute_Byte_Histogram(view) == Count_Naively(view));
+    }
+
+    CHECK(Compute_Byte_Histogram(string_view()) == Byte_Histogram {});
+}
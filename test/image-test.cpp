@@ -0,0 +1,103 @@
+#include "test.h"
+
+#include <cstring>
+#include <memory>
+
+#include <mz/image.h>
+#include <mz/mz.h>
+
+#include "pe-builder.h"
+
+static uint32_t const Relocation_RVA = 0x1000;
+static uint32_t const Data_RVA = 0x40000;
+static uint64_t const Data_Value = 0x1122334455667788;
+
+static void Append_Block(std::string& table, uint32_t page_RVA, std::initializer_list<uint16_t> entries)
+{
+    uint32_t const header[] = { page_RVA, uint32_t(8 + 2 * entries.size()) };
+
+    table.append(reinterpret_cast<char const*>(header), sizeof(header));
+
+    for (auto const entry: entries)
+        table.append(reinterpret_cast<char const*>(&entry), sizeof(entry));
+}
+
+//
+//  An image with the relocation table at Relocation_RVA, of which the
+//  directory covers table_size bytes, and an 8-byte word at Data_RVA.
+//  Loads it 64 KiB above its preferred base.
+//
+static std::unique_ptr<MZ_Image> Load_Relocated(std::string const& relocations, uint32_t table_size)
+{
+    std::string data(8, '\0');
+    std::memcpy(&data[0], &Data_Value, sizeof(Data_Value));
+
+    PE_Builder builder;
+    builder.Add_Section(".reloc", Relocation_RVA, relocations, PE_Builder::Initialized_Data);
+    builder.Add_Section(".data", Data_RVA, data, PE_Builder::Initialized_Data);
+    builder.Directories[PE_Builder::Base_Relocation_Table] = { Relocation_RVA, table_size };
+
+    auto const file = builder.Build();
+    auto const mz = std::unique_ptr<MZ>(MZ::Parse(file));
+
+    if (!mz)
+        return nullptr;
+
+    return std::unique_ptr<MZ_Image>(MZ_Image::Load(*mz, builder.Image_Base + 0x10000));
+}
+
+static uint64_t Get_Data_Word(MZ_Image const& image)
+{
+    uint64_t value;
+    std::memcpy(&value, image.contents().data() + Data_RVA, sizeof(value));
+
+    return value;
+}
+
+TEST(Image_Relocation_Applies_Blocks)
+{
+    std::string table;
+    Append_Block(table, Data_RVA, { 0xa000, 0 });
+
+    auto const image = Load_Relocated(table, uint32_t(table.size()));
+
+    CHECK(image != nullptr);
+    CHECK(image && (image->Get_Relocation_Count() == 1));
+    CHECK(image && (Get_Data_Word(*image) == Data_Value + 0x10000));
+}
+
+TEST(Image_Relocation_Takes_Blocks_Larger_Than_64_KiB)
+{
+    // One block of 0x20000 bytes: Absolute padding, then a Dir64 fixup as its last entry.
+    std::string table(0x20000, '\0');
+    uint32_t const header[] = { Data_RVA, 0x20000 };
+    uint16_t const fixup = 0xa000;
+
+    std::memcpy(&table[0], header, sizeof(header));
+    std::memcpy(&table[table.size() - 2], &fixup, sizeof(fixup));
+
+    auto const image = Load_Relocated(table, uint32_t(table.size()));
+
+    CHECK(image != nullptr);
+    CHECK(image && (image->Get_Relocation_Count() == 1));
+    CHECK(image && (Get_Data_Word(*image) == Data_Value + 0x10000));
+}
+
+TEST(Image_Relocation_Stops_At_The_End_Of_The_Table)
+{
+    //
+    //  A 10-byte block, rounded up to 12, ends the 10-byte table; the block
+    //  past it is data that follows the table in its section and must not
+    //  be applied.
+    //
+    std::string table;
+    Append_Block(table, Data_RVA, { 0 });
+    table.append(2, '\0');
+    Append_Block(table, Data_RVA, { 0xa000, 0 });
+
+    auto const image = Load_Relocated(table, 10);
+
+    CHECK(image != nullptr);
+    CHECK(image && (image->Get_Relocation_Count() == 0));
+    CHECK(image && (Get_Data_Word(*image) == Data_Value));
+}
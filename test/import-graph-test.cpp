@@ -0,0 +1,47 @@
+#include "test.h"
+
+#include <sstream>
+
+#include <main/import-graph.h>
+
+#include "elf-builder.h"
+
+static std::string Run_JSON_Import_Graph(std::string const& directory)
+{
+    Command_Line_Arguments arguments {
+        {{"--verbose", "-v"}, {"--import-graph", "-G"}},
+        {{"--format", "-f"}, {"--jobs", "-j"}, {"--manifest", "-m"}}
+    };
+
+    char const* argv[] = { "bintool", "--import-graph", "--format", "json", directory.c_str() };
+    arguments.Parse(argv);
+
+    std::ostringstream out;
+    Run_Import_Graph(arguments, out);
+
+    return std::move(out).str();
+}
+
+TEST(Import_Graph_Resolves_GNU_Unique_Definitions)
+{
+    Temporary_Directory directory;
+
+    ELF_Builder library;
+    library.SONAME = "libunique.so";
+    library.Define("_ZNSt7__cxx117collateIcE2idE", 0x100, ELF_Builder::GNU_Unique, ELF_Builder::Object);
+    library.Define("unique_function", 0x200);
+
+    ELF_Builder user;
+    user.SONAME = "libuser.so";
+    user.Needed = { "libunique.so" };
+    user.Import("_ZNSt7__cxx117collateIcE2idE").Import("unique_function");
+
+    directory.Write_File("libunique.so", library.Build());
+    directory.Write_File("libuser.so", user.Build());
+
+    auto const report = Run_JSON_Import_Graph(directory.Path());
+
+    CHECK(report.find("\"modules\":2") != std::string::npos);
+    CHECK(report.find("\"unresolved_dependencies\":0") != std::string::npos);
+    CHECK(report.find("\"unresolved_imports\":0") != std::string::npos);
+}
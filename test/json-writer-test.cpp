@@ -0,0 +1,35 @@
+#include "test.h"
+
+#include <main/json-writer.h>
+
+static std::string Quote(std::string_view text)
+{
+    JSON_Writer json;
+    json.String(text);
+
+    return std::string(json.view());
+}
+
+TEST(JSON_Writer_Keeps_UTF8_Paths)
+{
+    JSON_Writer json;
+    json.Begin_Object().Field("path", "/tmp/caf\xc3\xa9/\xe6\x97\xa5\xe6\x9c\xac.bin").End_Object();
+
+    CHECK(json.view() == "{\"path\":\"/tmp/caf\xc3\xa9/\xe6\x97\xa5\xe6\x9c\xac.bin\"}");
+    CHECK(Quote("\xf0\x9f\x93\x81") == "\"\xf0\x9f\x93\x81\"");
+}
+
+TEST(JSON_Writer_Escapes_Control_Characters)
+{
+    CHECK(Quote("a\"b\\c\n\t") == "\"a\\\"b\\\\c\\n\\t\"");
+    CHECK(Quote(std::string_view("\x01\x7f", 2)) == "\"\\u0001\\u007f\"");
+}
+
+TEST(JSON_Writer_Replaces_Invalid_UTF8)
+{
+    // Latin-1, a truncated sequence, an overlong form and a surrogate.
+    CHECK(Quote("caf\xe9.bin") == "\"caf\\ufffd.bin\"");
+    CHECK(Quote("\xe6\x97") == "\"\\ufffd\\ufffd\"");
+    CHECK(Quote("\xc0\xaf") == "\"\\ufffd\\ufffd\"");
+    CHECK(Quote("\xed\xa0\x80") == "\"\\ufffd\\ufffd\\ufffd\"");
+}
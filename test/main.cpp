@@ -0,0 +1,67 @@
+#include "test.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+static int Failure_Count = 0;
+
+std::vector<Test_Case>& Get_Test_Cases()
+{
+    static std::vector<Test_Case> test_cases;
+    return test_cases;
+}
+
+void Report_Failure(char const* condition, char const* file, int line)
+{
+    std::cerr << file << ':' << line << ": CHECK(" << condition << ") failed\n";
+    ++Failure_Count;
+}
+
+Temporary_Directory::Temporary_Directory()
+{
+    char const* root = std::getenv("TMPDIR");
+    std::string pattern = std::string((root != nullptr) ? root : "/tmp") + "/bintool-test.XXXXXX";
+
+    if (::mkdtemp(pattern.data()) != nullptr)
+        _path = pattern;
+}
+
+Temporary_Directory::~Temporary_Directory()
+{
+    std::error_code error;
+
+    if (!_path.empty())
+        std::filesystem::remove_all(_path, error);
+}
+
+std::string Temporary_Directory::Write_File(std::string_view name, std::string_view contents) const
+{
+    auto const path = _path + '/' + std::string(name);
+    std::ofstream(path, std::ios::binary).write(contents.data(), contents.size());
+
+    return path;
+}
+
+// With arguments, runs only the tests named by them.
+int main(int argc, char* argv[])
+{
+    size_t run_count = 0;
+
+    for (auto const& test_case: Get_Test_Cases())
+    {
+        if ((argc > 1) && (std::find(argv + 1, argv + argc, test_case.Name) == argv + argc))
+            continue;
+
+        int const failures_before = Failure_Count;
+        test_case.Run();
+        ++run_count;
+
+        std::cout << ((Failure_Count == failures_before) ? "pass " : "FAIL ") << test_case.Name << '\n';
+    }
+
+    std::cout << run_count << " tests, " << Failure_Count << " failed checks\n";
+    return (Failure_Count == 0) ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include "pe-builder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include <mz/mz.h>
+
+using std::string;
+
+static uint32_t const File_Alignment = 0x200;
+static uint32_t const Section_Alignment = 0x1000;
+
+// The DOS header is only the "MZ" signature and, at 0x3c, the offset of the PE signature.
+static uint32_t const PE_Signature_Offset = 0x40;
+
+template<typename T>
+static void Put(string& out, size_t offset, T const& value)
+{
+    std::memcpy(&out[offset], &value, sizeof(T));
+}
+
+static uint32_t Align_Up(uint64_t value, uint32_t alignment)
+{
+    return uint32_t((value + alignment - 1) / alignment * alignment);
+}
+
+string PE_Builder::Build() const
+{
+    size_t const coff_header_offset = Object ? 0 : PE_Signature_Offset;
+    size_t const optional_header_size = Object ? 0 : sizeof(MZ::Optional_Header_Plus);
+
+    // The COFF header of an object has no PE signature in front of it.
+    size_t const section_table =
+        coff_header_offset + sizeof(MZ::COFF_Header) - (Object ? sizeof(uint32_t) : 0) + optional_header_size;
+
+    auto const alignment = Object ? 4 : File_Alignment;
+    auto const size_of_headers = Align_Up(section_table + Sections.size() * sizeof(MZ::Section_Header), alignment);
+
+    string file(size_of_headers, '\0');
+    uint32_t size_of_image = Align_Up(size_of_headers, Section_Alignment);
+
+    for (size_t i = 0; i < Sections.size(); ++i)
+    {
+        auto const& section = Sections[i];
+
+        MZ::Section_Header header {};
+        std::memcpy(header.Name, section.Name.data(), std::min<size_t>(section.Name.size(), sizeof(header.Name)));
+        header.Virtual_Address = section.Virtual_Address;
+        header.Characteristics = MZ::Section_Characteristics(section.Characteristics);
+
+        if (!section.Data.empty())
+        {
+            header.Virtual_Size = uint32_t(section.Data.size());
+            header.Size_Of_Raw_Data = Align_Up(section.Data.size(), alignment);
+            header.Pointer_To_Raw_Data = uint32_t(file.size());
+
+            file += section.Data;
+            file.resize(header.Pointer_To_Raw_Data + header.Size_Of_Raw_Data, '\0');
+        } else {
+            header.Virtual_Size = section.Uninitialized_Size;
+            header.Size_Of_Raw_Data = Object ? section.Uninitialized_Size : 0;
+        }
+
+        if (Object)
+            header.Virtual_Size = 0;
+
+        size_of_image = std::max(size_of_image, Align_Up(uint64_t(section.Virtual_Address) + header.Virtual_Size, Section_Alignment));
+        Put(file, section_table + i * sizeof(header), header);
+    }
+
+    MZ::COFF_Header coff {};
+    coff.Signature = 0x4550;
+    coff.Machine = MZ::Machine_Type::AMD64;
+    coff.Number_Of_Sections = uint16_t(Sections.size());
+    coff.Size_Of_Optional_Header = uint16_t(optional_header_size);
+
+    if (Object)
+    {
+        std::memcpy(&file[0], &coff.Machine, sizeof(coff) - offsetof(MZ::COFF_Header, Machine));
+        return file;
+    }
+
+    // EXECUTABLE_IMAGE | LARGE_ADDRESS_AWARE
+    coff.Characteristics = MZ::Image_File_Characteristics(0x0022);
+
+    MZ::Optional_Header_Plus optional {};
+    optional.Magic = MZ::Magic_Number::PE32_PLUS;
+    optional.Image_Base = Image_Base;
+    optional.Section_Alignment = Section_Alignment;
+    optional.File_Alignment = File_Alignment;
+    optional.Major_Subsystem_Version = 6;
+    optional.Size_Of_Image = size_of_image;
+    optional.Size_Of_Headers = size_of_headers;
+    optional.Subsystem = MZ::Image_Subsystem(3);
+    optional.Number_Of_Rva_And_Sizes = 16;
+
+    static_assert(sizeof(Directories) == sizeof(optional.Image_Data_Directories));
+    std::memcpy(&optional.Image_Data_Directories, Directories, sizeof(Directories));
+
+    Put<uint16_t>(file, 0, 0x5a4d);
+    Put<uint32_t>(file, 0x3c, PE_Signature_Offset);
+    Put(file, coff_header_offset, coff);
+    Put(file, coff_header_offset + sizeof(coff), optional);
+
+    return file;
+}
@@ -0,0 +1,55 @@
+#ifndef PE_BUILDER_H__INCLUDED
+#define PE_BUILDER_H__INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+//  Builds a small x64 PE32+ image, or with Object set a bare COFF object,
+//  in memory.  Sections are laid out in the file in the order they were
+//  added, each at a multiple of the file alignment; a section with no data
+//  but an Uninitialized_Size gets that as its Size_Of_Raw_Data and a zero
+//  Pointer_To_Raw_Data, the way compilers write .bss in objects.  The image
+//  size and header fields not listed here are derived or left zero.
+//
+class PE_Builder
+{
+    public:
+        static constexpr uint32_t Code = 0x60000020;
+        static constexpr uint32_t Initialized_Data = 0xc0000040;
+        static constexpr uint32_t Uninitialized_Data = 0xc0000080;
+
+        struct Section
+        {
+            std::string Name;
+            uint32_t Virtual_Address;
+            std::string Data;
+            uint32_t Characteristics;
+            uint32_t Uninitialized_Size;
+        };
+
+        struct Directory
+        {
+            uint32_t Virtual_Address;
+            uint32_t Size;
+        };
+
+        enum Directory_Index { Export_Table = 0, Import_Table = 1, Resource_Table = 2, Base_Relocation_Table = 5 };
+
+        bool Object = false;
+        uint64_t Image_Base = 0x140000000;
+        Directory Directories[16] {};
+        std::vector<Section> Sections;
+
+        PE_Builder& Add_Section(std::string_view name, uint32_t virtual_address, std::string data, uint32_t characteristics)
+        {
+            Sections.push_back({ std::string(name), virtual_address, std::move(data), characteristics, 0 });
+            return *this;
+        }
+
+        std::string Build() const;
+};
+
+#endif  // PE_BUILDER_H__INCLUDED
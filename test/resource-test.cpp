@@ -0,0 +1,79 @@
+#include "test.h"
+
+#include <cstring>
+#include <memory>
+
+#include <mz/mz.h>
+#include <main/json-writer.h>
+#include <main/resource-dumper.h>
+
+#include "pe-builder.h"
+
+static uint32_t const Resource_RVA = 0x1000;
+static uint32_t const Subdirectory = 0x80000000;
+
+template<typename T>
+static void Append(std::string& out, T const& value)
+{
+    out.append(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+static void Append_Directory(std::string& out, std::initializer_list<MZ::Resource_Directory_Entry> entries)
+{
+    MZ::Resource_Directory_Table table {};
+    table.Number_Of_ID_Entries = uint16_t(entries.size());
+
+    Append(out, table);
+
+    for (auto const& entry: entries)
+        Append(out, entry);
+}
+
+static size_t Count_Resources(std::string const& resources)
+{
+    PE_Builder builder;
+    builder.Add_Section(".rsrc", Resource_RVA, resources, PE_Builder::Initialized_Data);
+    builder.Directories[PE_Builder::Resource_Table] = { Resource_RVA, uint32_t(resources.size()) };
+
+    auto const file = builder.Build();
+    auto const mz = std::unique_ptr<MZ>(MZ::Parse(file));
+
+    if (!mz)
+        return 0;
+
+    JSON_Writer json;
+    json.Begin_Object();
+    Write_Resources_JSON(*mz, json);
+    json.End_Object();
+
+    size_t count = 0;
+
+    for (auto at = json.view().find("\"rva\""); at != std::string_view::npos; at = json.view().find("\"rva\"", at + 1))
+        ++count;
+
+    return count;
+}
+
+TEST(Resource_Walk_Visits_Each_Directory_Once)
+{
+    //
+    //  The root (at 0) has four entries pointing back at itself and one
+    //  leading to A (at 56).  Both entries of A lead to B (at 88), whose one
+    //  entry is the data entry at 112, for the 4 bytes at 128.
+    //
+    std::string resources;
+
+    Append_Directory(resources, {
+        { 1, Subdirectory | 0 }, { 2, Subdirectory | 0 }, { 3, Subdirectory | 0 }, { 4, Subdirectory | 0 },
+        { 5, Subdirectory | 56 }
+    });
+    Append_Directory(resources, { { 1, Subdirectory | 88 }, { 2, Subdirectory | 88 } });
+    Append_Directory(resources, { { 0x409, 112 } });
+
+    CHECK(resources.size() == 112);
+
+    Append(resources, MZ::Resource_Data_Entry { Resource_RVA + 128, 4, 0, 0 });
+    resources += "data";
+
+    CHECK(Count_Resources(resources) == 1);
+}
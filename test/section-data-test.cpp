@@ -0,0 +1,57 @@
+#include "test.h"
+
+#include <memory>
+
+#include <mz/mz.h>
+#include <main/digest-dumper.h>
+#include <main/strings-dumper.h>
+
+#include "pe-builder.h"
+
+//
+//  A COFF object with .text and a 16-byte .bss, which objects describe
+//  with Size_Of_Raw_Data and a zero Pointer_To_Raw_Data.
+//
+static std::string Build_Object_With_BSS()
+{
+    PE_Builder builder;
+    builder.Object = true;
+    builder.Add_Section(".text", 0, "text section contents", PE_Builder::Code);
+    builder.Add_Section(".bss", 0, {}, PE_Builder::Uninitialized_Data);
+    builder.Sections.back().Uninitialized_Size = 16;
+
+    return builder.Build();
+}
+
+TEST(COFF_BSS_Has_No_File_Data)
+{
+    auto const file = Build_Object_With_BSS();
+    auto const mz = std::unique_ptr<MZ>(MZ::Parse(file));
+
+    CHECK(mz != nullptr);
+
+    if (!mz)
+        return;
+
+    CHECK(mz->Get_Number_of_Sections() == 2);
+    CHECK(MZ::Has_File_Data(mz->Get_Section_Header(0)));
+    CHECK(!MZ::Has_File_Data(mz->Get_Section_Header(1)));
+
+    size_t sections = 0;
+
+    for (auto const& region: Get_Hashed_Regions(*mz))
+    {
+        if (region.Kind != "section")
+            continue;
+
+        ++sections;
+        CHECK(region.Name == ".text");
+    }
+
+    CHECK(sections == 1);
+
+    auto const strings = Get_String_Regions(*mz);
+
+    CHECK(strings.size() == 1);
+    CHECK(!strings.empty() && (strings[0].Name == ".text"));
+}
@@ -0,0 +1,55 @@
+#ifndef TEST_H__INCLUDED
+#define TEST_H__INCLUDED
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+//  A minimal self-registering test runner.  Each TEST body is a function
+//  added to the list before main() runs; CHECK reports a failed condition
+//  with its file and line and lets the test carry on, so one run shows
+//  every failure.
+//
+struct Test_Case
+{
+    std::string_view Name;
+    void (*Run)();
+};
+
+std::vector<Test_Case>& Get_Test_Cases();
+void Report_Failure(char const* condition, char const* file, int line);
+
+struct Test_Registration
+{
+    Test_Registration(std::string_view name, void (*run)()) { Get_Test_Cases().push_back({ name, run }); }
+};
+
+// A fresh directory under $TMPDIR (or /tmp), removed with everything in it.
+class Temporary_Directory
+{
+    private:
+        std::string _path;
+
+    public:
+        Temporary_Directory();
+        ~Temporary_Directory();
+
+        Temporary_Directory(Temporary_Directory const&) = delete;
+        Temporary_Directory& operator=(Temporary_Directory const&) = delete;
+
+        std::string const& Path() const { return _path; }
+
+        // Writes the contents to the named file in the directory and returns its path.
+        std::string Write_File(std::string_view name, std::string_view contents) const;
+};
+
+#define TEST(name) \
+    static void Test_##name(); \
+    static Test_Registration const Registration_##name { #name, Test_##name }; \
+    static void Test_##name()
+
+#define CHECK(condition) \
+    do { if (!(condition)) Report_Failure(#condition, __FILE__, __LINE__); } while (false)
+
+#endif  // TEST_H__INCLUDED